@@ -69,6 +69,7 @@
 #include "../../Source/Core/Network/Requests/ProjectDeleteThread.cpp"
 #include "../../Source/Core/Network/Requests/RevisionsSyncHelpers.cpp"
 #include "../../Source/Core/Network/Requests/RevisionsSyncThread.cpp"
+#include "../../Source/Core/Network/Requests/RevisionsSyncTransport.cpp"
 #include "../../Source/Core/Network/Services/ProjectSyncService.cpp"
 #include "../../Source/Core/Network/Services/ResourceSyncService.cpp"
 #include "../../Source/Core/Network/Services/SessionService.cpp"
@@ -77,6 +78,8 @@
 #include "../../Source/Core/Serialization/Document.cpp"
 #include "../../Source/Core/Serialization/DocumentHelpers.cpp"
 #include "../../Source/Core/Serialization/SerializedData.cpp"
+#include "../../Source/Core/Serialization/SerializedDataWriter.cpp"
+#include "../../Source/Core/Serialization/SerializedDataReader.cpp"
 #include "../../Source/Core/Serialization/BinarySerializer.cpp"
 #include "../../Source/Core/Serialization/JsonSerializer.cpp"
 #include "../../Source/Core/Serialization/XmlSerializer.cpp"
@@ -106,8 +109,11 @@
 #include "../../Source/Core/Undo/Actions/ProjectMetadataActions.cpp"
 #include "../../Source/Core/Undo/Actions/TimeSignatureEventActions.cpp"
 #include "../../Source/Core/Undo/UndoStack.cpp"
+#include "../../Source/Core/Undo/UndoJournal.cpp"
+#include "../../Source/Core/Undo/UndoActionPool.cpp"
 #include "../../Source/Core/VCS/DiffLogic/AutomationTrackDiffLogic.cpp"
 #include "../../Source/Core/VCS/DiffLogic/DiffLogic.cpp"
+#include "../../Source/Core/VCS/DiffLogic/PackedDeltaHelpers.cpp"
 #include "../../Source/Core/VCS/DiffLogic/PatternDiffHelpers.cpp"
 #include "../../Source/Core/VCS/DiffLogic/PianoTrackDiffLogic.cpp"
 #include "../../Source/Core/VCS/DiffLogic/ProjectInfoDiffLogic.cpp"
@@ -115,6 +121,7 @@
 #include "../../Source/Core/VCS/Delta.cpp"
 #include "../../Source/Core/VCS/Diff.cpp"
 #include "../../Source/Core/VCS/Head.cpp"
+#include "../../Source/Core/VCS/HistoryCompaction.cpp"
 #include "../../Source/Core/VCS/RemoteCache.cpp"
 #include "../../Source/Core/VCS/Revision.cpp"
 #include "../../Source/Core/VCS/RevisionItem.cpp"
@@ -150,6 +157,8 @@
 #include "../../Source/UI/Common/ScaleEditor.cpp"
 #include "../../Source/UI/Common/SpectralLogo.cpp"
 #include "../../Source/UI/Common/TransportControlComponent.cpp"
+#include "../../Source/UI/Common/UiProfiler.cpp"
+#include "../../Source/UI/Common/UiProfilerOverlay.cpp"
 #include "../../Source/UI/Common/ViewportFitProxyComponent.cpp"
 #include "../../Source/UI/Dialogs/DialogBase.cpp"
 #include "../../Source/UI/Dialogs/AnnotationDialog.cpp"
@@ -237,8 +246,11 @@
 #include "../../Source/UI/Sequencer/Header/HeaderSelectionIndicator.cpp"
 #include "../../Source/UI/Sequencer/Header/HybridRollHeader.cpp"
 #include "../../Source/UI/Sequencer/Header/Playhead.cpp"
+#include "../../Source/UI/Sequencer/Helpers/AnimationClock.cpp"
 #include "../../Source/UI/Sequencer/Helpers/CutPointMark.cpp"
 #include "../../Source/UI/Sequencer/Helpers/HybridRollExpandMark.cpp"
+#include "../../Source/UI/Sequencer/Helpers/HybridRollCulling.cpp"
+#include "../../Source/UI/Sequencer/Helpers/ProjectMapImageCache.cpp"
 #include "../../Source/UI/Sequencer/Helpers/KnifeToolHelper.cpp"
 #include "../../Source/UI/Sequencer/Helpers/TimelineWarningMarker.cpp"
 #include "../../Source/UI/Sequencer/Helpers/PatternOperations.cpp"
@@ -251,10 +263,12 @@
 #include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/AutomationStepsClip/AutomationStepEventComponent.cpp"
 #include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/AutomationStepsClip/AutomationStepEventsConnector.cpp"
 #include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/PianoClip/PianoClipComponent.cpp"
+#include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/PianoClip/PianoSequenceThumbnail.cpp"
 #include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/ClipComponent.cpp"
 #include "../../Source/UI/Sequencer/PatternRoll/ClipComponents/DummyClipComponent.cpp"
 #include "../../Source/UI/Sequencer/PatternRoll/PatternRoll.cpp"
 #include "../../Source/UI/Sequencer/PianoRoll/HighlightingScheme.cpp"
+#include "../../Source/UI/Sequencer/PianoRoll/InactiveNotesLayer.cpp"
 #include "../../Source/UI/Sequencer/PianoRoll/NoteComponent.cpp"
 #include "../../Source/UI/Sequencer/PianoRoll/NoteNameGuide.cpp"
 #include "../../Source/UI/Sequencer/PianoRoll/NoteNameGuidesBar.cpp"
@@ -147,6 +147,10 @@ namespace juce
     {
         // declare an additional category for all our tests 
         static const String helio { "Helio" };
+
+        // benchmarks are slow and only log the timings,
+        // so they are only run when asked with --benchmark
+        static const String helioPerformance { "Helio Performance" };
     }
 }
 #endif
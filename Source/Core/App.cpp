@@ -511,15 +511,24 @@ void App::initialise(const String &commandLine)
         // (we don't need a window, workspace and network services though)
         UnitTestRunner runner;
 
-        // we don't want to run JUCE's unit tests, just the ones in our category:
-        runner.runTestsInCategory(UnitTestCategories::helio,
-            Random::getSystemRandom().nextInt64());
+        // we don't want to run JUCE's unit tests, just the ones in our categories:
+        StringArray testCategories(UnitTestCategories::helio);
+        if (commandLine.contains("--benchmark"))
+        {
+            testCategories.add(UnitTestCategories::helioPerformance);
+        }
 
-        for (int i = 0; i < runner.getNumResults(); ++i)
+        for (const auto &category : testCategories)
         {
-            if (runner.getResult(i)->failures > 0)
+            runner.runTestsInCategory(category,
+                Random::getSystemRandom().nextInt64());
+
+            for (int i = 0; i < runner.getNumResults(); ++i)
             {
-                throw new std::exception();
+                if (runner.getResult(i)->failures > 0)
+                {
+                    throw new std::exception();
+                }
             }
         }
 
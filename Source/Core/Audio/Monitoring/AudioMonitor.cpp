@@ -59,63 +59,151 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OversaturationWarningAsyncCallback)
 };
 
-AudioMonitor::AudioMonitor() : fft()
+AudioMonitor::AudioMonitor() : Thread("AudioMonitor"), fft()
 {
     this->asyncClippingWarning = make<ClippingWarningAsyncCallback>(*this);
     this->asyncOversaturationWarning = make<OversaturationWarningAsyncCallback>(*this);
 }
 
+AudioMonitor::~AudioMonitor()
+{
+    this->stopThread(1000);
+}
+
 //===----------------------------------------------------------------------===//
 // AudioIODeviceCallback
 //===----------------------------------------------------------------------===//
 
 void AudioMonitor::audioDeviceAboutToStart(AudioIODevice *device)
 {
+    this->stopThread(1000);
+
     this->sampleRate = device->getCurrentSampleRate();
+    this->fifo.reset();
+    this->spectrumHistory.clear();
+    this->spectrumHistoryPosition = 0;
+
+    this->startThread(3);
+}
+
+void AudioMonitor::audioDeviceStopped()
+{
+    this->stopThread(1000);
 }
 
 void AudioMonitor::audioDeviceIOCallback(const float **inputChannelData, int numInputChannels,
     float **outputChannelData, int numOutputChannels, int numSamples)
 {
-    const int minNumChannels = jmin(AudioMonitor::numChannels, numOutputChannels);
-    
-    for (int channel = 0; channel < minNumChannels; ++channel)
+    // if the analysis thread falls behind, the samples that don't fit are dropped:
+    int start1, size1, start2, size2;
+    this->fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    for (int channel = 0; channel < AudioMonitor::numChannels; ++channel)
     {
-        this->fft.computeSpectrum(outputChannelData[channel], 0, numSamples,
-            this->spectrum[channel], AudioMonitor::spectrumSize,
-            channel, numOutputChannels);
+        if (channel < numOutputChannels)
+        {
+            this->fifoBuffer.copyFrom(channel, start1, outputChannelData[channel], size1);
+            this->fifoBuffer.copyFrom(channel, start2, outputChannelData[channel] + size1, size2);
+        }
+        else
+        {
+            this->fifoBuffer.clear(channel, start1, size1);
+            this->fifoBuffer.clear(channel, start2, size2);
+        }
     }
-    
-    for (int channel = 0; channel < minNumChannels; ++channel)
+
+    this->fifo.finishedWrite(size1 + size2);
+
+    for (int i = 0; i < numOutputChannels; ++i)
+    {
+        FloatVectorOperations::clear(outputChannelData[i], numSamples);
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// Thread
+//===----------------------------------------------------------------------===//
+
+void AudioMonitor::run()
+{
+    while (!this->threadShouldExit())
     {
+        this->wait(AudioMonitor::analysisIntervalMs);
+
+        const int numReady = this->fifo.getNumReady();
+        if (numReady == 0)
+        {
+            continue;
+        }
+
+        int start1, size1, start2, size2;
+        this->fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+        for (int channel = 0; channel < AudioMonitor::numChannels; ++channel)
+        {
+            this->analysisBuffer.copyFrom(channel, 0, this->fifoBuffer, channel, start1, size1);
+            this->analysisBuffer.copyFrom(channel, size1, this->fifoBuffer, channel, start2, size2);
+        }
+
+        this->fifo.finishedRead(size1 + size2);
+
+        this->analyze(size1 + size2);
+    }
+}
+
+void AudioMonitor::analyze(int numSamples)
+{
+    // only the latest samples matter for the spectrum:
+    const int numHistorySamples = jmin(numSamples, AudioMonitor::spectrumSize);
+
+    for (int channel = 0; channel < AudioMonitor::numChannels; ++channel)
+    {
+        const auto *pcmData = this->analysisBuffer.getReadPointer(channel);
+
+        const auto range = FloatVectorOperations::findMinAndMax(pcmData, numSamples);
+        const float pcmPeak = jmax(-range.getStart(), range.getEnd());
+
         float pcmSquaresSum = 0.f;
-        float pcmPeak = 0.f;
         for (int samplePosition = 0; samplePosition < numSamples; ++samplePosition)
         {
-            const float &pcmData = outputChannelData[channel][samplePosition];
-            pcmSquaresSum += (pcmData * pcmData);
-            pcmPeak = jmax(pcmPeak, pcmData);
+            pcmSquaresSum += (pcmData[samplePosition] * pcmData[samplePosition]);
         }
-        
+
         const float rootMeanSquare = sqrtf(pcmSquaresSum / numSamples);
         this->rms[channel] = rootMeanSquare;
         this->peak[channel] = pcmPeak;
-        
+
         if (pcmPeak > AudioMonitor::clipThreshold)
         {
             this->asyncClippingWarning->triggerAsyncUpdate();
         }
-        
+
         if (pcmPeak > AudioMonitor::oversaturationThreshold &&
             (pcmPeak / rootMeanSquare) > AudioMonitor::oversaturationRate)
         {
             this->asyncOversaturationWarning->triggerAsyncUpdate();
         }
+
+        auto *history = this->spectrumHistory.getWritePointer(channel);
+        const auto *newSamples = pcmData + (numSamples - numHistorySamples);
+        int historyPosition = this->spectrumHistoryPosition;
+        for (int i = 0; i < numHistorySamples; ++i)
+        {
+            history[historyPosition] = newSamples[i];
+            historyPosition = (historyPosition + 1) % AudioMonitor::spectrumSize;
+        }
     }
 
-    for (int i = 0; i < numOutputChannels; ++i)
+    this->spectrumHistoryPosition =
+        (this->spectrumHistoryPosition + numHistorySamples) % AudioMonitor::spectrumSize;
+
+    // the history is cyclic, so the oldest sample is at the current position:
+    for (int channel = 0; channel < AudioMonitor::numChannels; ++channel)
     {
-        FloatVectorOperations::clear(outputChannelData[i], numSamples);
+        this->fft.computeSpectrum(this->spectrumHistory.getWritePointer(channel),
+            this->spectrumHistoryPosition, AudioMonitor::spectrumSize,
+            this->spectrum[channel], AudioMonitor::spectrumSize,
+            channel, AudioMonitor::numChannels);
     }
 }
 
@@ -129,13 +217,13 @@ float AudioMonitor::getInterpolatedSpectrumAtFrequency(float frequency) const
         float(this->sampleRate.get() / 2.f) / float(AudioMonitor::spectrumSize);
     
     const int index1 = roundToInt(frequency / resolution);
-    const int safeIndex1 = jlimit(0, AudioMonitor::spectrumSize, index1);
+    const int safeIndex1 = jlimit(0, AudioMonitor::spectrumSize - 1, index1);
     const float f1 = index1 * resolution;
     const float y1 = (this->spectrum[0][safeIndex1].get() +
                       this->spectrum[1][safeIndex1].get()) / 2.f;
     
     const int index2 = index1 + 1;
-    const int safeIndex2 = jlimit(0, AudioMonitor::spectrumSize, index2);
+    const int safeIndex2 = jlimit(0, AudioMonitor::spectrumSize - 1, index2);
     const float f2 = index2 * resolution;
     const float y2 = (this->spectrum[0][safeIndex2].get() +
                       this->spectrum[1][safeIndex2].get()) / 2.f;
@@ -19,11 +19,16 @@
 
 #include "SpectrumAnalyzer.h"
 
-class AudioMonitor final : public AudioIODeviceCallback
+// Listens to the audio output and provides the spectrum and volume data
+// for the UI monitors; the audio callback only pushes the samples into
+// a lock-free fifo, and all the analysis is done by the monitor's own thread,
+// so that it doesn't take any headroom from the audio thread:
+class AudioMonitor final : public AudioIODeviceCallback, private Thread
 {
 public:
     
     AudioMonitor();
+    ~AudioMonitor() override;
 
     //===------------------------------------------------------------------===//
     // AudioIODeviceCallback
@@ -32,7 +37,7 @@ public:
     void audioDeviceAboutToStart(AudioIODevice *device) override;
     void audioDeviceIOCallback(const float **inputChannelData, int numInputChannels,
         float **outputChannelData, int numOutputChannels, int numSamples) override;
-    void audioDeviceStopped() override {}
+    void audioDeviceStopped() override;
     
     //===------------------------------------------------------------------===//
     // Clipping warnings
@@ -66,6 +71,13 @@ public:
     
 private:
 
+    //===------------------------------------------------------------------===//
+    // Thread
+    //===------------------------------------------------------------------===//
+
+    void run() override;
+    void analyze(int numSamples);
+
     SpectrumFFT fft;
 
     // 256*2 == we just need quite a small resolution on a spectrum
@@ -79,6 +91,20 @@ private:
     static constexpr auto oversaturationThreshold = 0.5f;
     static constexpr auto oversaturationRate = 4.f;
 
+    // enough for a few large audio blocks between the analysis passes:
+    static constexpr auto fifoSize = 8192;
+    static constexpr auto analysisIntervalMs = 10;
+
+    // written by the audio thread only, read by the analysis thread only:
+    AbstractFifo fifo{ fifoSize };
+    AudioBuffer<float> fifoBuffer{ numChannels, fifoSize };
+
+    // the analysis thread's own buffers, where the latest
+    // samples are kept in a cycle to compute the spectrum from:
+    AudioBuffer<float> analysisBuffer{ numChannels, fifoSize };
+    AudioBuffer<float> spectrumHistory{ numChannels, spectrumSize };
+    int spectrumHistoryPosition = 0;
+
     Atomic<float> spectrum[numChannels][spectrumSize];
     Atomic<float> peak[numChannels];
     Atomic<float> rms[numChannels];
@@ -22,6 +22,8 @@
 #include "MainLayout.h"
 #include "CommandIDs.h"
 #include "Config.h"
+#include "UiProfiler.h"
+#include "DocumentHelpers.h"
 
 CommandPaletteCommonActions::CommandPaletteCommonActions()
 {
@@ -34,6 +36,40 @@ CommandPaletteCommonActions::CommandPaletteCommonActions()
     this->help.add(CommandPaletteAction::action(TRANS(I18n::CommandPalette::projects), "/", -1.f)->
         withCallback([](TextEditor &ed) { ed.setText("/"); return false; }));
 
+#if DEBUG
+
+    // developer tools, only available in debug builds, so not translated:
+    this->tools.add(CommandPaletteAction::action("Toggle UI profiler", {}, 1.f)->
+        withCallback([](TextEditor &ed) { App::Layout().toggleUiProfiler(); return true; }));
+
+    this->tools.add(CommandPaletteAction::action("Export UI profiler trace", {}, 2.f)->
+        withCallback([](TextEditor &ed)
+        {
+            if (!UiProfiler::isEnabled())
+            {
+                App::Layout().showTooltip("UI profiler is off", MainLayout::TooltipType::Failure);
+                return true;
+            }
+
+            const auto fileName = "UiProfile-" +
+                Time::getCurrentTime().formatted("%Y-%m-%d-%H-%M-%S") + ".json";
+
+            const auto file = DocumentHelpers::getDocumentSlot(fileName);
+            if (UiProfiler::exportChromeTrace(file))
+            {
+                App::Layout().showTooltip("UI profiler trace saved to '" +
+                    file.getFileName() + "'", MainLayout::TooltipType::Success);
+            }
+            else
+            {
+                App::Layout().showTooltip({}, MainLayout::TooltipType::Failure);
+            }
+
+            return true;
+        }));
+
+#endif
+
     // some thoughts for the future:
 
     // # for quantization actions? with q as a hotkey?
@@ -87,6 +123,7 @@ void CommandPaletteCommonActions::setActiveCommandReceivers(const Array<Componen
 {
     this->helpAndCommands.clearQuick();
     this->helpAndCommands.addArray(this->help);
+    this->helpAndCommands.addArray(this->tools);
 
     for (const auto *receiver : receivers)
     {
@@ -29,7 +29,7 @@ public:
 
     bool usesPrefix(const Prefix prefix) const noexcept override
     {
-        return (this->helpAndCommands.size() == this->help.size()) ? prefix == '?' : false;
+        return (this->helpAndCommands.size() == this->help.size() + this->tools.size()) ? prefix == '?' : false;
     }
 
 protected:
@@ -37,6 +37,7 @@ protected:
     const Actions &getActions() const override;
 
     Actions help;
+    Actions tools;
     Actions helpAndCommands;
 
     FlatHashMap<String, Actions, StringHash> commandsCache;
@@ -78,6 +78,8 @@ namespace I18n
         static const Identifier vcsCheckoutWarning = "dialog::vcs::checkout::warning";
         static const Identifier vcsCommitCaption = "dialog::vcs::commit::caption";
         static const Identifier vcsCommitProceed = "dialog::vcs::commit::proceed";
+        static const Identifier vcsCompactCaption = "dialog::vcs::compact::caption";
+        static const Identifier vcsCompactProceed = "dialog::vcs::compact::proceed";
         static const Identifier vcsResetCaption = "dialog::vcs::reset::caption";
         static const Identifier vcsResetProceed = "dialog::vcs::reset::proceed";
         static const Identifier workspaceCreateProjectCaption = "dialog::workspace::createproject::caption";
@@ -220,6 +222,7 @@ namespace I18n
         static const Identifier vcsChangesToggle = "menu::vcs::changes::toggle";
 
         static const Identifier vcsCommitAll = "menu::vcs::commitall";
+        static const Identifier vcsCompactHistory = "menu::vcs::compacthistory";
         static const Identifier vcsResetAll = "menu::vcs::resetall";
         static const Identifier vcsStash = "menu::vcs::stash";
         static const Identifier vcsSyncAll = "menu::vcs::syncall";
@@ -301,6 +304,7 @@ namespace I18n
         static const Identifier deltaTypeChanged = "vcs::delta::type::changed";
         static const Identifier deltaTypeRemoved = "vcs::delta::type::removed";
         static const Identifier historyCaption = "vcs::history::caption";
+        static const Identifier compactDone = "vcs::compact::done";
         static const Identifier stageCaption = "vcs::stage::caption";
         static const Identifier syncDone = "vcs::sync::done";
         static const Identifier syncUptodate = "vcs::sync::uptodate";
@@ -19,6 +19,11 @@
 
 class Pattern;
 
+namespace VCS
+{
+    class PackedDeltaHelpers;
+}
+
 // Just an instance of a midi sequence on a certain position,
 // Optionally, with key delta, velocity multiplier, muted or soloed.
 // In future it should have adjustable length too
@@ -116,6 +121,7 @@ private:
 
     friend struct ClipHash;
     friend class LegacyClipFormatSupportTests;
+    friend class VCS::PackedDeltaHelpers;
 
     JUCE_LEAK_DETECTOR(Clip);
 };
@@ -410,6 +410,26 @@ SerializedData Pattern::serialize() const
     return tree;
 }
 
+SerializedSnapshot Pattern::createSnapshot() const
+{
+    Array<Clip> clips;
+    clips.ensureStorageAllocated(this->clips.size());
+    for (const auto *clip : this->clips)
+    {
+        clips.add(Clip(nullptr, *clip));
+    }
+
+    return [clips](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::Midi::pattern, 0, clips.size());
+        for (const auto &clip : clips)
+        {
+            clip.serializeTo(writer);
+        }
+        writer.endNode();
+    };
+}
+
 void Pattern::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -101,6 +101,7 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    SerializedSnapshot createSnapshot() const override;
     void deserialize(const SerializedData &data) override;
     void reset() override;
 
@@ -250,6 +250,11 @@ SerializedData AnnotationsSequence::serialize() const
     return tree;
 }
 
+SerializedSnapshot AnnotationsSequence::createSnapshot() const
+{
+    return this->createEventsSnapshot<AnnotationEvent>(Serialization::Midi::annotations);
+}
+
 void AnnotationsSequence::deserialize(const SerializedData &data)
 {
     this->reset();
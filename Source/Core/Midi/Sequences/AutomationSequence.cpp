@@ -230,15 +230,26 @@ bool AutomationSequence::changeGroup(const Array<AutomationEvent> groupBefore,
 
 SerializedData AutomationSequence::serialize() const
 {
-    SerializedData tree(Serialization::Midi::automation);
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+SerializedSnapshot AutomationSequence::createSnapshot() const
+{
+    return this->createEventsSnapshot<AutomationEvent>(Serialization::Midi::automation);
+}
+
+void AutomationSequence::serializeTo(SerializedDataWriter &writer) const
+{
+    writer.beginNode(Serialization::Midi::automation, 0, this->midiEvents.size());
 
     for (int i = 0; i < this->midiEvents.size(); ++i)
     {
-        MidiEvent *event = this->midiEvents.getUnchecked(i);
-        tree.appendChild(event->serialize());
+        this->midiEvents.getUnchecked(i)->serializeTo(writer);
     }
-    
-    return tree;
+
+    writer.endNode();
 }
 
 void AutomationSequence::deserialize(const SerializedData &data)
@@ -272,6 +283,42 @@ void AutomationSequence::deserialize(const SerializedData &data)
     this->updateBeatRange(false);
 }
 
+void AutomationSequence::deserializeFrom(SerializedDataReader &reader)
+{
+    this->reset();
+
+    if (!reader.isNodeOfType(Serialization::Midi::automation))
+    {
+        reader.skipTree();
+        return;
+    }
+
+    reader.readNodeHeader();
+    const auto numChildren = reader.readNumChildren();
+    this->midiEvents.ensureStorageAllocated(numChildren);
+
+    const AutomationEvent emptyEvent;
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        if (!reader.isNodeOfType(Serialization::Midi::automationEvent))
+        {
+            reader.skipTree();
+            continue;
+        }
+
+        // copying the empty event avoids generating an id, which is read anyway
+        auto *event = new AutomationEvent(this, emptyEvent);
+        event->deserializeFrom(reader);
+
+        this->midiEvents.add(event); // sorted later
+        this->usedEventIds.insert(event->getId());
+    }
+
+    this->sort();
+    this->updateBeatRange(false);
+}
+
 void AutomationSequence::reset()
 {
     this->midiEvents.clear();
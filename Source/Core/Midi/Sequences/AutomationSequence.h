@@ -54,7 +54,10 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    SerializedSnapshot createSnapshot() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
     void deserialize(const SerializedData &data) override;
+    void deserializeFrom(SerializedDataReader &reader) override;
     void reset() override;
     
 private:
@@ -261,14 +261,21 @@ AutomationEvent AutomationEvent::pedalDownEvent(MidiSequence *owner, float beatV
 //===----------------------------------------------------------------------===//
 
 SerializedData AutomationEvent::serialize() const
+{
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+void AutomationEvent::serializeTo(SerializedDataWriter &writer) const
 {
     using namespace Serialization;
-    SerializedData tree(Midi::automationEvent);
-    tree.setProperty(Midi::id, packId(this->id));
-    tree.setProperty(Midi::value, this->controllerValue);
-    tree.setProperty(Midi::curve, this->curvature);
-    tree.setProperty(Midi::timestamp, int(this->beat * Globals::ticksPerBeat));
-    return tree;
+    writer.beginNode(Midi::automationEvent, 4, 0);
+    writer.writeProperty(Midi::id, packId(this->id));
+    writer.writeProperty(Midi::value, this->controllerValue);
+    writer.writeProperty(Midi::curve, this->curvature);
+    writer.writeProperty(Midi::timestamp, int(this->beat * Globals::ticksPerBeat));
+    writer.endNode();
 }
 
 void AutomationEvent::deserialize(const SerializedData &data)
@@ -281,6 +288,31 @@ void AutomationEvent::deserialize(const SerializedData &data)
     this->id = unpackId(data.getProperty(Midi::id));
 }
 
+void AutomationEvent::deserializeFrom(SerializedDataReader &reader)
+{
+    this->reset();
+    using namespace Serialization;
+
+    // same as above, but without creating vars for each property
+    this->id = 0;
+    this->beat = 0.f;
+    this->controllerValue = 0.f;
+    this->curvature = Globals::Defaults::automationControllerCurve;
+
+    const auto numProperties = reader.beginNode();
+    for (int i = 0; i < numProperties; ++i)
+    {
+        const auto name = reader.readPropertyName();
+        if (Midi::id == name) { this->id = unpackId(reader.readString()); }
+        else if (Midi::value == name) { this->controllerValue = reader.readFloat(); }
+        else if (Midi::curve == name) { this->curvature = reader.readFloat(); }
+        else if (Midi::timestamp == name) { this->beat = reader.readFloat() / Globals::ticksPerBeat; }
+        else { reader.skipValue(); }
+    }
+
+    reader.skipChildren();
+}
+
 void AutomationEvent::reset() noexcept {}
 
 void AutomationEvent::applyChanges(const AutomationEvent &parameters) noexcept
@@ -80,7 +80,9 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
     void deserialize(const SerializedData &data) override;
+    void deserializeFrom(SerializedDataReader &reader) override;
     void reset() noexcept override;
 
     //===------------------------------------------------------------------===//
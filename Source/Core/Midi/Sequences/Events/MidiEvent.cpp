@@ -107,9 +107,14 @@ String MidiEvent::packId(Id id)
 }
 
 MidiEvent::Id MidiEvent::unpackId(const String &str)
+{
+    return unpackId(StringRef(str));
+}
+
+MidiEvent::Id MidiEvent::unpackId(StringRef str)
 {
     MidiEvent::Id id = 0;
-    const auto *ptr = str.getCharPointer().getAddress();
+    const auto *ptr = str.text.getAddress();
     for (int i = 0; i < jmin(4, str.length()); ++i)
     {
         id |= ptr[i] << (i * CHAR_BIT);
@@ -95,6 +95,7 @@ protected:
     Id createId() const noexcept;
     static String packId(MidiEvent::Id id);
     static Id unpackId(const String &str);
+    static Id unpackId(StringRef str);
 
     friend struct MidiEventHash;
     friend class LegacyEventFormatSupportTests;
@@ -212,19 +212,27 @@ Note::Tuplet Note::getTuplet() const noexcept
 //===----------------------------------------------------------------------===//
 
 SerializedData Note::serialize() const
+{
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+void Note::serializeTo(SerializedDataWriter &writer) const
 {
     using namespace Serialization;
-    SerializedData tree(Midi::note);
-    tree.setProperty(Midi::id, packId(this->id));
-    tree.setProperty(Midi::key, this->key);
-    tree.setProperty(Midi::timestamp, int(this->beat * Globals::ticksPerBeat));
-    tree.setProperty(Midi::length, int(this->length * Globals::ticksPerBeat));
-    tree.setProperty(Midi::volume, int(this->velocity * Globals::velocitySaveResolution));
-    if (this->tuplet > 1)
+    const bool hasTuplet = this->tuplet > 1;
+    writer.beginNode(Midi::note, hasTuplet ? 6 : 5, 0);
+    writer.writeProperty(Midi::id, packId(this->id));
+    writer.writeProperty(Midi::key, this->key);
+    writer.writeProperty(Midi::timestamp, int(this->beat * Globals::ticksPerBeat));
+    writer.writeProperty(Midi::length, int(this->length * Globals::ticksPerBeat));
+    writer.writeProperty(Midi::volume, int(this->velocity * Globals::velocitySaveResolution));
+    if (hasTuplet)
     {
-        tree.setProperty(Midi::tuplet, this->tuplet);
+        writer.writeProperty(Midi::tuplet, this->tuplet);
     }
-    return tree;
+    writer.endNode();
 }
 
 void Note::deserialize(const SerializedData &data)
@@ -240,6 +248,36 @@ void Note::deserialize(const SerializedData &data)
     this->tuplet = Tuplet(int(data.getProperty(Midi::tuplet, 1)));
 }
 
+void Note::deserializeFrom(SerializedDataReader &reader)
+{
+    using namespace Serialization;
+
+    // same as above, but without creating vars for each property,
+    // and the missing properties fall back to the same defaults
+    this->id = 0;
+    this->key = 0;
+    this->beat = 0.f;
+    this->length = 0.f;
+    this->velocity = 0.f;
+    this->tuplet = 1;
+
+    const auto numProperties = reader.beginNode();
+    for (int i = 0; i < numProperties; ++i)
+    {
+        const auto name = reader.readPropertyName();
+        if (Midi::id == name) { this->id = unpackId(reader.readString()); }
+        else if (Midi::key == name) { this->key = reader.readInt(); }
+        else if (Midi::timestamp == name) { this->beat = reader.readFloat() / Globals::ticksPerBeat; }
+        else if (Midi::length == name) { this->length = reader.readFloat() / Globals::ticksPerBeat; }
+        else if (Midi::volume == name) { this->velocity = reader.readFloat() / Globals::velocitySaveResolution; }
+        else if (Midi::tuplet == name) { this->tuplet = Tuplet(reader.readInt()); }
+        else { reader.skipValue(); }
+    }
+
+    reader.skipChildren();
+    this->velocity = jmax(jmin(this->velocity, 1.f), 0.f);
+}
+
 void Note::reset() noexcept {}
 
 void Note::applyChanges(const Note &other) noexcept
@@ -19,6 +19,11 @@
 
 #include "MidiEvent.h"
 
+namespace VCS
+{
+    class PackedDeltaHelpers;
+}
+
 class Note final : public MidiEvent
 {
 public:
@@ -70,7 +75,9 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
     void deserialize(const SerializedData &data) override;
+    void deserializeFrom(SerializedDataReader &reader) override;
     void reset() noexcept override;
 
     //===------------------------------------------------------------------===//
@@ -100,5 +107,7 @@ protected:
 
 private:
 
+    friend class VCS::PackedDeltaHelpers;
+
     JUCE_LEAK_DETECTOR(Note);
 };
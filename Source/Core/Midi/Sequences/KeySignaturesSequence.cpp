@@ -253,6 +253,11 @@ SerializedData KeySignaturesSequence::serialize() const
     return tree;
 }
 
+SerializedSnapshot KeySignaturesSequence::createSnapshot() const
+{
+    return this->createEventsSnapshot<KeySignatureEvent>(Serialization::Midi::keySignatures);
+}
+
 void KeySignaturesSequence::deserialize(const SerializedData &data)
 {
     this->reset();
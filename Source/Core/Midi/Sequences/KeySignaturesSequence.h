@@ -54,6 +54,7 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    SerializedSnapshot createSnapshot() const override;
     void deserialize(const SerializedData &data) override;
     void reset() override;
 
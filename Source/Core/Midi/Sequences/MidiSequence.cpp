@@ -23,6 +23,8 @@
 #include "Temperament.h"
 #include "UndoStack.h"
 #include "MidiTrack.h"
+#include "PianoSequence.h"
+#include "Note.h"
 
 struct EventIdGenerator final
 {
@@ -241,6 +243,60 @@ int MidiSequence::getChannel() const noexcept
     return this->track.getTrackChannel();
 }
 
+//===----------------------------------------------------------------------===//
+// Loader
+//===----------------------------------------------------------------------===//
+
+class SequenceDeserializationJob final : public ThreadPoolJob
+{
+public:
+
+    SequenceDeserializationJob(MidiSequence *sequence, const SerializedDataReader &reader) :
+        ThreadPoolJob("Sequence Deserialization Job"),
+        sequence(sequence),
+        reader(reader) {}
+
+    JobStatus runJob() override
+    {
+        this->sequence->deserializeFrom(this->reader);
+        return jobHasFinished;
+    }
+
+private:
+
+    MidiSequence *const sequence;
+    SerializedDataReader reader;
+
+    JUCE_DECLARE_NON_COPYABLE(SequenceDeserializationJob)
+};
+
+MidiSequencesLoader::~MidiSequencesLoader()
+{
+    this->waitForAll();
+}
+
+void MidiSequencesLoader::deserializeInBackground(MidiSequence *sequence, SerializedDataReader &reader)
+{
+    if (this->workers == nullptr)
+    {
+        this->workers = make<ThreadPool>(jmax(1, SystemStats::getNumCpus()));
+    }
+
+    auto *job = this->jobs.add(new SequenceDeserializationJob(sequence, reader));
+    this->workers->addJob(job, false);
+    reader.skipTree();
+}
+
+void MidiSequencesLoader::waitForAll()
+{
+    for (auto *job : this->jobs)
+    {
+        this->workers->waitForJobToFinish(job, -1);
+    }
+
+    this->jobs.clear();
+}
+
 //===----------------------------------------------------------------------===//
 // Tests
 //===----------------------------------------------------------------------===//
@@ -287,4 +343,74 @@ public:
 
 static LegacyEventFormatSupportTests legacyFormatSupportTests;
 
+class MidiSequencesLoaderTests final : public UnitTest
+{
+public:
+    MidiSequencesLoaderTests() : UnitTest("Midi sequences loader tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Parallel loading gives the same sequences as serial loading");
+
+        EmptyMidiTrack track;
+        EmptyEventDispatcher dispatcher;
+
+        OwnedArray<PianoSequence> sources;
+        MemoryOutputStream stream;
+        SerializedDataBinaryWriter writer(stream);
+        writer.beginNode("sequences", 0, numSequences);
+        for (int i = 0; i < numSequences; ++i)
+        {
+            auto *sequence = sources.add(new PianoSequence(track, dispatcher));
+            for (int j = 0; j < 100 * (i + 1); ++j)
+            {
+                const Note note(sequence, (i + j) % 128, float(j), 1.f, 0.5f);
+                sequence->importMidiEvent<Note>(note);
+            }
+
+            sequence->serializeTo(writer);
+        }
+        writer.endNode();
+
+        OwnedArray<PianoSequence> serial;
+        {
+            SerializedDataReader reader(stream.getData(), stream.getDataSize());
+            reader.readNodeHeader();
+            expectEquals(reader.readNumChildren(), int(numSequences));
+            for (int i = 0; i < numSequences; ++i)
+            {
+                serial.add(new PianoSequence(track, dispatcher))->deserializeFrom(reader);
+            }
+        }
+
+        OwnedArray<PianoSequence> parallel;
+        {
+            SerializedDataReader reader(stream.getData(), stream.getDataSize());
+            reader.readNodeHeader();
+            reader.readNumChildren();
+
+            MidiSequencesLoader loader;
+            for (int i = 0; i < numSequences; ++i)
+            {
+                loader.deserializeInBackground(parallel.add(new PianoSequence(track, dispatcher)), reader);
+            }
+
+            loader.waitForAll();
+        }
+
+        for (int i = 0; i < numSequences; ++i)
+        {
+            expectEquals(serial[i]->size(), sources[i]->size());
+            expect(serial[i]->serialize().isEquivalentTo(sources[i]->serialize()));
+            expect(parallel[i]->serialize().isEquivalentTo(serial[i]->serialize()));
+        }
+    }
+
+private:
+
+    static constexpr auto numSequences = 16;
+};
+
+static MidiSequencesLoaderTests midiSequencesLoaderTests;
+
 #endif
@@ -98,6 +98,20 @@ public:
         this->midiEvents.addSorted(comparator, event.release());
     }
 
+    template<typename T>
+    void checkoutEvent(const T &parameters)
+    {
+        if (this->usedEventIds.contains(parameters.getId()))
+        {
+            jassertfalse;
+            return;
+        }
+
+        static T comparator;
+        this->usedEventIds.insert(parameters.getId());
+        this->midiEvents.addSorted(comparator, new T(this, parameters));
+    }
+
     //===------------------------------------------------------------------===//
     // Accessors
     //===------------------------------------------------------------------===//
@@ -166,9 +180,56 @@ protected:
 
     OwnedArray<MidiEvent> midiEvents;
     mutable FlatHashSet<MidiEvent::Id> usedEventIds;
+
+    // copies all events by value and writes them later
+    // as the sequence node of a given type, see createSnapshot()
+    template<typename T>
+    SerializedSnapshot createEventsSnapshot(const Identifier &type) const
+    {
+        Array<T> events;
+        events.ensureStorageAllocated(this->midiEvents.size());
+        for (const auto *event : this->midiEvents)
+        {
+            events.add(T(nullptr, *static_cast<const T *>(event)));
+        }
+
+        return [type, events](SerializedDataWriter &writer)
+        {
+            writer.beginNode(type, 0, events.size());
+            for (const auto &event : events)
+            {
+                event.serializeTo(writer);
+            }
+            writer.endNode();
+        };
+    }
     
 private:
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiSequence)
     JUCE_DECLARE_WEAK_REFERENCEABLE(MidiSequence)
 };
+
+// Builds the sequences on the worker threads while the project is loading;
+// each job only touches its own sequence, and the loader is only created
+// for the time of loading, so that its threads don't outlive it
+
+class MidiSequencesLoader final
+{
+public:
+
+    MidiSequencesLoader() = default;
+    ~MidiSequencesLoader();
+
+    // takes a copy of the reader positioned at the sequence node,
+    // and moves the given reader past it
+    void deserializeInBackground(MidiSequence *sequence, SerializedDataReader &reader);
+    void waitForAll();
+
+private:
+
+    OwnedArray<ThreadPoolJob> jobs;
+    UniquePointer<ThreadPool> workers;
+
+    JUCE_DECLARE_NON_COPYABLE(MidiSequencesLoader)
+};
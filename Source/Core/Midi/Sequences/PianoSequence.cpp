@@ -23,6 +23,7 @@
 #include "NoteActions.h"
 #include "SerializationKeys.h"
 #include "UndoStack.h"
+#include "MidiTrack.h"
 
 PianoSequence::PianoSequence(MidiTrack &track,
     ProjectEventDispatcher &dispatcher) noexcept :
@@ -229,9 +230,17 @@ bool PianoSequence::changeGroup(Array<Note> &groupBefore,
 
     if (undoable)
     {
-        this->getUndoStack()->
-            perform(new NotesGroupChangeAction(*this->getProject(),
-                this->getTrackId(), groupBefore, groupAfter));
+        // bulk transforms like transposing are stored as ids and deltas:
+        UndoAction *action = NotesGroupTransformAction::tryCreate(*this->getProject(),
+            this->getTrackId(), groupBefore, groupAfter);
+
+        if (action == nullptr)
+        {
+            action = new NotesGroupChangeAction(*this->getProject(),
+                this->getTrackId(), groupBefore, groupAfter);
+        }
+
+        this->getUndoStack()->perform(action);
     }
     else
     {
@@ -296,15 +305,26 @@ float PianoSequence::findLastBeat() const noexcept
 
 SerializedData PianoSequence::serialize() const
 {
-    SerializedData tree(Serialization::Midi::track);
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+SerializedSnapshot PianoSequence::createSnapshot() const
+{
+    return this->createEventsSnapshot<Note>(Serialization::Midi::track);
+}
+
+void PianoSequence::serializeTo(SerializedDataWriter &writer) const
+{
+    writer.beginNode(Serialization::Midi::track, 0, this->midiEvents.size());
 
     for (int i = 0; i < this->midiEvents.size(); ++i)
     {
-        const auto *event = this->midiEvents.getUnchecked(i);
-        tree.appendChild(event->serialize());
+        this->midiEvents.getUnchecked(i)->serializeTo(writer);
     }
-    
-    return tree;
+
+    writer.endNode();
 }
 
 void PianoSequence::deserialize(const SerializedData &data)
@@ -333,8 +353,126 @@ void PianoSequence::deserialize(const SerializedData &data)
     this->updateBeatRange(false);
 }
 
+void PianoSequence::deserializeFrom(SerializedDataReader &reader)
+{
+    this->reset();
+
+    if (!reader.isNodeOfType(Serialization::Midi::track))
+    {
+        reader.skipTree();
+        return;
+    }
+
+    reader.readNodeHeader();
+    const auto numChildren = reader.readNumChildren();
+    this->midiEvents.ensureStorageAllocated(numChildren);
+
+    const Note emptyNote;
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        if (!reader.isNodeOfType(Serialization::Midi::note))
+        {
+            reader.skipTree();
+            continue;
+        }
+
+        // copying the empty note avoids generating an id, which is read anyway
+        auto *event = new Note(this, emptyNote);
+        event->deserializeFrom(reader);
+
+        this->midiEvents.add(event); // sorted later
+        this->usedEventIds.insert(event->getId());
+    }
+
+    this->sort();
+    this->updateBeatRange(false);
+}
+
 void PianoSequence::reset()
 {
     this->midiEvents.clear();
     this->usedEventIds.clear();
 }
+
+//===----------------------------------------------------------------------===//
+// Tests
+//===----------------------------------------------------------------------===//
+
+#if JUCE_UNIT_TESTS
+
+class PianoSequenceSnapshotTests final : public UnitTest
+{
+public:
+    PianoSequenceSnapshotTests() : UnitTest("Piano sequence snapshot tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Snapshot written in background is not affected by edits");
+
+        EmptyMidiTrack track;
+        EmptyEventDispatcher dispatcher;
+        PianoSequence sequence(track, dispatcher);
+        this->fillSequence(sequence, 0);
+
+        MemoryOutputStream expected;
+        SerializedDataBinaryWriter expectedWriter(expected);
+        sequence.serializeTo(expectedWriter);
+
+        SnapshotWriterThread writerThread(sequence.createSnapshot());
+        writerThread.startThread();
+
+        // keep replacing all the notes while the snapshot is being written
+        for (int i = 1; i < 10; ++i)
+        {
+            sequence.reset();
+            this->fillSequence(sequence, i);
+        }
+
+        writerThread.waitForThreadToExit(-1);
+
+        expect(writerThread.output.getMemoryBlock() == expected.getMemoryBlock());
+
+        PianoSequence restored(track, dispatcher);
+        SerializedDataReader reader(writerThread.output.getData(), writerThread.output.getDataSize());
+        restored.deserializeFrom(reader);
+        expectEquals(restored.size(), int(numNotes));
+    }
+
+private:
+
+    static constexpr auto numNotes = 1000;
+
+    void fillSequence(PianoSequence &sequence, int keyOffset)
+    {
+        for (int i = 0; i < numNotes; ++i)
+        {
+            const Note note(&sequence, (i + keyOffset) % 128, float(i), 1.f, 0.5f);
+            sequence.importMidiEvent<Note>(note);
+        }
+    }
+
+    class SnapshotWriterThread final : public Thread
+    {
+    public:
+
+        explicit SnapshotWriterThread(const SerializedSnapshot &snapshot) :
+            Thread("SnapshotWriter"), snapshot(snapshot) {}
+
+        void run() override
+        {
+            SerializedDataBinaryWriter writer(this->output);
+            this->snapshot(writer);
+        }
+
+        MemoryOutputStream output;
+
+    private:
+
+        const SerializedSnapshot snapshot;
+    };
+};
+
+static PianoSequenceSnapshotTests pianoSequenceSnapshotTests;
+
+#endif
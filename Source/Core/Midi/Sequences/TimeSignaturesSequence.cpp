@@ -254,6 +254,11 @@ SerializedData TimeSignaturesSequence::serialize() const
     return tree;
 }
 
+SerializedSnapshot TimeSignaturesSequence::createSnapshot() const
+{
+    return this->createEventsSnapshot<TimeSignatureEvent>(Serialization::Midi::timeSignatures);
+}
+
 void TimeSignaturesSequence::deserialize(const SerializedData &data)
 {
     this->reset();
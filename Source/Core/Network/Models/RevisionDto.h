@@ -31,6 +31,8 @@ public:
     String getParentId() const noexcept { return DTO_PROPERTY(Revisions::parentId); }
     int64 getTimestamp() const noexcept { return DTO_PROPERTY(Revisions::timestamp); }
     SerializedData getData() const noexcept { return DTO_CHILD(Revisions::data); }
+    String getPackedData() const noexcept { return DTO_PROPERTY(Revisions::packedData); }
+    bool hasPackedData() const noexcept { return this->data.hasProperty(Serialization::Api::V1::Revisions::packedData); }
 
     JUCE_LEAK_DETECTOR(RevisionDto)
 };
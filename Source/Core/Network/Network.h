@@ -46,6 +46,7 @@ namespace Routes
         static const String projects = "/my/projects";
         static const String project = "/my/projects/:projectId";
         static const String projectRevision = "/my/projects/:projectId/revisions/:revisionId";
+        static const String projectRevisions = "/my/projects/:projectId/revisions";
     }
 }
 
@@ -18,6 +18,7 @@
 #include "Common.h"
 #include "ProjectCloneThread.h"
 #include "RevisionsSyncHelpers.h"
+#include "RevisionsSyncTransport.h"
 #include "ProjectDto.h"
 #include "Network.h"
 
@@ -79,31 +80,35 @@ void ProjectCloneThread::run()
 
     this->newHead = nullptr;
 
-    // if anything is needed to pull, fetch all data for each, then update and callback
+    Array<String> revisionIds;
     for (const auto &dto : remoteProject.getRevisions())
     {
-        const String revisionRoute(Routes::Api::projectRevision
-            .replace(":projectId", this->projectId)
-            .replace(":revisionId", dto.getId()));
-
-        const BackendRequest revisionRequest(revisionRoute);
-        this->response = revisionRequest.get();
-        if (!this->response.is2xx())
-        {
-            DBG("Failed to fetch revision data: " + this->response.getErrors().getFirst());
-            callbackOnMessageThread(ProjectCloneThread, onCloneFailed, self->response.getErrors(), self->projectId);
-            return;
-        }
+        revisionIds.add(dto.getId());
+    }
 
-        const RevisionDto fullData(this->response.getBody());
-        auto revision = this->vcs->updateShallowRevisionData(fullData.getId(), fullData.getData());
+    // fetch all data in batches, then update and callback
+    const auto headId = remoteProject.getHead();
+    BackendRevisionsTransport transport(this->projectId);
+    this->errors.clearQuick();
 
-        // if project's head is null, this will at least point the new head to one of leafs:
-        if ((this->newHead == nullptr && revision->getChildren().isEmpty()) ||
-            revision->getUuid() == remoteProject.getHead())
+    const bool pulled = RevisionsSyncHelpers::pullRevisions(transport, revisionIds,
+        [this, &headId](const RevisionDto &fullData)
         {
-            this->newHead = revision;
-        }
+            auto revision = this->vcs->updateShallowRevisionData(fullData.getId(),
+                RevisionsSyncHelpers::getRevisionData(fullData));
+
+            // if project's head is null, this will at least point the new head to one of leafs:
+            if ((this->newHead == nullptr && revision->getChildren().isEmpty()) ||
+                revision->getUuid() == headId)
+            {
+                this->newHead = revision;
+            }
+        }, this->errors);
+
+    if (!pulled)
+    {
+        callbackOnMessageThread(ProjectCloneThread, onCloneFailed, self->errors, self->projectId);
+        return;
     }
 
     jassert(this->newHead != nullptr);
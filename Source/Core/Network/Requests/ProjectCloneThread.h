@@ -44,5 +44,8 @@ private:
 
     BackendRequest::Response response;
 
+    // collected from the batch transfers, if any fails
+    Array<String> errors;
+
     friend class BackendService;
 };
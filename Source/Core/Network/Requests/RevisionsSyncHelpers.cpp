@@ -17,6 +17,8 @@
 
 #include "Common.h"
 #include "RevisionsSyncHelpers.h"
+#include "RevisionsSyncTransport.h"
+#include "SerializationKeys.h"
 
 void RevisionsSyncHelpers::buildLocalRevisionsIndex(RevisionsMap &map, VCS::Revision::Ptr root)
 {
@@ -131,3 +133,442 @@ VCS::Revision::Ptr RevisionsSyncHelpers::constructRemoteTree(const Array<Revisio
     jassert(root != nullptr);
     return root;
 }
+
+static void flattenSubtree(ReferenceCountedArray<VCS::Revision> &result,
+    VCS::Revision::Ptr root, const Array<String> &idsFilter)
+{
+    if (idsFilter.isEmpty() || idsFilter.contains(root->getUuid()))
+    {
+        result.add(root);
+    }
+
+    // the children of skipped revisions still might be listed in the filter
+    for (auto *child : root->getChildren())
+    {
+        flattenSubtree(result, child, idsFilter);
+    }
+}
+
+ReferenceCountedArray<VCS::Revision> RevisionsSyncHelpers::flattenTrees(const ReferenceCountedArray<VCS::Revision> &trees,
+    const Array<String> &idsFilter)
+{
+    ReferenceCountedArray<VCS::Revision> result;
+    for (auto *tree : trees)
+    {
+        flattenSubtree(result, tree, idsFilter);
+    }
+
+    return result;
+}
+
+bool RevisionsSyncHelpers::pushRevisions(RevisionsSyncTransport &transport,
+    const ReferenceCountedArray<VCS::Revision> &parentFirstList,
+    Function<void(VCS::Revision::Ptr revision)> onPushed, Array<String> &errors)
+{
+    int batchStart = 0;
+    while (batchStart < parentFirstList.size())
+    {
+        // check it for each batch, since the transport
+        // might find out batches are not supported in the meantime
+        const bool usesBatches = transport.supportsBatches();
+        const int maxBatchSize = usesBatches ? maxRevisionsPerBatch : 1;
+
+        Array<SerializedData> payloads;
+        int batchBytes = 0;
+        int batchEnd = batchStart;
+        while (batchEnd < parentFirstList.size() && payloads.size() < maxBatchSize)
+        {
+            const auto payload = createRevisionPayload(parentFirstList.getUnchecked(batchEnd), usesBatches);
+            const int payloadBytes = payload.getProperty(Serialization::Api::V1::Revisions::packedData).toString().length();
+            if (!payloads.isEmpty() && batchBytes + payloadBytes > maxBytesPerBatch)
+            {
+                break;
+            }
+
+            payloads.add(payload);
+            batchBytes += payloadBytes;
+            batchEnd++;
+        }
+
+        if (!transport.pushRevisions(payloads, errors))
+        {
+            return false;
+        }
+
+        for (int i = batchStart; i < batchEnd; ++i)
+        {
+            if (onPushed != nullptr)
+            {
+                onPushed(parentFirstList.getUnchecked(i));
+            }
+        }
+
+        batchStart = batchEnd;
+    }
+
+    return true;
+}
+
+bool RevisionsSyncHelpers::pullRevisions(RevisionsSyncTransport &transport, const Array<String> &ids,
+    Function<void(const RevisionDto &revision)> onPulled, Array<String> &errors)
+{
+    for (int batchStart = 0; batchStart < ids.size(); batchStart += maxRevisionsPerBatch)
+    {
+        Array<String> batchIds;
+        batchIds.addArray(ids, batchStart, maxRevisionsPerBatch);
+
+        Array<RevisionDto> revisions;
+        if (!transport.fetchRevisions(batchIds, revisions, errors))
+        {
+            return false;
+        }
+
+        // a successful response is not necessarily a complete one,
+        // so only accept the revisions that were actually requested
+        FlatHashSet<String, StringHash> receivedIds;
+        for (const auto &revision : revisions)
+        {
+            const auto revisionId = revision.getId();
+            if (!batchIds.contains(revisionId) || receivedIds.contains(revisionId))
+            {
+                continue;
+            }
+
+            receivedIds.insert(revisionId);
+            if (onPulled != nullptr)
+            {
+                onPulled(revision);
+            }
+        }
+
+        for (const auto &id : batchIds)
+        {
+            if (receivedIds.contains(id))
+            {
+                continue;
+            }
+
+            Array<RevisionDto> missingRevision;
+            if (!transport.fetchRevisions({ id }, missingRevision, errors))
+            {
+                return false;
+            }
+
+            if (missingRevision.size() != 1 || missingRevision.getFirst().getId() != id)
+            {
+                DBG("Failed to fetch revision " + id);
+                errors.add("Failed to fetch revision " + id);
+                return false;
+            }
+
+            if (onPulled != nullptr)
+            {
+                onPulled(missingRevision.getFirst());
+            }
+        }
+    }
+
+    return true;
+}
+
+SerializedData RevisionsSyncHelpers::createRevisionPayload(const VCS::Revision::Ptr revision, bool packed)
+{
+    using namespace Serialization::Api::V1;
+
+    SerializedData payload(Revisions::revision);
+    payload.setProperty(Revisions::id, revision->getUuid());
+    payload.setProperty(Revisions::message, revision->getMessage());
+    payload.setProperty(Revisions::timestamp, String(revision->getTimeStamp()));
+    payload.setProperty(Revisions::parentId,
+        (revision->getParent() ? var(revision->getParent()->getUuid()) : var()));
+
+    SerializedData data(Revisions::data);
+    data.appendChild(revision->serializeDeltas());
+
+    if (packed)
+    {
+        payload.setProperty(Revisions::packedData, packRevisionData(data));
+    }
+    else
+    {
+        payload.appendChild(data);
+    }
+
+    return payload;
+}
+
+SerializedData RevisionsSyncHelpers::unpackRevisionPayload(const SerializedData &payload)
+{
+    using namespace Serialization::Api::V1;
+
+    if (!payload.hasProperty(Revisions::packedData))
+    {
+        return payload;
+    }
+
+    SerializedData result(Revisions::revision);
+    result.setProperty(Revisions::id, payload.getProperty(Revisions::id));
+    result.setProperty(Revisions::message, payload.getProperty(Revisions::message));
+    result.setProperty(Revisions::timestamp, payload.getProperty(Revisions::timestamp));
+    result.setProperty(Revisions::parentId, payload.getProperty(Revisions::parentId));
+    result.appendChild(unpackRevisionData(payload.getProperty(Revisions::packedData)));
+    return result;
+}
+
+SerializedData RevisionsSyncHelpers::getRevisionData(const RevisionDto &revision)
+{
+    if (revision.hasPackedData())
+    {
+        return unpackRevisionData(revision.getPackedData());
+    }
+
+    return revision.getData();
+}
+
+String RevisionsSyncHelpers::packRevisionData(const SerializedData &data)
+{
+    MemoryOutputStream compressed;
+
+    {
+        GZIPCompressorOutputStream compressor(compressed, 9);
+        data.writeToStream(compressor);
+        compressor.flush();
+    }
+
+    return Base64::toBase64(compressed.getData(), compressed.getDataSize());
+}
+
+SerializedData RevisionsSyncHelpers::unpackRevisionData(const String &packedData)
+{
+    MemoryOutputStream compressed;
+    if (!Base64::convertFromBase64(compressed, packedData))
+    {
+        DBG("Failed to decode packed revision data");
+        return {};
+    }
+
+    MemoryInputStream compressedStream(compressed.getData(), compressed.getDataSize(), false);
+    GZIPDecompressorInputStream decompressor(compressedStream);
+    return SerializedData::readFromStream(decompressor);
+}
+
+#if JUCE_UNIT_TESTS
+
+class RevisionsSyncBatchingTests final : public UnitTest
+{
+public:
+    RevisionsSyncBatchingTests() : UnitTest("Revisions sync batching tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Pushing revisions in batches");
+
+        ReferenceCountedArray<VCS::Revision> trees;
+        trees.add(this->makeHistory(70));
+
+        const auto revisions = RevisionsSyncHelpers::flattenTrees(trees);
+        expectEquals(revisions.size(), 70);
+
+        Array<String> errors;
+        ReferenceCountedArray<VCS::Revision> pushedRevisions;
+        const auto onPushed = [&pushedRevisions](VCS::Revision::Ptr r) { pushedRevisions.add(r); };
+
+        LocalRevisionsTransport transport;
+        expect(RevisionsSyncHelpers::pushRevisions(transport, revisions, onPushed, errors));
+        expectEquals(transport.numRequests, 3);
+        expectEquals(transport.storedRevisions.size(), 70);
+        expectEquals(pushedRevisions.size(), 70);
+        expect(errors.isEmpty());
+
+        beginTest("Resuming an interrupted push");
+
+        LocalRevisionsTransport failingTransport;
+        failingTransport.numRequestsBeforeFailure = 1;
+        pushedRevisions.clearQuick();
+
+        expect(!RevisionsSyncHelpers::pushRevisions(failingTransport, revisions, onPushed, errors));
+        expect(!errors.isEmpty());
+        expectEquals(pushedRevisions.size(), int(RevisionsSyncHelpers::maxRevisionsPerBatch));
+
+        // only push the ones not reported as pushed, like the sync thread would do
+        ReferenceCountedArray<VCS::Revision> remainingRevisions;
+        for (auto *revision : revisions)
+        {
+            if (!pushedRevisions.contains(revision))
+            {
+                remainingRevisions.add(revision);
+            }
+        }
+
+        errors.clearQuick();
+        failingTransport.numRequestsBeforeFailure = -1;
+        expect(RevisionsSyncHelpers::pushRevisions(failingTransport, remainingRevisions, onPushed, errors));
+        expectEquals(failingTransport.storedRevisions.size(), 70);
+        expectEquals(pushedRevisions.size(), 70);
+
+        // pushing a child without its parent should be rejected
+        LocalRevisionsTransport emptyTransport;
+        ReferenceCountedArray<VCS::Revision> orphans;
+        orphans.add(revisions.getLast());
+        expect(!RevisionsSyncHelpers::pushRevisions(emptyTransport, orphans, nullptr, errors));
+
+        beginTest("Pulling revisions in batches");
+
+        Array<String> ids;
+        for (const auto *revision : revisions)
+        {
+            ids.add(revision->getUuid());
+        }
+
+        int numPulled = 0;
+        transport.numRequests = 0;
+        expect(RevisionsSyncHelpers::pullRevisions(transport, ids,
+            [this, &numPulled](const RevisionDto &dto)
+            {
+                expect(RevisionsSyncHelpers::getRevisionData(dto).isValid());
+                numPulled++;
+            }, errors));
+
+        expectEquals(numPulled, 70);
+        expectEquals(transport.numRequests, 3);
+
+        beginTest("Pulling revisions from incomplete batches");
+
+        numPulled = 0;
+        transport.numRequests = 0;
+        transport.numRevisionsToDropPerBatch = 2;
+        Array<String> pulledIds;
+        expect(RevisionsSyncHelpers::pullRevisions(transport, ids,
+            [&pulledIds](const RevisionDto &dto) { pulledIds.add(dto.getId()); }, errors));
+
+        // the dropped ones should be requested again, one per request
+        expectEquals(pulledIds.size(), 70);
+        expectEquals(transport.numRequests, 3 + 3 * 2);
+        for (const auto &id : ids)
+        {
+            expect(pulledIds.contains(id));
+        }
+
+        transport.numRevisionsToDropPerBatch = 0;
+
+        beginTest("Packed revision data");
+
+        SerializedData data(Serialization::Api::V1::Revisions::data);
+        SerializedData child(Serialization::VCS::revision);
+        child.setProperty(Serialization::Api::V1::Revisions::message, String::repeatedString("test", 1000));
+        data.appendChild(child);
+
+        const auto packed = RevisionsSyncHelpers::packRevisionData(data);
+        expect(packed.length() < 1000);
+
+        const auto unpacked = RevisionsSyncHelpers::unpackRevisionData(packed);
+        expect(unpacked.isEquivalentTo(data));
+    }
+
+private:
+
+    VCS::Revision::Ptr makeHistory(int numRevisions)
+    {
+        VCS::Revision::Ptr root(new VCS::Revision("root"));
+        VCS::Revision::Ptr last(root);
+        for (int i = 1; i < numRevisions; ++i)
+        {
+            VCS::Revision::Ptr child(new VCS::Revision("revision " + String(i)));
+            last->addChild(child);
+            last = child;
+        }
+
+        return root;
+    }
+
+    // an in-memory stand-in for the backend, which stores whatever
+    // was pushed, and only accepts revisions with known parents
+    struct LocalRevisionsTransport final : RevisionsSyncTransport
+    {
+        bool pushRevisions(const Array<SerializedData> &payloads, Array<String> &errors) override
+        {
+            using namespace Serialization::Api::V1;
+
+            if (!this->tryRequest(errors))
+            {
+                return false;
+            }
+
+            Array<String> acceptedIds;
+            for (const auto &payload : payloads)
+            {
+                const String parentId = payload.getProperty(Revisions::parentId);
+                if (parentId.isNotEmpty() &&
+                    !this->storedRevisions.contains(parentId) &&
+                    !acceptedIds.contains(parentId))
+                {
+                    errors.add("Unknown parent revision");
+                    return false;
+                }
+
+                acceptedIds.add(payload.getProperty(Revisions::id).toString());
+            }
+
+            for (const auto &payload : payloads)
+            {
+                this->storedRevisions[payload.getProperty(Revisions::id).toString()] = payload;
+            }
+
+            return true;
+        }
+
+        bool fetchRevisions(const Array<String> &ids,
+            Array<RevisionDto> &result, Array<String> &errors) override
+        {
+            if (!this->tryRequest(errors))
+            {
+                return false;
+            }
+
+            // simulates a truncated response for batch requests
+            const int numRevisionsToReturn = ids.size() > 1 ?
+                jmax(0, ids.size() - this->numRevisionsToDropPerBatch) : ids.size();
+
+            for (int i = 0; i < numRevisionsToReturn; ++i)
+            {
+                const auto &id = ids.getReference(i);
+                if (!this->storedRevisions.contains(id))
+                {
+                    errors.add("Unknown revision");
+                    return false;
+                }
+
+                result.add({ this->storedRevisions[id] });
+            }
+
+            return true;
+        }
+
+        bool supportsBatches() const override
+        {
+            return true;
+        }
+
+        bool tryRequest(Array<String> &errors)
+        {
+            if (this->numRequestsBeforeFailure == 0)
+            {
+                errors.add("Connection lost");
+                return false;
+            }
+
+            this->numRequestsBeforeFailure--;
+            this->numRequests++;
+            return true;
+        }
+
+        int numRequests = 0;
+        int numRequestsBeforeFailure = -1;
+        int numRevisionsToDropPerBatch = 0;
+        FlatHashMap<String, SerializedData, StringHash> storedRevisions;
+    };
+};
+
+static RevisionsSyncBatchingTests revisionsSyncBatchingTests;
+
+#endif
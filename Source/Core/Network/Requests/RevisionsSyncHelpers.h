@@ -20,6 +20,8 @@
 #include "Revision.h"
 #include "RevisionDto.h"
 
+class RevisionsSyncTransport;
+
 using RevisionsMap = FlatHashMap<String, VCS::Revision::Ptr, StringHash>;
 
 struct RevisionsSyncHelpers final
@@ -35,4 +37,34 @@ struct RevisionsSyncHelpers final
 
     // only used when cloning projects, assuming all revisions will fit in one subtree
     static VCS::Revision::Ptr constructRemoteTree(const Array<RevisionDto> &list);
+
+    // flattens the trees so that every revision comes after its parent,
+    // skipping the ones not listed in idsFilter, unless it is empty
+    static ReferenceCountedArray<VCS::Revision> flattenTrees(const ReferenceCountedArray<VCS::Revision> &trees,
+        const Array<String> &idsFilter = {});
+
+    // both methods send the revisions in batches and stop at the first failed one;
+    // callbacks are only called for the batches which were transferred completely,
+    // so that the sync state always tells where to resume from after a failure
+    static bool pushRevisions(RevisionsSyncTransport &transport,
+        const ReferenceCountedArray<VCS::Revision> &parentFirstList,
+        Function<void(VCS::Revision::Ptr revision)> onPushed, Array<String> &errors);
+
+    // if a batch comes back without some of the requested revisions,
+    // the missing ones are requested again one by one
+    static bool pullRevisions(RevisionsSyncTransport &transport, const Array<String> &ids,
+        Function<void(const RevisionDto &revision)> onPulled, Array<String> &errors);
+
+    static SerializedData createRevisionPayload(const VCS::Revision::Ptr revision, bool packed);
+    // converts a packed payload back into the form accepted by single revision requests
+    static SerializedData unpackRevisionPayload(const SerializedData &payload);
+
+    // returns the data child of a revision, whether it came packed or not
+    static SerializedData getRevisionData(const RevisionDto &revision);
+
+    static String packRevisionData(const SerializedData &data);
+    static SerializedData unpackRevisionData(const String &packedData);
+
+    static constexpr int maxRevisionsPerBatch = 32;
+    static constexpr int maxBytesPerBatch = 1024 * 1024;
 };
@@ -21,6 +21,7 @@
 #include "RevisionDto.h"
 #include "ProjectDto.h"
 #include "RevisionsSyncHelpers.h"
+#include "RevisionsSyncTransport.h"
 #include "Workspace.h"
 #include "Network.h"
 
@@ -144,8 +145,25 @@ void RevisionsSyncThread::run()
         }
     }
 
+    // find the revisions which the previous sync has started to pull, but never got,
+    // e.g. because it was interrupted: pulled revisions become full copies as soon as
+    // each batch arrives, so the next sync just resumes from there; other shallow copies,
+    // like the ones added by background fetching, are only pulled when asked explicitly
+    Array<String> unpulledRevisions;
+    for (const auto &revisionId : this->vcs->getPendingPulls())
+    {
+        const auto localRevision = localRevisions.find(revisionId);
+        if (localRevision != localRevisions.end() &&
+            localRevision->second->isShallowCopy() &&
+            remoteRevisions.contains(revisionId))
+        {
+            unpulledRevisions.add(revisionId);
+        }
+    }
+
     // everything is up to date
-    if (newLocalRevisions.isEmpty() && newRemoteRevisions.isEmpty())
+    if (newLocalRevisions.isEmpty() && newRemoteRevisions.isEmpty() &&
+        (this->fetchOnly || unpulledRevisions.isEmpty()))
     {
         callbackOnMessageThread(RevisionsSyncThread, onSyncDone, true);
         return;
@@ -166,6 +184,9 @@ void RevisionsSyncThread::run()
         return;
     }
 
+    BackendRevisionsTransport transport(this->projectId);
+    this->errors.clearQuick();
+
     Array<String> remoteRevisionsToPull;
     if (!this->idsToPull.isEmpty())
     {
@@ -181,43 +202,61 @@ void RevisionsSyncThread::run()
         {
             remoteRevisionsToPull.addIfNotAlreadyThere(dto.getId());
         }
+
+        for (const auto &revisionId : unpulledRevisions)
+        {
+            remoteRevisionsToPull.addIfNotAlreadyThere(revisionId);
+        }
     }
 
-    // if anything is needed to pull, fetch all data for each, then update and callback
-    for (const auto &revisionId : remoteRevisionsToPull)
+    // remember what is being pulled, each pulled revision is removed
+    // from that list in updateShallowRevisionData(), so whatever is left
+    // after a failure will be resumed by the next sync
+    Array<String> pendingPulls(remoteRevisionsToPull);
+    for (const auto &revisionId : unpulledRevisions)
     {
-        const String revisionRoute(ApiRoutes::projectRevision
-            .replace(":projectId", this->projectId)
-            .replace(":revisionId", revisionId));
+        pendingPulls.addIfNotAlreadyThere(revisionId);
+    }
+
+    this->vcs->setPendingPulls(pendingPulls);
 
-        const BackendRequest revisionRequest(revisionRoute);
-        this->response = revisionRequest.get();
-        if (!this->response.is2xx())
+    // if anything is needed to pull, fetch all data in batches, then update and callback
+    const bool pulled = RevisionsSyncHelpers::pullRevisions(transport, remoteRevisionsToPull,
+        [this](const RevisionDto &fullRevision)
         {
-            DBG("Failed to fetch revision data: " + this->response.getErrors().getFirst());
-            callbackOnMessageThread(RevisionsSyncThread, onSyncFailed, self->response.getErrors());
-            return;
-        }
+            this->vcs->updateShallowRevisionData(fullRevision.getId(),
+                RevisionsSyncHelpers::getRevisionData(fullRevision));
+        }, this->errors);
 
-        const RevisionDto fullRevision(this->response.getBody());
-        const auto revision = this->vcs->updateShallowRevisionData(fullRevision.getId(), fullRevision.getData());
+    if (!pulled)
+    {
+        callbackOnMessageThread(RevisionsSyncThread, onSyncFailed, self->errors);
+        return;
     }
 
-    // if anything is needed to push,
-    // build tree(s) from newLocalRevisions list
+    // if anything is needed to push, build tree(s) from newLocalRevisions list,
+    // and push them starting from the roots, so that each pushed revision
+    // already has a valid remote parent; the pushed ones are marked as synced
+    // after each batch, so if this fails, the next sync will only push the rest
     const auto newLocalTrees = RevisionsSyncHelpers::constructNewLocalTrees(newLocalRevisions);
+    const auto revisionsToPush = RevisionsSyncHelpers::flattenTrees(newLocalTrees, this->idsToPush);
 
-    // push them recursively, starting from the root, so that
-    // each pushed revision already has a valid remote parent
-    for (auto *subtree : newLocalTrees)
+    const bool pushed = RevisionsSyncHelpers::pushRevisions(transport, revisionsToPush,
+        [this](VCS::Revision::Ptr revision)
+        {
+            // notify vcs that revision is available remotely
+            this->vcs->updateLocalSyncCache(revision);
+        }, this->errors);
+
+    if (!pushed)
     {
-        this->pushSubtreeRecursively(subtree);
+        callbackOnMessageThread(RevisionsSyncThread, onSyncFailed, self->errors);
+        return;
     }
 
     // finally, update project head ref
     const BackendRequest createProjectRequest(projectRoute);
     SerializedData payload(ApiKeys::Projects::project);
-    // head reference will be put later when all revisions are pushed
     payload.setProperty(ApiKeys::Projects::title, this->projectName);
     payload.setProperty(ApiKeys::Projects::head, this->vcs->getHead().getHeadingRevision()->getUuid());
     this->response = createProjectRequest.put(payload);
@@ -230,42 +269,3 @@ void RevisionsSyncThread::run()
 
     callbackOnMessageThread(RevisionsSyncThread, onSyncDone, false);
 }
-
-void RevisionsSyncThread::pushSubtreeRecursively(VCS::Revision::Ptr root)
-{
-    // todo debug and fix `push branch` for non-existing remotely project
-    if (this->idsToPush.isEmpty() ||
-        this->idsToPush.contains(root->getUuid()))
-    {
-        const String revisionRoute(ApiRoutes::projectRevision
-            .replace(":projectId", this->projectId)
-            .replace(":revisionId", root->getUuid()));
-
-        SerializedData payload(ApiKeys::Revisions::revision);
-        payload.setProperty(ApiKeys::Revisions::message, root->getMessage());
-        payload.setProperty(ApiKeys::Revisions::timestamp, String(root->getTimeStamp()));
-        payload.setProperty(ApiKeys::Revisions::parentId,
-            (root->getParent() ? var(root->getParent()->getUuid()) : var()));
-
-        SerializedData data(ApiKeys::Revisions::data);
-        data.appendChild(root->serializeDeltas());
-        payload.appendChild(data);
-
-        const BackendRequest revisionRequest(revisionRoute);
-        this->response = revisionRequest.put(payload);
-        if (!this->response.is2xx())
-        {
-            DBG("Failed to put revision data: " + this->response.getErrors().getFirst());
-            callbackOnMessageThread(RevisionsSyncThread, onSyncFailed, self->response.getErrors());
-            return;
-        }
-
-        // notify vcs that revision is available remotely
-        this->vcs->updateLocalSyncCache(root);
-    }
-
-    for (auto *child : root->getChildren())
-    {
-        this->pushSubtreeRecursively(child);
-    }
-}
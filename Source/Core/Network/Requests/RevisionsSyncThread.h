@@ -43,7 +43,6 @@ public:
 private:
     
     void run() override;
-    void pushSubtreeRecursively(VCS::Revision::Ptr subtree);
     
     bool fetchOnly;
     String projectId;
@@ -57,5 +56,8 @@ private:
 
     BackendRequest::Response response;
 
+    // collected from the batch transfers, if any fails
+    Array<String> errors;
+
     friend class BackendService;
 };
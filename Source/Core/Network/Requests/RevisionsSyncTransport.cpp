@@ -0,0 +1,160 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "RevisionsSyncTransport.h"
+#include "RevisionsSyncHelpers.h"
+#include "SerializationKeys.h"
+#include "Network.h"
+
+namespace ApiKeys = Serialization::Api::V1;
+namespace ApiRoutes = Routes::Api;
+
+BackendRevisionsTransport::BackendRevisionsTransport(const String &projectId) :
+    projectId(projectId) {}
+
+bool BackendRevisionsTransport::supportsBatches() const
+{
+    return this->batchRoutesAvailable;
+}
+
+bool BackendRevisionsTransport::isBatchRouteMissing(const BackendRequest::Response &response)
+{
+    if (response.is(404) || response.is(405))
+    {
+        DBG("Batch revisions requests are not supported, falling back to single requests");
+        this->batchRoutesAvailable = false;
+        return true;
+    }
+
+    return false;
+}
+
+bool BackendRevisionsTransport::pushRevisions(const Array<SerializedData> &payloads, Array<String> &errors)
+{
+    if (this->batchRoutesAvailable && payloads.size() > 1)
+    {
+        SerializedData batch(ApiKeys::Revisions::revisions);
+        for (const auto &payload : payloads)
+        {
+            batch.appendChild(payload);
+        }
+
+        const BackendRequest request(ApiRoutes::projectRevisions.replace(":projectId", this->projectId));
+        const auto response = request.post(batch);
+        if (response.is2xx())
+        {
+            return true;
+        }
+
+        if (!this->isBatchRouteMissing(response))
+        {
+            DBG("Failed to push revisions batch: " + response.getErrors().getFirst());
+            errors.addArray(response.getErrors());
+            return false;
+        }
+    }
+
+    for (const auto &payload : payloads)
+    {
+        // the payloads might have been packed for the batch request which
+        // turned out to be unsupported, single requests expect them unpacked
+        if (!this->pushRevision(RevisionsSyncHelpers::unpackRevisionPayload(payload), errors))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BackendRevisionsTransport::pushRevision(const SerializedData &payload, Array<String> &errors)
+{
+    const String revisionRoute(ApiRoutes::projectRevision
+        .replace(":projectId", this->projectId)
+        .replace(":revisionId", payload.getProperty(ApiKeys::Revisions::id).toString()));
+
+    const BackendRequest request(revisionRoute);
+    const auto response = request.put(payload);
+    if (!response.is2xx())
+    {
+        DBG("Failed to put revision data: " + response.getErrors().getFirst());
+        errors.addArray(response.getErrors());
+        return false;
+    }
+
+    return true;
+}
+
+bool BackendRevisionsTransport::fetchRevisions(const Array<String> &ids,
+    Array<RevisionDto> &result, Array<String> &errors)
+{
+    if (this->batchRoutesAvailable && ids.size() > 1)
+    {
+        const String revisionsRoute(ApiRoutes::projectRevisions.replace(":projectId", this->projectId) +
+            "?" + ApiKeys::Revisions::ids.toString() + "=" + StringArray(ids).joinIntoString(","));
+
+        const BackendRequest request(revisionsRoute);
+        const auto response = request.get();
+        if (response.is2xx())
+        {
+            forEachChildWithType(response.getBody(), child, ApiKeys::Revisions::revisions)
+            {
+                result.add({ child });
+            }
+
+            return true;
+        }
+
+        if (!this->isBatchRouteMissing(response))
+        {
+            DBG("Failed to fetch revisions batch: " + response.getErrors().getFirst());
+            errors.addArray(response.getErrors());
+            return false;
+        }
+    }
+
+    for (const auto &id : ids)
+    {
+        if (!this->fetchRevision(id, result, errors))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BackendRevisionsTransport::fetchRevision(const String &id,
+    Array<RevisionDto> &result, Array<String> &errors)
+{
+    const String revisionRoute(ApiRoutes::projectRevision
+        .replace(":projectId", this->projectId)
+        .replace(":revisionId", id));
+
+    const BackendRequest request(revisionRoute);
+    const auto response = request.get();
+    if (!response.is2xx())
+    {
+        DBG("Failed to fetch revision data: " + response.getErrors().getFirst());
+        errors.addArray(response.getErrors());
+        return false;
+    }
+
+    result.add({ response.getBody() });
+    return true;
+}
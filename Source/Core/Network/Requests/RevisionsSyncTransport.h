@@ -0,0 +1,73 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "BackendRequest.h"
+#include "RevisionDto.h"
+
+// Abstracts out the way revisions are transferred, so that
+// the batching logic in RevisionsSyncHelpers can be tested
+// against a local stand-in instead of the real backend
+
+class RevisionsSyncTransport
+{
+public:
+
+    virtual ~RevisionsSyncTransport() = default;
+
+    // payloads are Revisions::revision nodes, parents come first;
+    // returns false and fills in the errors if the batch was rejected
+    virtual bool pushRevisions(const Array<SerializedData> &payloads, Array<String> &errors) = 0;
+
+    // the result may come incomplete, e.g. if the batch response has been
+    // truncated by the backend, so the callers should check it's got all the ids
+    virtual bool fetchRevisions(const Array<String> &ids,
+        Array<RevisionDto> &result, Array<String> &errors) = 0;
+
+    // if false, payloads are sent uncompressed, one per request
+    virtual bool supportsBatches() const = 0;
+};
+
+class BackendRevisionsTransport final : public RevisionsSyncTransport
+{
+public:
+
+    explicit BackendRevisionsTransport(const String &projectId);
+
+    bool pushRevisions(const Array<SerializedData> &payloads, Array<String> &errors) override;
+    bool fetchRevisions(const Array<String> &ids,
+        Array<RevisionDto> &result, Array<String> &errors) override;
+
+    bool supportsBatches() const override;
+
+private:
+
+    bool pushRevision(const SerializedData &payload, Array<String> &errors);
+    bool fetchRevision(const String &id, Array<RevisionDto> &result, Array<String> &errors);
+
+    // older backends only have routes for single revisions;
+    // when it turns out batch routes are missing, this is set to false
+    // and all the further transfers fall back to one revision per request
+    bool batchRoutesAvailable = true;
+
+    bool isBatchRouteMissing(const BackendRequest::Response &response);
+
+    const String projectId;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackendRevisionsTransport)
+};
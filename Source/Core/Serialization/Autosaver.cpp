@@ -20,6 +20,7 @@
 #include "DocumentOwner.h"
 
 Autosaver::Autosaver(DocumentOwner &targetDocumentOwner, int waitDelayMs) :
+    Thread("Autosaver"),
     documentOwner(targetDocumentOwner),
     delay(waitDelayMs)
 {
@@ -29,6 +30,20 @@ Autosaver::Autosaver(DocumentOwner &targetDocumentOwner, int waitDelayMs) :
 Autosaver::~Autosaver()
 {
     this->documentOwner.removeChangeListener(this);
+
+    // let the current write finish, and write the pending one, if any,
+    // otherwise the document would think these changes are saved;
+    // the thread is never killed, since that could happen mid-write:
+    this->signalThreadShouldExit();
+    this->notify();
+    this->stopThread(-1);
+
+    Document::SaveSnapshot snapshot;
+    if (this->takePendingSnapshot(snapshot))
+    {
+        auto *document = this->documentOwner.getDocument();
+        document->onSaveSnapshotWritten(snapshot, document->writeSaveSnapshot(snapshot));
+    }
 }
 
 void Autosaver::changeListenerCallback(ChangeBroadcaster *source)
@@ -42,5 +57,75 @@ void Autosaver::changeListenerCallback(ChangeBroadcaster *source)
 void Autosaver::timerCallback()
 {
     this->stopTimer();
-    this->documentOwner.getDocument()->save();
+
+    auto *document = this->documentOwner.getDocument();
+
+    Document::SaveSnapshot snapshot;
+    if (!document->createSaveSnapshot(snapshot))
+    {
+        // either nothing to save, or background saving is not supported
+        document->save();
+        return;
+    }
+
+    {
+        const SpinLock::ScopedLockType lock(this->pendingSnapshotLock);
+        this->pendingSnapshot = snapshot;
+    }
+
+    if (!this->isThreadRunning())
+    {
+        this->startThread(3);
+    }
+
+    this->notify();
+}
+
+bool Autosaver::takePendingSnapshot(Document::SaveSnapshot &result)
+{
+    const SpinLock::ScopedLockType lock(this->pendingSnapshotLock);
+    if (this->pendingSnapshot.write == nullptr)
+    {
+        return false;
+    }
+
+    result = this->pendingSnapshot;
+    this->pendingSnapshot = {};
+    return true;
+}
+
+void Autosaver::run()
+{
+    while (!this->threadShouldExit())
+    {
+        Document::SaveSnapshot snapshot;
+        while (this->takePendingSnapshot(snapshot))
+        {
+            auto *document = this->documentOwner.getDocument();
+            const bool savedOk = document->writeSaveSnapshot(snapshot);
+
+            // the snapshot holds some parts of the model by reference, e.g. the VCS items,
+            // which might have been dropped from the model in the meantime, so make sure
+            // that the callback will hold the last reference to the snapshot,
+            // and it will be released on the message thread
+            WeakReference<Autosaver> weakThis(this);
+            Function<void()> onWritten([weakThis, snapshot, savedOk]()
+            {
+                if (weakThis != nullptr)
+                {
+                    weakThis->documentOwner.getDocument()->onSaveSnapshotWritten(snapshot, savedOk);
+                }
+            });
+
+            snapshot = {};
+            MessageManager::callAsync(move(onWritten));
+
+            if (this->threadShouldExit())
+            {
+                return;
+            }
+        }
+
+        this->wait(-1);
+    }
 }
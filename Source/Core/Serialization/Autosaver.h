@@ -17,28 +17,40 @@
 
 #pragma once
 
+#include "Document.h"
+
 class DocumentOwner;
 
+// Saves the document a while after it has changed;
+// the snapshot is taken on the message thread, but building the tree,
+// serialization and file writes are all done on the background thread;
+// if more changes come while the previous snapshot is being written,
+// only the most recent snapshot will be written next
+
 class Autosaver final :
     private ChangeListener,
-    private Timer
+    private Timer,
+    private Thread
 {
 public:
 
     explicit Autosaver(DocumentOwner &targetDocumentOwner, int waitDelayMs = 30000);
-
     ~Autosaver() override;
 
 private:
 
     void changeListenerCallback(ChangeBroadcaster *source) override;
-
     void timerCallback() override;
+    void run() override;
 
-    DocumentOwner &documentOwner;
+    bool takePendingSnapshot(Document::SaveSnapshot &result);
 
+    DocumentOwner &documentOwner;
     const int delay;
 
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Autosaver)
+    SpinLock pendingSnapshotLock;
+    Document::SaveSnapshot pendingSnapshot;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE(Autosaver)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Autosaver)
 };
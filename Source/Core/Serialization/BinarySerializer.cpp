@@ -21,19 +21,567 @@
 static const char *kHelioHeaderV2String = "Helio2::";
 static const uint64 kHelioHeaderV2 = ByteOrder::littleEndianInt64(kHelioHeaderV2String);
 
-Result BinarySerializer::saveToFile(File file, const SerializedData &tree) const
+static const char *kHelioHeaderV3String = "Helio3::";
+static const uint64 kHelioHeaderV3 = ByteOrder::littleEndianInt64(kHelioHeaderV3String);
+
+//===----------------------------------------------------------------------===//
+// Sections
+//===----------------------------------------------------------------------===//
+
+// The v3 file layout is:
+//   header, int32 number of sections,
+//   the table of contents: int64 offset, int32 stored size,
+//     int32 uncompressed size, int32 checksum for each section,
+//   then the sections, each one is a gzipped v2 node stream,
+//   or the v2 node stream as is, if compressing it doesn't help
+//   (which is when the stored size equals the uncompressed size),
+// where the nodes moved into separate sections are replaced with the
+// reference nodes having the section index and the node type properties,
+// see SerializedDataReader, which follows them while reading
+
+static constexpr int kSectionsTocEntrySize = 8 + 4 + 4 + 4;
+
+// sections are compressed and decompressed in parallel
+// only if there's enough data to make it worth spawning the threads
+static constexpr size_t kMinBytesForParallelSections = 512 * 1024;
+
+// the same checksum zlib uses
+static uint32 getSectionChecksum(const void *data, size_t numBytes) noexcept
+{
+    static constexpr uint32 modAdler = 65521;
+    static constexpr size_t maxBlockSize = 5552;
+
+    const auto *bytes = static_cast<const uint8 *>(data);
+    uint32 a = 1;
+    uint32 b = 0;
+
+    while (numBytes > 0)
+    {
+        auto blockSize = jmin(numBytes, maxBlockSize);
+        numBytes -= blockSize;
+
+        while (blockSize-- > 0)
+        {
+            a += *bytes++;
+            b += a;
+        }
+
+        a %= modAdler;
+        b %= modAdler;
+    }
+
+    return (b << 16) | a;
+}
+
+// Splits the written nodes into sections: the root node, each of its children,
+// and each tree node at any depth (like tracks) are written into separate streams,
+// and their parents only get the reference nodes in their places
+class SectionsWriter final : public SerializedDataWriter
+{
+public:
+
+    SectionsWriter() = default;
+
+    using SerializedDataWriter::beginNode;
+    void beginNode(const Identifier &type, int numProperties, int numChildren) override
+    {
+        const bool startsSection = this->depth <= 1 ||
+            type == Serialization::Core::treeNode;
+
+        if (startsSection)
+        {
+            if (!this->openSections.isEmpty())
+            {
+                auto &parentWriter = this->openSections.getLast()->writer;
+                parentWriter.beginNode(SerializedDataReader::sectionReference, 2, 0);
+                parentWriter.writeProperty(SerializedDataReader::sectionIndex, this->sections.size());
+                parentWriter.writeProperty(SerializedDataReader::sectionNodeType, type.toString());
+                parentWriter.endNode();
+            }
+
+            this->openSections.add(this->sections.add(new Section(this->depth)));
+        }
+
+        this->openSections.getLast()->writer.beginNode(type, numProperties, numChildren);
+        this->depth++;
+    }
+
+    void writeProperty(const Identifier &name, const var &value) override
+    {
+        this->openSections.getLast()->writer.writeProperty(name, value);
+    }
+
+    void endNode() override
+    {
+        this->depth--;
+
+        auto *section = this->openSections.getLast();
+        section->writer.endNode();
+
+        if (section->depth == this->depth)
+        {
+            this->openSections.removeLast();
+        }
+    }
+
+    struct Section final
+    {
+        explicit Section(int depth) : depth(depth), writer(stream) {}
+
+        const int depth;
+        MemoryOutputStream stream;
+        SerializedDataBinaryWriter writer;
+    };
+
+    OwnedArray<Section> sections;
+
+private:
+
+    Array<Section *> openSections;
+    int depth = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(SectionsWriter)
+};
+
+class SectionCodecJob final : public ThreadPoolJob
+{
+public:
+
+    SectionCodecJob(const void *data, size_t numBytes, bool compress) :
+        ThreadPoolJob("Section Codec Job"),
+        data(data),
+        numBytes(numBytes),
+        compress(compress) {}
+
+    JobStatus runJob() override
+    {
+        if (this->compress)
+        {
+            GZIPCompressorOutputStream compressor(this->result);
+            compressor.write(this->data, this->numBytes);
+            compressor.flush();
+        }
+        else
+        {
+            MemoryInputStream compressedStream(this->data, this->numBytes, false);
+            GZIPDecompressorInputStream decompressor(compressedStream);
+            this->result.writeFromInputStream(decompressor, -1);
+        }
+
+        return jobHasFinished;
+    }
+
+    const void *const data;
+    const size_t numBytes;
+    const bool compress;
+
+    MemoryOutputStream result;
+
+    JUCE_DECLARE_NON_COPYABLE(SectionCodecJob)
+};
+
+static void runSectionJobs(const Array<SectionCodecJob *> &jobs, size_t totalBytes)
+{
+    if (jobs.size() < 2 || totalBytes < kMinBytesForParallelSections)
+    {
+        for (auto *job : jobs)
+        {
+            job->runJob();
+        }
+
+        return;
+    }
+
+    ThreadPool workers(jmin(jobs.size(), jmax(1, SystemStats::getNumCpus())));
+
+    for (auto *job : jobs)
+    {
+        workers.addJob(job, false);
+    }
+
+    for (auto *job : jobs)
+    {
+        workers.waitForJobToFinish(job, -1);
+    }
+}
+
+struct SectionsTocEntry final
+{
+    int64 offset;
+    int compressedSize;
+    int size;
+    uint32 checksum;
+};
+
+static bool readSectionsToc(const char *data, size_t numBytes, Array<SectionsTocEntry> &toc)
+{
+    if (numBytes < sizeof(uint64) + sizeof(int))
+    {
+        return false;
+    }
+
+    MemoryInputStream input(data, numBytes, false);
+    if (static_cast<uint64>(input.readInt64()) != kHelioHeaderV3)
+    {
+        return false;
+    }
+
+    const auto numSections = input.readInt();
+    if (numSections <= 0 ||
+        size_t(numSections) > (numBytes - size_t(input.getPosition())) / kSectionsTocEntrySize)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < numSections; ++i)
+    {
+        SectionsTocEntry entry;
+        entry.offset = input.readInt64();
+        entry.compressedSize = input.readInt();
+        entry.size = input.readInt();
+        entry.checksum = static_cast<uint32>(input.readInt());
+
+        if (entry.offset < 0 || entry.compressedSize < 0 || entry.size < 0 ||
+            uint64(entry.offset) + uint64(entry.compressedSize) > uint64(numBytes))
+        {
+            return false;
+        }
+
+        toc.add(entry);
+    }
+
+    return true;
+}
+
+// Fetches the sections for the readers on demand, so that only the sections
+// being read are decompressed; the sections stored as is are not even copied,
+// the readers work right on top of the file data
+class SectionsSource final : public SerializedDataReader::Sections
+{
+public:
+
+    SectionsSource(const char *fileData, const Array<SectionsTocEntry> &toc) :
+        fileData(fileData),
+        toc(toc)
+    {
+        for (int i = 0; i < toc.size(); ++i)
+        {
+            this->sections.add(nullptr);
+        }
+    }
+
+    bool getSection(int index, const char *&data, size_t &numBytes) override
+    {
+        if (!isPositiveAndBelow(index, this->toc.size()))
+        {
+            return false;
+        }
+
+        const ScopedLock lock(this->sectionsLock);
+
+        if (this->sections.getUnchecked(index) == nullptr)
+        {
+            Array<int> indices;
+            indices.add(index);
+            this->loadSections(indices);
+        }
+
+        const auto *section = this->sections.getUnchecked(index);
+        data = section->data;
+        numBytes = section->numBytes;
+        return section->isValid;
+    }
+
+    // when the whole tree is going to be read anyway,
+    // all sections are decompressed beforehand, in parallel
+    void loadAllSections()
+    {
+        const ScopedLock lock(this->sectionsLock);
+
+        Array<int> indices;
+        for (int i = 0; i < this->sections.size(); ++i)
+        {
+            if (this->sections.getUnchecked(i) == nullptr)
+            {
+                indices.add(i);
+            }
+        }
+
+        this->loadSections(indices);
+    }
+
+private:
+
+    struct Section final
+    {
+        const char *data = nullptr;
+        size_t numBytes = 0;
+        bool isValid = false;
+        UniquePointer<SectionCodecJob> decompressor;
+    };
+
+    void loadSections(const Array<int> &indices)
+    {
+        Array<SectionCodecJob *> jobs;
+        size_t totalBytes = 0;
+
+        for (const auto index : indices)
+        {
+            const auto &entry = this->toc.getReference(index);
+            auto *section = this->sections.set(index, new Section());
+
+            if (entry.compressedSize == entry.size)
+            {
+                section->data = this->fileData + entry.offset;
+                section->numBytes = size_t(entry.size);
+            }
+            else
+            {
+                section->decompressor = make<SectionCodecJob>(this->fileData + entry.offset,
+                    size_t(entry.compressedSize), false);
+
+                jobs.add(section->decompressor.get());
+                totalBytes += size_t(entry.size);
+            }
+        }
+
+        runSectionJobs(jobs, totalBytes);
+
+        for (const auto index : indices)
+        {
+            const auto &entry = this->toc.getReference(index);
+            auto *section = this->sections.getUnchecked(index);
+
+            if (section->decompressor != nullptr)
+            {
+                const auto &result = section->decompressor->result;
+                section->data = static_cast<const char *>(result.getData());
+                section->numBytes = result.getDataSize();
+            }
+
+            section->isValid = section->numBytes == size_t(entry.size) &&
+                getSectionChecksum(section->data, section->numBytes) == entry.checksum;
+
+            if (!section->isValid)
+            {
+                DBG("Section checksum mismatch: " + String(index));
+            }
+        }
+    }
+
+    const char *const fileData;
+    const Array<SectionsTocEntry> toc;
+
+    OwnedArray<Section> sections;
+    CriticalSection sectionsLock;
+
+    JUCE_DECLARE_NON_COPYABLE(SectionsSource)
+};
+
+static SerializedData loadSectionsTree(const char *data, size_t numBytes)
+{
+    Array<SectionsTocEntry> toc;
+    if (!readSectionsToc(data, numBytes, toc))
+    {
+        return {};
+    }
+
+    SectionsSource sections(data, toc);
+    sections.loadAllSections();
+
+    const char *rootData = nullptr;
+    size_t rootSize = 0;
+    if (!sections.getSection(0, rootData, rootSize))
+    {
+        return {};
+    }
+
+    SerializedDataReader reader(rootData, rootSize, &sections);
+    return reader.readTree();
+}
+
+Result BinarySerializer::savePlain(const File &file, const WriteFunction &write) const
+{
+    FileOutputStream fileStream(file);
+    if (!fileStream.openedOk())
+    {
+        return Result::fail("Failed to save");
+    }
+
+    fileStream.setPosition(0);
+    fileStream.truncate();
+    fileStream.writeInt64(kHelioHeaderV2);
+
+    SerializedDataBinaryWriter writer(fileStream);
+    write(writer);
+
+    // make sure it's all on disk before the temporary file replaces the target
+    fileStream.flush();
+    return fileStream.getStatus();
+}
+
+Result BinarySerializer::saveSections(const File &file, const WriteFunction &write) const
 {
+    SectionsWriter writer;
+    write(writer);
+
+    const ScopedLock lock(this->lastSavedSectionsLock);
+
+    // only the sections that have changed since the last save are compressed,
+    // all others are taken as is
+    OwnedArray<CompressedSection> sections;
+    OwnedArray<SectionCodecJob> jobs;
+    Array<int> jobSectionIndices;
+    size_t totalBytes = 0;
+
+    for (auto *writtenSection : writer.sections)
+    {
+        auto *section = sections.add(new CompressedSection());
+        section->data = writtenSection->stream.getMemoryBlock();
+        section->checksum = getSectionChecksum(section->data.getData(), section->data.getSize());
+
+        const auto found = this->lastSavedSectionsByChecksum.find(section->checksum);
+        if (found != this->lastSavedSectionsByChecksum.end())
+        {
+            const auto *lastSaved = this->lastSavedSections.getUnchecked(found->second);
+            if (lastSaved->data == section->data)
+            {
+                section->compressed = lastSaved->compressed;
+                continue;
+            }
+        }
+
+        jobs.add(new SectionCodecJob(section->data.getData(), section->data.getSize(), true));
+        jobSectionIndices.add(sections.size() - 1);
+        totalBytes += section->data.getSize();
+    }
+
+    runSectionJobs(Array<SectionCodecJob *>(jobs.begin(), jobs.size()), totalBytes);
+
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        auto *section = sections.getUnchecked(jobSectionIndices.getUnchecked(i));
+        const auto &compressed = jobs.getUnchecked(i)->result;
+
+        // small sections, like the ones with a few properties, often grow
+        // when compressed, so they are stored as is, and read without copying
+        section->compressed = compressed.getDataSize() < section->data.getSize() ?
+            compressed.getMemoryBlock() : section->data;
+    }
+
     FileOutputStream fileStream(file);
-    if (fileStream.openedOk())
+    if (!fileStream.openedOk())
+    {
+        return Result::fail("Failed to save");
+    }
+
+    fileStream.setPosition(0);
+    fileStream.truncate();
+    fileStream.writeInt64(kHelioHeaderV3);
+    fileStream.writeInt(sections.size());
+
+    auto offset = int64(sizeof(uint64) + sizeof(int)) + sections.size() * kSectionsTocEntrySize;
+    for (const auto *section : sections)
     {
-        fileStream.setPosition(0);
-        fileStream.truncate();
-        fileStream.writeInt64(kHelioHeaderV2);
-        tree.writeToStream(fileStream);
-        return Result::ok();
+        fileStream.writeInt64(offset);
+        fileStream.writeInt(int(section->compressed.getSize()));
+        fileStream.writeInt(int(section->data.getSize()));
+        fileStream.writeInt(int(section->checksum));
+        offset += int64(section->compressed.getSize());
     }
 
-    return Result::fail("Failed to save");
+    for (const auto *section : sections)
+    {
+        fileStream.write(section->compressed.getData(), section->compressed.getSize());
+    }
+
+    fileStream.flush();
+
+    this->lastSavedSections.swapWith(sections);
+    this->lastSavedSectionsByChecksum.clear();
+    for (int i = 0; i < this->lastSavedSections.size(); ++i)
+    {
+        this->lastSavedSectionsByChecksum[this->lastSavedSections.getUnchecked(i)->checksum] = i;
+    }
+
+    return fileStream.getStatus();
+}
+
+int BinarySerializer::getNumSectionsInFile(const File &file) const
+{
+    MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+    if (mappedFile.getData() != nullptr)
+    {
+        Array<SectionsTocEntry> toc;
+        if (readSectionsToc(static_cast<const char *>(mappedFile.getData()), mappedFile.getSize(), toc))
+        {
+            return toc.size();
+        }
+    }
+
+    return 0;
+}
+
+SerializedData BinarySerializer::loadSectionFromFile(const File &file, int sectionIndex) const
+{
+    MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+    if (mappedFile.getData() == nullptr)
+    {
+        return {};
+    }
+
+    const auto *data = static_cast<const char *>(mappedFile.getData());
+
+    Array<SectionsTocEntry> toc;
+    if (!readSectionsToc(data, mappedFile.getSize(), toc) ||
+        !isPositiveAndBelow(sectionIndex, toc.size()))
+    {
+        return {};
+    }
+
+    // the section is read as is, with the references to other sections in place
+    SectionsSource sections(data, toc);
+
+    const char *sectionData = nullptr;
+    size_t sectionSize = 0;
+    if (!sections.getSection(sectionIndex, sectionData, sectionSize))
+    {
+        return {};
+    }
+
+    return SerializedData::readFromData(sectionData, sectionSize);
+}
+
+int BinarySerializer::getSectionReference(const SerializedData &node)
+{
+    if (node.hasType(SerializedDataReader::sectionReference))
+    {
+        return node.getProperty(SerializedDataReader::sectionIndex, -1);
+    }
+
+    return -1;
+}
+
+//===----------------------------------------------------------------------===//
+// Serializer
+//===----------------------------------------------------------------------===//
+
+Result BinarySerializer::saveToFile(File file, const SerializedData &tree) const
+{
+    return this->streamToFile(file, [&tree](SerializedDataWriter &writer)
+    {
+        writer.writeTree(tree);
+    });
+}
+
+Result BinarySerializer::streamToFile(File file, const WriteFunction &write) const
+{
+    if (this->format == Format::Sectioned)
+    {
+        return this->saveSections(file, write);
+    }
+
+    return this->savePlain(file, write);
 }
 
 SerializedData BinarySerializer::loadFromFile(const File &file) const
@@ -43,14 +591,36 @@ SerializedData BinarySerializer::loadFromFile(const File &file) const
     // ValueTree::readFromStream still calls getTotalLength() quite often, which
     // ends up calling File::getSize(), which, in turn, consumes a lot time.
 
-    // so instead we'll just read the whole file into memory and deserialize from it;
-    // somewhat ugly, but works, and saved files should never be really large anyway.
+    // so instead we'll map the file into memory and deserialize from it,
+    // or, if mapping fails, just read the whole file into memory
+    MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+    if (mappedFile.getData() != nullptr && mappedFile.getSize() > sizeof(uint64))
+    {
+        const auto *data = static_cast<const char *>(mappedFile.getData());
+        const auto magicNumber = ByteOrder::littleEndianInt64(data);
+        if (magicNumber == kHelioHeaderV3)
+        {
+            return loadSectionsTree(data, mappedFile.getSize());
+        }
+        else if (magicNumber == kHelioHeaderV2)
+        {
+            return SerializedData::readFromData(data + sizeof(uint64),
+                mappedFile.getSize() - sizeof(uint64));
+        }
+
+        return {};
+    }
+
     MemoryBlock mb;
     if (file.loadFileAsData(mb))
     {
         MemoryInputStream inputStream(mb, false);
         const auto magicNumber = static_cast<uint64>(inputStream.readInt64());
-        if (magicNumber == kHelioHeaderV2)
+        if (magicNumber == kHelioHeaderV3)
+        {
+            return loadSectionsTree(static_cast<const char *>(mb.getData()), mb.getSize());
+        }
+        else if (magicNumber == kHelioHeaderV2)
         {
             return SerializedData::readFromStream(inputStream);
         }
@@ -59,6 +629,53 @@ SerializedData BinarySerializer::loadFromFile(const File &file) const
     return {};
 }
 
+Result BinarySerializer::streamFromFile(const File &file, const ReadFunction &read) const
+{
+    // no intermediate copies or trees here: the reader works right on top
+    // of the mapped file, and the OS loads its pages as they are accessed
+    MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+    if (mappedFile.getData() != nullptr && mappedFile.getSize() > sizeof(uint64))
+    {
+        const auto *data = static_cast<const char *>(mappedFile.getData());
+        const auto magicNumber = ByteOrder::littleEndianInt64(data);
+        if (magicNumber == kHelioHeaderV3)
+        {
+            // the sections are decompressed as the reader gets to them,
+            // and the ones stored uncompressed are read from the mapped file
+            Array<SectionsTocEntry> toc;
+            if (!readSectionsToc(data, mappedFile.getSize(), toc))
+            {
+                return Result::fail("Corrupted file");
+            }
+
+            SectionsSource sections(data, toc);
+
+            const char *rootData = nullptr;
+            size_t rootSize = 0;
+            if (!sections.getSection(0, rootData, rootSize))
+            {
+                return Result::fail("Corrupted file");
+            }
+
+            SerializedDataReader reader(rootData, rootSize, &sections);
+            read(reader);
+            return Result::ok();
+        }
+        else if (magicNumber == kHelioHeaderV2)
+        {
+            SerializedDataReader reader(data + sizeof(uint64),
+                mappedFile.getSize() - sizeof(uint64));
+            read(reader);
+            return Result::ok();
+        }
+
+        return Result::fail("Unknown file format");
+    }
+
+    // the caller falls back to loadFromFile(), which can read without mapping
+    return Result::fail("Failed to map the file");
+}
+
 Result BinarySerializer::saveToString(String &string, const SerializedData &tree) const
 {
     MemoryOutputStream memStream;
@@ -86,5 +703,110 @@ bool BinarySerializer::supportsFileWithExtension(const String &extension) const
 
 bool BinarySerializer::supportsFileWithHeader(const String &header) const
 {
-    return header.startsWith(kHelioHeaderV2String);
+    return header.startsWith(kHelioHeaderV2String) ||
+        header.startsWith(kHelioHeaderV3String);
 }
+
+#if JUCE_UNIT_TESTS
+
+class BinarySerializerTests final : public UnitTest
+{
+public:
+    BinarySerializerTests() : UnitTest("Binary serializer tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        SerializedData root("project");
+        root.setProperty("name", "test");
+
+        SerializedData settings("settings");
+        settings.setProperty("value", 1);
+        root.appendChild(settings);
+
+        SerializedData group(Serialization::Core::treeNode);
+        group.setProperty("name", "group");
+        root.appendChild(group);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            SerializedData track(Serialization::Core::treeNode);
+            track.setProperty("name", "track " + String(i));
+            for (int j = 0; j < 100; ++j)
+            {
+                SerializedData event("event");
+                event.setProperty("timestamp", j);
+                track.appendChild(event);
+            }
+
+            group.appendChild(track);
+        }
+
+        const TemporaryFile tempFile;
+
+        beginTest("Saving in the plain format by default");
+
+        BinarySerializer plainSerializer;
+        expect(plainSerializer.saveToFile(tempFile.getFile(), root).wasOk());
+        expect(plainSerializer.loadFromFile(tempFile.getFile()).isEquivalentTo(root));
+        expectEquals(plainSerializer.getNumSectionsInFile(tempFile.getFile()), 0);
+
+        BinarySerializer serializer(BinarySerializer::Format::Sectioned);
+
+        beginTest("Saving and loading sections");
+
+        expect(serializer.saveToFile(tempFile.getFile(), root).wasOk());
+        expect(serializer.loadFromFile(tempFile.getFile()).isEquivalentTo(root));
+
+        // the root, settings, the group and 3 tracks
+        expectEquals(serializer.getNumSectionsInFile(tempFile.getFile()), 6);
+
+        const auto rootSection = serializer.loadSectionFromFile(tempFile.getFile(), 0);
+        expect(rootSection.hasType("project"));
+        expectEquals(rootSection.getNumChildren(), 2);
+        expectEquals(BinarySerializer::getSectionReference(rootSection.getChild(1)), 2);
+
+        const auto groupSection = serializer.loadSectionFromFile(tempFile.getFile(), 2);
+        expectEquals(groupSection.getNumChildren(), 3);
+        expectEquals(BinarySerializer::getSectionReference(groupSection.getChild(2)), 5);
+
+        beginTest("Reusing unchanged sections");
+
+        track(root, 1).appendChild(SerializedData("event"));
+        expect(serializer.saveToFile(tempFile.getFile(), root).wasOk());
+        expect(serializer.loadFromFile(tempFile.getFile()).isEquivalentTo(root));
+
+        bool streamed = false;
+        expect(serializer.streamFromFile(tempFile.getFile(), [&](SerializedDataReader &reader)
+        {
+            streamed = reader.readTree().isEquivalentTo(root);
+        }).wasOk());
+        expect(streamed);
+
+        beginTest("Streaming sections on demand");
+
+        expect(serializer.streamFromFile(tempFile.getFile(), [&](SerializedDataReader &reader)
+        {
+            expect(reader.readNodeHeader().hasType("project"));
+            expectEquals(reader.readNumChildren(), 2);
+
+            expect(reader.isNodeOfType("settings"));
+            reader.skipTree();
+
+            expect(reader.isNodeOfType(Serialization::Core::treeNode));
+            expect(reader.peekProperty("name").toString() == "group");
+            expect(reader.readTree().isEquivalentTo(root.getChild(1)));
+            expect(reader.isExhausted());
+        }).wasOk());
+    }
+
+private:
+
+    static SerializedData track(const SerializedData &root, int index)
+    {
+        return root.getChild(1).getChild(index);
+    }
+};
+
+static BinarySerializerTests binarySerializerTests;
+
+#endif
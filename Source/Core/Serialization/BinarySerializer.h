@@ -23,8 +23,19 @@ class BinarySerializer final : public Serializer
 {
 public:
 
+    enum class Format
+    {
+        Plain,      // v2, readable by the older versions, used by default
+        Sectioned   // v3, see below
+    };
+
+    BinarySerializer() = default;
+    explicit BinarySerializer(Format format) noexcept : format(format) {}
+
     Result saveToFile(File file, const SerializedData &tree) const override;
+    Result streamToFile(File file, const WriteFunction &write) const override;
     SerializedData loadFromFile(const File &file) const override;
+    Result streamFromFile(const File &file, const ReadFunction &read) const override;
 
     Result saveToString(String &string, const SerializedData &tree) const override;
     SerializedData loadFromString(const String &string) const override;
@@ -32,4 +43,39 @@ public:
     bool supportsFileWithExtension(const String &extension) const override;
     bool supportsFileWithHeader(const String &header) const override;
 
+    //===------------------------------------------------------------------===//
+    // Sections
+    //===------------------------------------------------------------------===//
+
+    // In the sectioned format (v3), the root node, each of its children
+    // and each tree node at any depth (like tracks) are compressed
+    // separately, with their parents only keeping the references to them;
+    // the table of contents allows to load any section alone
+    int getNumSectionsInFile(const File &file) const;
+    SerializedData loadSectionFromFile(const File &file, int sectionIndex) const;
+
+    // returns the referenced section index, or -1 if that's a regular node
+    static int getSectionReference(const SerializedData &node);
+
+private:
+
+    Result savePlain(const File &file, const WriteFunction &write) const;
+    Result saveSections(const File &file, const WriteFunction &write) const;
+
+    const Format format = Format::Plain;
+
+    // the sections of the last save, so that the next one only compresses
+    // the sections that have changed since then; this is why the sectioned
+    // serializer is owned by the document it saves, see ProjectNode
+    struct CompressedSection final
+    {
+        MemoryBlock data;
+        MemoryBlock compressed;
+        uint32 checksum = 0;
+    };
+
+    mutable OwnedArray<CompressedSection> lastSavedSections;
+    mutable FlatHashMap<uint32, int> lastSavedSectionsByChecksum;
+    mutable CriticalSection lastSavedSectionsLock;
+
 };
@@ -58,6 +58,7 @@ Document::~Document()
 void Document::changeListenerCallback(ChangeBroadcaster *source)
 {
     this->hasChanges = true;
+    this->changesVersion++;
 }
 
 File Document::getFile() const
@@ -216,6 +217,61 @@ bool Document::hasUnsavedChanges() const noexcept
     return this->hasChanges;
 }
 
+//===----------------------------------------------------------------------===//
+// Background save
+//===----------------------------------------------------------------------===//
+
+bool Document::createSaveSnapshot(SaveSnapshot &result) const
+{
+    if (!this->hasChanges || this->workingFile.getFullPathName().isEmpty())
+    {
+        return false;
+    }
+
+    result.write = this->owner.onDocumentCreateSnapshot();
+    result.file = this->workingFile;
+    result.version = this->changesVersion;
+    return result.write != nullptr;
+}
+
+bool Document::writeSaveSnapshot(const SaveSnapshot &snapshot)
+{
+    const ScopedLock lock(this->saveLock);
+
+    if (snapshot.version <= this->savedVersion)
+    {
+        // the same or the newer state has already been saved synchronously
+        return true;
+    }
+
+    if (this->owner.onDocumentSaveSnapshot(snapshot.file, snapshot.write))
+    {
+        this->savedVersion = snapshot.version;
+        return true;
+    }
+
+    return false;
+}
+
+void Document::onSaveSnapshotWritten(const SaveSnapshot &snapshot, bool savedOk)
+{
+    if (!savedOk)
+    {
+        DBG("Document background save failed: " + snapshot.file.getFullPathName());
+        return;
+    }
+
+    if (snapshot.file == this->workingFile &&
+        snapshot.version == this->changesVersion)
+    {
+        this->hasChanges = false;
+    }
+
+    auto savedFile = snapshot.file;
+    this->owner.onDocumentDidSave(savedFile);
+    DBG("Document saved in background: " + savedFile.getFullPathName());
+}
+
 //===----------------------------------------------------------------------===//
 // Protected
 //===----------------------------------------------------------------------===//
@@ -259,10 +315,12 @@ bool Document::internalSave(File result)
         return false;
     }
 
+    const ScopedLock lock(this->saveLock);
     const bool savedOk = this->owner.onDocumentSave(result);
 
     if (savedOk)
     {
+        this->savedVersion = this->changesVersion;
         this->workingFile = result;
         this->hasChanges = false;
         this->owner.onDocumentDidSave(result);
@@ -282,6 +340,7 @@ bool Document::internalLoad(File result)
     {
         this->workingFile = result;
         this->hasChanges = false;
+        this->savedVersion = this->changesVersion;
         this->owner.onDocumentDidLoad(result);
         return true;
     }
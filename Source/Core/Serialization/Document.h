@@ -53,6 +53,25 @@ public:
     void updateHash();
     bool hasUnsavedChanges() const noexcept;
 
+    //===------------------------------------------------------------------===//
+    // Background save
+    //===------------------------------------------------------------------===//
+
+    struct SaveSnapshot final
+    {
+        File file;
+        SerializedSnapshot write;
+        int64 version = 0;
+    };
+
+    // the snapshot is created on the message thread, and returns false
+    // if there's nothing to save or if the owner cannot create snapshots;
+    // it can then be written from any thread, and all writes are ordered,
+    // so that the older snapshot never overwrites the newer saved state
+    bool createSaveSnapshot(SaveSnapshot &result) const;
+    bool writeSaveSnapshot(const SaveSnapshot &snapshot);
+    void onSaveSnapshotWritten(const SaveSnapshot &snapshot, bool savedOk);
+
     //===------------------------------------------------------------------===//
     // Load
     //===------------------------------------------------------------------===//
@@ -81,6 +100,12 @@ protected:
     int64 fileHashCode;
     int64 fileSize;
 
+    // incremented on each change of the owner; when the save completes,
+    // the document is only marked as saved if nothing has changed since
+    int64 changesVersion = 0;
+    int64 savedVersion = 0;
+    CriticalSection saveLock;
+
 private:
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Document)
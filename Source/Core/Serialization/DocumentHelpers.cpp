@@ -187,20 +187,15 @@ static const Array<Serializer *> getSerializersForHeader(const String &header)
     return result;
 }
 
-SerializedData DocumentHelpers::load(const File &file)
+static Serializer *findSerializerForFile(const File &file)
 {
-    if (!file.existsAsFile())
-    {
-        return {};
-    }
-
     const String extension(file.getFileExtension());
     const auto onesThatSupportExtension(getSerializersForExtension(extension));
 
     // if exactly one serializer reports to support target file extension, then use that one
     if (onesThatSupportExtension.size() == 1)
     {
-        return onesThatSupportExtension.getFirst()->loadFromFile(file);
+        return onesThatSupportExtension.getFirst();
     }
 
     // if none of more that one of serializers support that extension, try to check file header
@@ -220,13 +215,56 @@ SerializedData DocumentHelpers::load(const File &file)
     const auto onesThatSupportHeader(getSerializersForHeader(header.toUTF8()));
     if (!onesThatSupportHeader.isEmpty())
     {
-        return onesThatSupportHeader.getFirst()->loadFromFile(file);
+        return onesThatSupportHeader.getFirst();
+    }
+
+    return nullptr;
+}
+
+SerializedData DocumentHelpers::load(const File &file)
+{
+    if (!file.existsAsFile())
+    {
+        return {};
+    }
+
+    if (auto *serializer = findSerializerForFile(file))
+    {
+        return serializer->loadFromFile(file);
     }
 
     // Default to binary serialization
     return DocumentHelpers::load<BinarySerializer>(file);
 }
 
+bool DocumentHelpers::load(const File &file, const Function<void(SerializedDataReader &)> &read)
+{
+    if (!file.existsAsFile())
+    {
+        return false;
+    }
+
+    if (auto *serializer = findSerializerForFile(file))
+    {
+        return serializer->streamFromFile(file, read).wasOk();
+    }
+
+    static BinarySerializer serializer;
+    return serializer.streamFromFile(file, read).wasOk();
+}
+
+bool DocumentHelpers::save(const File &file, const Serializer &serializer,
+    const Function<void(SerializedDataWriter &)> &write)
+{
+    TempDocument tempDoc(file);
+    if (serializer.streamToFile(tempDoc.getFile(), write).wasOk())
+    {
+        return tempDoc.overwriteTargetFileWithTemporary();
+    }
+
+    return false;
+}
+
 SerializedData DocumentHelpers::load(const String &string)
 {
     const String header(string.substring(0, 8));
@@ -17,6 +17,8 @@
 
 #pragma once
 
+class Serializer;
+
 class DocumentHelpers final
 {
 public:
@@ -38,6 +40,11 @@ public:
     static SerializedData load(const File &file);
     static SerializedData load(const String &string);
 
+    // Same as above, but lets the given function read the data in place;
+    // returns false without calling the function if the format can't be read
+    // in place (e.g. xml or json), so the caller should load the tree instead
+    static bool load(const File &file, const Function<void(SerializedDataReader &)> &read);
+
     template<typename T>
     static SerializedData load(const File &file)
     {
@@ -72,6 +79,17 @@ public:
         return false;
     }
 
+    template<typename T>
+    static bool save(const File &file, const Function<void(SerializedDataWriter &)> &write)
+    {
+        static T serializer;
+        return save(file, serializer, write);
+    }
+
+    // for the serializers which keep some state between saves of the same document
+    static bool save(const File &file, const Serializer &serializer,
+        const Function<void(SerializedDataWriter &)> &write);
+
     class TempDocument final
     {
     public:
@@ -44,6 +44,13 @@ protected:
     virtual void onDocumentDidLoad(File &file) {}
     virtual bool onDocumentSave(File &file) = 0;
     virtual void onDocumentDidSave(File &file) {}
+    // background saving support: the snapshot is created on the message thread,
+    // and should only copy the data it needs, since it is written on the autosaver
+    // thread, where the tree gets built and encoded; owners returning empty
+    // snapshots are saved synchronously, see Serializable::createSnapshot()
+    virtual SerializedSnapshot onDocumentCreateSnapshot() { return {}; }
+    virtual bool onDocumentSaveSnapshot(const File &file, const SerializedSnapshot &snapshot) { return false; }
+
     virtual void onDocumentImport(File &file) = 0;
     virtual bool onDocumentExport(File &file) = 0;
 
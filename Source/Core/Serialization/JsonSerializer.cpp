@@ -357,6 +357,533 @@ private:
     }
 };
 
+//===----------------------------------------------------------------------===//
+// Fast json parser
+//===----------------------------------------------------------------------===//
+
+// A byte-oriented parser for the same syntax as above, which works right on top
+// of the UTF-8 data, creates the strings and identifiers from the raw byte ranges
+// whenever there are no escape sequences, scans the strings 8 bytes at a time,
+// and parses most of the numbers without CharacterFunctions::readDoubleValue.
+
+// It doesn't report any details on errors: if it fails, the caller
+// falls back to JsonParser, which also handles non-ASCII whitespaces
+// and the numbers it can't parse exactly.
+
+class FastJsonParser final
+{
+public:
+
+    explicit FastJsonParser(const String &text) noexcept :
+        position(text.toRawUTF8()),
+        end(text.toRawUTF8() + text.getNumBytesAsUTF8()) {}
+
+    bool parseObjectOrArray(SerializedData &result)
+    {
+        this->skipCommentsAndWhitespaces();
+
+        if (this->position >= this->end)
+        {
+            result = SerializedData();
+            return true;
+        }
+
+        switch (*this->position++)
+        {
+        case '{':   return this->parseObject(result);
+        case '[':   return this->parseArray(result, result.getType());
+        default:    return false;
+        }
+    }
+
+private:
+
+    const char *position;
+    const char *const end;
+
+    // only used for the strings with escape sequences
+    MemoryOutputStream buffer;
+
+    static bool isWhitespace(char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+    }
+
+    static bool isDigit(char c) noexcept
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool hasZeroByte(uint64 v) noexcept
+    {
+        return ((v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL) != 0;
+    }
+
+    void skipCommentsAndWhitespaces() noexcept
+    {
+        for (;;)
+        {
+            while (this->position < this->end && isWhitespace(*this->position))
+            {
+                ++this->position;
+            }
+
+            if (this->end - this->position < 2 || this->position[0] != '/')
+            {
+                return;
+            }
+
+            if (this->position[1] == '/')
+            {
+                this->position += 2;
+                while (this->position < this->end &&
+                    *this->position != '\n' && *this->position != '\r')
+                {
+                    ++this->position;
+                }
+            }
+            else if (this->position[1] == '*')
+            {
+                this->position += 2;
+                while (this->end - this->position >= 2 &&
+                    (this->position[0] != '*' || this->position[1] != '/'))
+                {
+                    ++this->position;
+                }
+
+                this->position = jmin(this->position + 2, this->end);
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    // returns the first quote or backslash, checking 8 bytes at once
+    // while there's none of them; UTF-8 continuation bytes never match
+    const char *findQuoteOrEscape(char quoteChar) const noexcept
+    {
+        static constexpr uint64 ones = 0x0101010101010101ULL;
+        const uint64 quotes = ones * uint8(quoteChar);
+        const uint64 backslashes = ones * uint8('\\');
+
+        auto *p = this->position;
+        while (this->end - p >= 8)
+        {
+            uint64 word;
+            memcpy(&word, p, 8);
+            if (hasZeroByte(word ^ quotes) || hasZeroByte(word ^ backslashes))
+            {
+                break;
+            }
+
+            p += 8;
+        }
+
+        for (; p < this->end; ++p)
+        {
+            if (*p == quoteChar || *p == '\\')
+            {
+                return p;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool readHexDigits(uint32 &result) noexcept
+    {
+        if (this->end - this->position < 4)
+        {
+            return false;
+        }
+
+        result = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto digitValue = CharacterFunctions::getHexDigitValue(juce_wchar(uint8(*this->position++)));
+            if (digitValue < 0) { return false; }
+            result = (result << 4) + uint32(digitValue);
+        }
+
+        return true;
+    }
+
+    // expects the position right after the opening quote
+    bool parseString(char quoteChar, String &result)
+    {
+        const auto *start = this->position;
+        const auto *found = this->findQuoteOrEscape(quoteChar);
+        if (found == nullptr)
+        {
+            return false;
+        }
+
+        if (*found == quoteChar)
+        {
+            // the most common case: no escapes, no intermediate copies
+            result = String(CharPointer_UTF8(start), CharPointer_UTF8(found));
+            this->position = found + 1;
+            return true;
+        }
+
+        this->buffer.reset();
+
+        for (;;)
+        {
+            found = this->findQuoteOrEscape(quoteChar);
+            if (found == nullptr)
+            {
+                return false;
+            }
+
+            this->buffer.write(this->position, size_t(found - this->position));
+            this->position = found + 1;
+
+            if (*found == quoteChar)
+            {
+                break;
+            }
+
+            if (this->position >= this->end)
+            {
+                return false;
+            }
+
+            const auto c = *this->position++;
+            switch (c)
+            {
+            case 'a':  this->buffer.writeByte('\a'); break;
+            case 'b':  this->buffer.writeByte('\b'); break;
+            case 'f':  this->buffer.writeByte('\f'); break;
+            case 'n':  this->buffer.writeByte('\n'); break;
+            case 'r':  this->buffer.writeByte('\r'); break;
+            case 't':  this->buffer.writeByte('\t'); break;
+
+            case 'u':
+            {
+                uint32 code = 0;
+                if (!this->readHexDigits(code) || code == 0)
+                {
+                    return false;
+                }
+
+                // the formatter writes the characters outside of BMP as surrogate pairs
+                if (code >= 0xd800 && code <= 0xdbff && this->end - this->position >= 6 &&
+                    this->position[0] == '\\' && this->position[1] == 'u')
+                {
+                    const auto *highSurrogateEnd = this->position;
+                    this->position += 2;
+
+                    uint32 lowSurrogate = 0;
+                    if (this->readHexDigits(lowSurrogate) &&
+                        lowSurrogate >= 0xdc00 && lowSurrogate <= 0xdfff)
+                    {
+                        code = 0x10000 + ((code - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+                    }
+                    else
+                    {
+                        this->position = highSurrogateEnd;
+                    }
+                }
+
+                this->buffer.appendUTF8Char(juce_wchar(code));
+                break;
+            }
+
+            // quotes, slashes and all other characters are kept as is
+            default:
+                this->buffer.writeByte(c);
+                break;
+            }
+        }
+
+        result = String::fromUTF8(static_cast<const char *>(this->buffer.getData()),
+            int(this->buffer.getDataSize()));
+
+        return true;
+    }
+
+    bool parseKey(Identifier &result)
+    {
+        const auto *start = this->position;
+        const auto *found = this->findQuoteOrEscape('"');
+        if (found == nullptr || found == start)
+        {
+            return false;
+        }
+
+        if (*found == '"')
+        {
+            result = Identifier(CharPointer_UTF8(start), CharPointer_UTF8(found));
+            this->position = found + 1;
+            return true;
+        }
+
+        String key;
+        if (!this->parseString('"', key) || key.isEmpty())
+        {
+            return false;
+        }
+
+        result = key;
+        return true;
+    }
+
+    bool parseNumber(SerializedData &result, const Identifier &propertyName, bool isNegative)
+    {
+        static const double powersOf10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const auto *start = this->position;
+
+        uint64 mantissa = 0;
+        int numDigits = 0;
+        int numFractionDigits = 0;
+        bool isDouble = false;
+
+        // any 19 digits fit into the mantissa, longer numbers
+        // are either rejected (integers) or read as usual (doubles)
+        static constexpr int maxMantissaDigits = 19;
+
+        while (this->position < this->end && isDigit(*this->position))
+        {
+            mantissa = mantissa * 10 + uint64(*this->position++ - '0');
+            numDigits++;
+        }
+
+        if (this->position < this->end && *this->position == '.')
+        {
+            isDouble = true;
+            this->position++;
+            while (this->position < this->end && isDigit(*this->position))
+            {
+                mantissa = mantissa * 10 + uint64(*this->position++ - '0');
+                numDigits++;
+                numFractionDigits++;
+            }
+        }
+
+        int exponent = 0;
+        if (this->position < this->end && (*this->position == 'e' || *this->position == 'E'))
+        {
+            isDouble = true;
+            this->position++;
+
+            bool isExponentNegative = false;
+            if (this->position < this->end && (*this->position == '-' || *this->position == '+'))
+            {
+                isExponentNegative = (*this->position++ == '-');
+            }
+
+            int numExponentDigits = 0;
+            while (this->position < this->end && isDigit(*this->position))
+            {
+                exponent = exponent * 10 + (*this->position++ - '0');
+                if (++numExponentDigits > 4) { return false; }
+            }
+
+            if (numExponentDigits == 0) { return false; }
+            exponent = isExponentNegative ? -exponent : exponent;
+        }
+
+        if (this->position < this->end && !isWhitespace(*this->position) &&
+            *this->position != ',' && *this->position != '}' && *this->position != ']')
+        {
+            return false;
+        }
+
+        if (!isDouble)
+        {
+            // the magnitude of INT64_MIN is one more than INT64_MAX
+            const auto maxMagnitude = uint64(std::numeric_limits<int64>::max()) + (isNegative ? 1 : 0);
+            if (numDigits > maxMantissaDigits || mantissa > maxMagnitude) { return false; }
+
+            // negated this way, so that INT64_MIN doesn't overflow
+            const auto correctedValue = (isNegative && mantissa != 0) ?
+                -int64(mantissa - 1) - 1 : int64(mantissa);
+
+            if ((mantissa >> 31) != 0)
+            {
+                result.setProperty(propertyName, correctedValue);
+            }
+            else
+            {
+                result.setProperty(propertyName, int(correctedValue));
+            }
+
+            return true;
+        }
+
+        double doubleValue = 0.0;
+        const auto exponent10 = exponent - numFractionDigits;
+        if (numDigits <= maxMantissaDigits && mantissa <= (uint64(1) << 53) &&
+            exponent10 >= -22 && exponent10 <= 22)
+        {
+            // both the mantissa and the power of 10 are exact here,
+            // so a single multiplication or division is correctly rounded
+            doubleValue = exponent10 < 0 ?
+                double(mantissa) / powersOf10[-exponent10] :
+                double(mantissa) * powersOf10[exponent10];
+        }
+        else
+        {
+            auto t = CharPointer_UTF8(start);
+            doubleValue = CharacterFunctions::readDoubleValue(t);
+        }
+
+        result.setProperty(propertyName, isNegative ? -doubleValue : doubleValue);
+        return true;
+    }
+
+    bool matchLiteral(const char *literal, size_t length) noexcept
+    {
+        if (size_t(this->end - this->position) >= length &&
+            memcmp(this->position, literal, length) == 0)
+        {
+            this->position += length;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool parseAny(SerializedData &result, const Identifier &nodeOrProperty)
+    {
+        this->skipCommentsAndWhitespaces();
+
+        if (this->position >= this->end)
+        {
+            return false;
+        }
+
+        switch (*this->position)
+        {
+        case '{':
+        {
+            this->position++;
+            SerializedData child(nodeOrProperty);
+            result.appendChild(child);
+            return this->parseObject(child);
+        }
+
+        case '[':
+            this->position++;
+            return this->parseArray(result, nodeOrProperty);
+
+        case '"':
+        case '\'':
+        {
+            const auto quoteChar = *this->position++;
+            String value;
+            if (!this->parseString(quoteChar, value))
+            {
+                return false;
+            }
+
+            result.setProperty(nodeOrProperty, value);
+            return true;
+        }
+
+        case '-':
+            this->position++;
+            this->skipCommentsAndWhitespaces();
+            if (this->position >= this->end || !isDigit(*this->position))
+            {
+                return false;
+            }
+
+            return this->parseNumber(result, nodeOrProperty, true);
+
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return this->parseNumber(result, nodeOrProperty, false);
+
+        case 't':
+            if (this->matchLiteral("true", 4))
+            {
+                result.setProperty(nodeOrProperty, true);
+                return true;
+            }
+            return false;
+
+        case 'f':
+            if (this->matchLiteral("false", 5))
+            {
+                result.setProperty(nodeOrProperty, false);
+                return true;
+            }
+            return false;
+
+        case 'n':
+            return this->matchLiteral("null", 4);
+
+        default:
+            return false;
+        }
+    }
+
+    bool parseObject(SerializedData &result)
+    {
+        for (;;)
+        {
+            this->skipCommentsAndWhitespaces();
+
+            if (this->position >= this->end) { return false; }
+
+            const auto c = *this->position++;
+            if (c == '}') { return true; }
+            if (c != '"') { return false; }
+
+            Identifier propertyName;
+            if (!this->parseKey(propertyName)) { return false; }
+
+            this->skipCommentsAndWhitespaces();
+            if (this->position >= this->end || *this->position++ != ':') { return false; }
+
+            if (!this->parseAny(result, propertyName)) { return false; }
+
+            this->skipCommentsAndWhitespaces();
+            if (this->position >= this->end) { return false; }
+
+            const auto nextChar = *this->position++;
+            if (nextChar == ',') { continue; }
+            if (nextChar == '}') { return true; }
+            return false;
+        }
+    }
+
+    bool parseArray(SerializedData &result, const Identifier &nodeName)
+    {
+        for (;;)
+        {
+            this->skipCommentsAndWhitespaces();
+
+            if (this->position >= this->end) { return false; }
+            if (*this->position == ']')
+            {
+                this->position++;
+                return true;
+            }
+
+            if (!this->parseAny(result, nodeName)) { return false; }
+
+            this->skipCommentsAndWhitespaces();
+            if (this->position >= this->end) { return false; }
+
+            const auto nextChar = *this->position++;
+            if (nextChar == ',') { continue; }
+            if (nextChar == ']') { return true; }
+            return false;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(FastJsonParser)
+};
+
 //===----------------------------------------------------------------------===//
 // Json formatter
 //===----------------------------------------------------------------------===//
@@ -509,12 +1036,17 @@ struct JsonFormatter final
         }
         else if (v.isInt() || v.isInt64())
         {
-            out << v.toString();
+            writeInteger(out, static_cast<int64>(v));
         }
         else if (v.isDouble())
         {
             out << String(static_cast<double> (v), maximumDecimalPlaces);
         }
+        else if (v.isBinaryData())
+        {
+            // written as a base64 string, it's up to the reader to decode it
+            out << '"' << v.toString() << '"';
+        }
         else
         {
             // Should never hit this point anyway
@@ -528,16 +1060,54 @@ struct JsonFormatter final
         out << "\\u" << String::toHexString((int)value).paddedLeft('0', 4);
     }
 
+    static void writeInteger(OutputStream &out, int64 value)
+    {
+        char buffer[24];
+        auto *const bufferEnd = buffer + numElementsInArray(buffer);
+        auto *start = bufferEnd;
+
+        auto absValue = value < 0 ? uint64(-(value + 1)) + 1 : uint64(value);
+        do
+        {
+            *--start = char('0' + absValue % 10);
+            absValue /= 10;
+        } while (absValue != 0);
+
+        if (value < 0) { *--start = '-'; }
+
+        out.write(start, size_t(bufferEnd - start));
+    }
+
+    // writes the runs of printable ASCII characters as is, all at once,
+    // and only decodes the characters which need to be escaped
     static void writeString(OutputStream &out, String::CharPointerType t)
     {
+        const auto *runStart = t.getAddress();
+        const auto *p = runStart;
+
         for (;;)
         {
-            auto c = t.getAndAdvance();
+            const auto c = uint8(*p);
+            if (c >= 32 && c < 127 && c != '\"' && c != '\\')
+            {
+                ++p;
+                continue;
+            }
 
-            switch (c)
+            if (p != runStart)
             {
-            case 0:  return;
+                out.write(runStart, size_t(p - runStart));
+            }
+
+            if (c == 0) { return; }
+
+            auto charPointer = String::CharPointerType(p);
+            const auto unicodeChar = charPointer.getAndAdvance();
+            p = charPointer.getAddress();
+            runStart = p;
 
+            switch (unicodeChar)
+            {
             case '\"':  out << "\\\""; break;
             case '\\':  out << "\\\\"; break;
             case '\a':  out << "\\a";  break;
@@ -548,27 +1118,20 @@ struct JsonFormatter final
             case '\n':  out << "\\n";  break;
 
             default:
-                if (c >= 32 && c < 127)
+                if (CharPointer_UTF16::getBytesRequiredFor(unicodeChar) > 2)
                 {
-                    out << (char)c;
+                    CharPointer_UTF16::CharType chars[2];
+                    CharPointer_UTF16 utf16(chars);
+                    utf16.write(unicodeChar);
+
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        writeEscapedChar(out, (unsigned short)chars[i]);
+                    }
                 }
                 else
                 {
-                    if (CharPointer_UTF16::getBytesRequiredFor(c) > 2)
-                    {
-                        CharPointer_UTF16::CharType chars[2];
-                        CharPointer_UTF16 utf16(chars);
-                        utf16.write(c);
-
-                        for (int i = 0; i < 2; ++i)
-                        {
-                            writeEscapedChar(out, (unsigned short)chars[i]);
-                        }
-                    }
-                    else
-                    {
-                        writeEscapedChar(out, (unsigned short)c);
-                    }
+                    writeEscapedChar(out, (unsigned short)unicodeChar);
                 }
 
                 break;
@@ -622,6 +1185,19 @@ struct JsonFormatter final
 
 static const Identifier fakeRoot = "root";
 
+static Result parseJsonText(const String &text, SerializedData &root)
+{
+    if (FastJsonParser(text).parseObjectOrArray(root))
+    {
+        return Result::ok();
+    }
+
+    // the fast parser gives up on anything unusual,
+    // so let the original one parse it or report the error:
+    root = SerializedData(fakeRoot);
+    return JsonParser::parseObjectOrArray(text.getCharPointer(), root);
+}
+
 JsonSerializer::JsonSerializer(bool allOnOneLine) noexcept :
     allOnOneLine(allOnOneLine) {}
 
@@ -649,7 +1225,7 @@ SerializedData JsonSerializer::loadFromFile(const File &file) const
 {
     const String text(file.loadFileAsString());
     SerializedData root(fakeRoot);
-    const auto result = JsonParser::parseObjectOrArray(text.getCharPointer(), root);
+    const auto result = parseJsonText(text, root);
     if (result.wasOk())
     {
         return root.getChild(0);
@@ -669,7 +1245,7 @@ Result JsonSerializer::saveToString(String &string, const SerializedData &tree)
 SerializedData JsonSerializer::loadFromString(const String &string) const
 {
     SerializedData root(fakeRoot);
-    const auto result = JsonParser::parseObjectOrArray(string.getCharPointer(), root);
+    const auto result = parseJsonText(string, root);
     if (result.wasOk())
     {
         if (root.getNumChildren() == 1 && root.getNumProperties() == 0)
@@ -697,3 +1273,140 @@ bool JsonSerializer::supportsFileWithHeader(const String &header) const
     // Enough for all our cases:
     return header.startsWithChar('[') || header.startsWithChar('{');
 }
+
+#if JUCE_UNIT_TESTS
+
+static bool parseFast(const String &text, SerializedData &result)
+{
+    result = SerializedData(fakeRoot);
+    return FastJsonParser(text).parseObjectOrArray(result);
+}
+
+static bool parseOriginal(const String &text, SerializedData &result)
+{
+    result = SerializedData(fakeRoot);
+    return JsonParser::parseObjectOrArray(text.getCharPointer(), result).wasOk();
+}
+
+class JsonSerializerTests final : public UnitTest
+{
+public:
+    JsonSerializerTests() : UnitTest("Json serializer tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Fast parser matches the original one");
+
+        const StringArray samples = {
+            "{\"a\": {\"b\": 1, \"c\": -2.5, \"d\": \"x\\ny\\u00e9\\\"\", \"e\": true, \"f\": null, "
+                "\"g\": [{\"h\": 1}, {\"h\": 2}], \"i\": 12345678901, \"j\": -0.125e2, \"k\": 1.5e-30}}",
+            "/* header */ {\"a\": { // comment\n \"b\": 'single', \"c\": [1, 2, 3], }}",
+            "[{\"a\": 1}, {\"b\": \"\"}]",
+            "{\"a\": {\"b\\u0063\": 0.1, \"d\": \"a very long string without any escapes\"}}"
+        };
+
+        for (const auto &sample : samples)
+        {
+            SerializedData fastResult, originalResult;
+            expect(parseFast(sample, fastResult));
+            expect(parseOriginal(sample, originalResult));
+            expect(fastResult.isEquivalentTo(originalResult), sample);
+        }
+
+        SerializedData invalid;
+        expect(!parseFast("{\"a\": ", invalid));
+        expect(!parseFast("{\"a\": {\"b\": 1x}}", invalid));
+        expect(!JsonSerializer().loadFromString("{\"a\": ").isValid());
+
+        beginTest("Formatting and parsing back");
+
+        SerializedData tree("tree");
+        tree.setProperty("unicode", String(CharPointer_UTF8("\xd0\xb9 \xf0\x9f\x8e\xb9 \"\\\t")));
+        tree.setProperty("int", -2147483647);
+        tree.setProperty("int64", int64(-1234567890123LL));
+        tree.setProperty("double", 0.5);
+
+        String text;
+        JsonSerializer serializer;
+        expect(serializer.saveToString(text, tree).wasOk());
+        expect(serializer.loadFromString(text).isEquivalentTo(tree), text);
+
+        beginTest("Parsing int64 limits");
+
+        SerializedData limits("limits");
+        limits.setProperty("max", std::numeric_limits<int64>::max());
+        limits.setProperty("min", std::numeric_limits<int64>::min());
+
+        String limitsText;
+        expect(serializer.saveToString(limitsText, limits).wasOk());
+
+        const auto parsedLimits = serializer.loadFromString(limitsText);
+        expect(parsedLimits.isEquivalentTo(limits), limitsText);
+        expect(int64(parsedLimits.getProperty("max")) == std::numeric_limits<int64>::max());
+        expect(int64(parsedLimits.getProperty("min")) == std::numeric_limits<int64>::min());
+
+        SerializedData outOfRange;
+        expect(!parseFast("{\"a\": {\"b\": 9223372036854775808}}", outOfRange));
+        expect(!parseFast("{\"a\": {\"b\": -9223372036854775809}}", outOfRange));
+        expect(!parseFast("{\"a\": {\"b\": 12345678901234567890}}", outOfRange));
+
+        SerializedData longDouble, longDoubleOriginal;
+        const String longDoubleText = "{\"a\": {\"b\": 0.12345678901234567890123}}";
+        expect(parseFast(longDoubleText, longDouble));
+        expect(parseOriginal(longDoubleText, longDoubleOriginal));
+        expect(longDouble.isEquivalentTo(longDoubleOriginal));
+    }
+};
+
+static JsonSerializerTests jsonSerializerTests;
+
+class JsonSerializerBenchmark final : public UnitTest
+{
+public:
+    JsonSerializerBenchmark() :
+        UnitTest("Json parsing benchmark", UnitTestCategories::helioPerformance) {}
+
+    void runTest() override
+    {
+        beginTest("Parsing performance");
+
+        SerializedData bigTree("track");
+        for (int i = 0; i < 20000; ++i)
+        {
+            SerializedData note("note");
+            note.setProperty("id", "n" + String(i));
+            note.setProperty("key", i % 128);
+            note.setProperty("beat", i * 0.25);
+            note.setProperty("length", 0.125);
+            bigTree.appendChild(note);
+        }
+
+        String bigText;
+        expect(JsonSerializer().saveToString(bigText, bigTree).wasOk());
+
+        SerializedData fastResult, originalResult;
+        const auto originalTime = measure([&]() { parseOriginal(bigText, originalResult); });
+        const auto fastTime = measure([&]() { parseFast(bigText, fastResult); });
+        expect(fastResult.isEquivalentTo(originalResult));
+
+        logMessage("Parsing " + String(bigText.getNumBytesAsUTF8() / 1024) + " KB: " +
+            String(originalTime, 2) + " ms originally, " + String(fastTime, 2) + " ms with the fast parser");
+    }
+
+private:
+
+    static double measure(const Function<void()> &function)
+    {
+        const auto startTime = Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < 5; ++i)
+        {
+            function();
+        }
+
+        return (Time::getMillisecondCounterHiRes() - startTime) / 5.0;
+    }
+};
+
+static JsonSerializerBenchmark jsonSerializerBenchmark;
+
+#endif
@@ -18,6 +18,10 @@
 #pragma once
 
 #include "SerializedData.h"
+#include "SerializedDataWriter.h"
+#include "SerializedDataReader.h"
+
+using SerializedSnapshot = Function<void(SerializedDataWriter &writer)>;
 
 class Serializable
 {
@@ -25,6 +29,34 @@ public:
     
     virtual ~Serializable() = default;
     virtual SerializedData serialize() const = 0;
+
+    // streaming alternative to serialize(), for the objects which
+    // can write themselves without building the whole tree first
+    virtual void serializeTo(SerializedDataWriter &writer) const
+    {
+        writer.writeTree(this->serialize());
+    }
+
+    // captures the current state so that it can be written later on another thread,
+    // while this object keeps changing; the function must not refer to this object;
+    // by default, the tree is just built right away, which is fine for smaller objects,
+    // the bigger ones override this to only copy their data and build nothing here
+    virtual SerializedSnapshot createSnapshot() const
+    {
+        const auto tree(this->serialize());
+        return [tree](SerializedDataWriter &writer)
+        {
+            writer.writeTree(tree);
+        };
+    }
+
     virtual void deserialize(const SerializedData &data) = 0;
+
+    // streaming alternative to deserialize(), reads the node at the reader's position
+    virtual void deserializeFrom(SerializedDataReader &reader)
+    {
+        this->deserialize(reader.readTree());
+    }
+
     virtual void reset() = 0;
 };
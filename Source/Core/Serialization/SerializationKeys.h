@@ -451,6 +451,7 @@ namespace Serialization
         static const Identifier remoteRevision = "revision";
         static const Identifier remoteRevisionId = "id";
         static const Identifier remoteRevisionTimeStamp = "ts";
+        static const Identifier remotePendingPull = "pendingPull";
 
         static const Identifier revision = "revision";
         static const Identifier head = "head";
@@ -476,6 +477,9 @@ namespace Serialization
 
         static const Identifier headStateDelta = "headState";
 
+        // notes and clips deltas data in a columnar binary form
+        static const Identifier packedEvents = "packed";
+
         namespace ProjectInfoDeltas
         {
             static const Identifier projectLicense = "license";
@@ -623,6 +627,9 @@ namespace Serialization
                 static const Identifier timestamp = "timestamp";
                 static const Identifier parentId = "parentId";
                 static const Identifier data = "data";
+                // deltas data, compressed and base64-encoded, used in batch requests
+                static const Identifier packedData = "packedData";
+                static const Identifier ids = "ids";
             }
         } // namespace V1
     } // namespace Api
@@ -666,6 +673,12 @@ namespace Serialization
         static const Identifier groupAfter = "groupAfter";
         static const Identifier instanceBefore = "instanceBefore";
         static const Identifier instanceAfter = "instanceAfter";
+        static const Identifier journalStamp = "journalStamp";
+        static const Identifier noteIds = "noteIds";
+        static const Identifier deltaKey = "deltaKey";
+        static const Identifier deltaBeat = "deltaBeat";
+        static const Identifier deltaLength = "deltaLength";
+        static const Identifier deltaVelocity = "deltaVelocity";
 
         static const Identifier pianoTrackInsertAction = "pianoTrackInsert";
         static const Identifier pianoTrackRemoveAction = "pianoTrackRemove";
@@ -691,6 +704,7 @@ namespace Serialization
         static const Identifier notesGroupInsertAction = "notesInsert";
         static const Identifier notesGroupRemoveAction = "notesRemove";
         static const Identifier notesGroupChangeAction = "notesChange";
+        static const Identifier notesGroupTransformAction = "notesTransform";
         
         static const Identifier annotationEventInsertAction = "annotationInsert";
         static const Identifier annotationEventRemoveAction = "annotationRemove";
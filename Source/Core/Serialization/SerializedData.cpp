@@ -24,6 +24,154 @@ public:
 
     using Ptr = ReferenceCountedObjectPtr<SharedData>;
 
+    // Most of the nodes, like notes or automation events, only have a handful
+    // of properties, so they are kept right inside the node, and only the bigger
+    // nodes move them into a heap array; identifiers are pooled strings,
+    // so the lookup is a linear search comparing pointers
+    class Properties final
+    {
+    public:
+
+        Properties() = default;
+
+        int size() const noexcept
+        {
+            return this->numProperties;
+        }
+
+        Identifier getName(int index) const noexcept
+        {
+            if (isPositiveAndBelow(index, this->numProperties))
+            {
+                return this->getData()[index].name;
+            }
+
+            jassertfalse;
+            return {};
+        }
+
+        const var &getValueAt(int index) const noexcept
+        {
+            jassert(isPositiveAndBelow(index, this->numProperties));
+            return this->getData()[index].value;
+        }
+
+        const var *find(const Identifier &name) const noexcept
+        {
+            const auto *properties = this->getData();
+            for (int i = 0; i < this->numProperties; ++i)
+            {
+                if (properties[i].name == name)
+                {
+                    return &properties[i].value;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void set(const Identifier &name, const var &value)
+        {
+            if (auto *existingValue = const_cast<var *>(this->find(name)))
+            {
+                *existingValue = value;
+                return;
+            }
+
+            if (this->numProperties < numInlineProperties)
+            {
+                this->inlineProperties[this->numProperties] = { name, value };
+            }
+            else
+            {
+                if (this->numProperties == numInlineProperties)
+                {
+                    this->heapProperties.ensureStorageAllocated(numInlineProperties * 2);
+                    for (auto &property : this->inlineProperties)
+                    {
+                        this->heapProperties.add(std::move(property));
+                    }
+                }
+
+                this->heapProperties.add({ name, value });
+            }
+
+            this->numProperties++;
+        }
+
+        void ensureStorageAllocated(int numPropertiesNeeded)
+        {
+            if (numPropertiesNeeded > numInlineProperties)
+            {
+                this->heapProperties.ensureStorageAllocated(numPropertiesNeeded);
+            }
+        }
+
+        bool operator== (const Properties &other) const noexcept
+        {
+            if (this->numProperties != other.numProperties)
+            {
+                return false;
+            }
+
+            const auto *properties = this->getData();
+            for (int i = 0; i < this->numProperties; ++i)
+            {
+                const auto &property = properties[i];
+                const auto *otherValue = (other.getData()[i].name == property.name) ?
+                    &other.getData()[i].value : other.find(property.name);
+
+                if (otherValue == nullptr || *otherValue != property.value)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool operator!= (const Properties &other) const noexcept
+        {
+            return !this->operator== (other);
+        }
+
+        static const var &getNullValue() noexcept
+        {
+            static const var nullValue;
+            return nullValue;
+        }
+
+    private:
+
+        struct Property final
+        {
+            Property() = default;
+            Property(const Identifier &name, const var &value) :
+                name(name), value(value) {}
+
+            Identifier name;
+            var value;
+        };
+
+        const Property *getData() const noexcept
+        {
+            return this->numProperties <= numInlineProperties ?
+                this->inlineProperties : this->heapProperties.begin();
+        }
+
+        Property *getData() noexcept
+        {
+            return this->numProperties <= numInlineProperties ?
+                this->inlineProperties : this->heapProperties.begin();
+        }
+
+        static constexpr int numInlineProperties = 6;
+
+        Property inlineProperties[numInlineProperties];
+        Array<Property> heapProperties;
+        int numProperties = 0;
+    };
+
     explicit SharedData(const Identifier &t) noexcept : type(t) {}
 
     SharedData(const SharedData &other) :
@@ -124,7 +272,20 @@ public:
     XmlElement *createXml() const
     {
         auto *xml = new XmlElement(this->type);
-        this->properties.copyToXmlAttributes(*xml);
+
+        for (int i = 0; i < this->properties.size(); ++i)
+        {
+            const auto &value = this->properties.getValueAt(i);
+            if (auto *binaryData = value.getBinaryData())
+            {
+                xml->setAttribute("base64:" + this->properties.getName(i).toString(),
+                    binaryData->toBase64Encoding());
+            }
+            else
+            {
+                xml->setAttribute(this->properties.getName(i), value.toString());
+            }
+        }
 
         for (auto i = this->children.size(); --i >= 0;)
         {
@@ -168,7 +329,7 @@ public:
     }
 
     const Identifier type;
-    NamedValueSet properties;
+    Properties properties;
     ReferenceCountedArray<SharedData> children;
     SharedData *parent = nullptr;
 
@@ -260,13 +421,23 @@ SerializedData SerializedData::getParent() const noexcept
 const var &SerializedData::getProperty(const Identifier &name) const noexcept
 {
     jassert(this->data != nullptr);
-    return this->data->properties[name];
+    if (auto *value = this->data->properties.find(name))
+    {
+        return *value;
+    }
+
+    return SharedData::Properties::getNullValue();
 }
 
 var SerializedData::getProperty(const Identifier &name, const var &defaultValue) const
 {
     jassert(this->data != nullptr);
-    return this->data->properties.getWithDefault(name, defaultValue);
+    if (auto *value = this->data->properties.find(name))
+    {
+        return *value;
+    }
+
+    return defaultValue;
 }
 
 SerializedData &SerializedData::setProperty(const Identifier &name, const var &newValue)
@@ -279,7 +450,7 @@ SerializedData &SerializedData::setProperty(const Identifier &name, const var &n
 
 bool SerializedData::hasProperty(const Identifier &name) const noexcept
 {
-    return this->data != nullptr && this->data->properties.contains(name);
+    return this->data != nullptr && this->data->properties.find(name) != nullptr;
 }
 
 int SerializedData::getNumProperties() const noexcept
@@ -371,7 +542,25 @@ SerializedData SerializedData::readFromXml(const XmlElement &xml)
     if (!xml.isTextElement())
     {
         SerializedData v(xml.getTagName());
-        v.data->properties.setFromXmlAttributes(xml);
+
+        const auto numAttributes = xml.getNumAttributes();
+        v.data->properties.ensureStorageAllocated(numAttributes);
+
+        for (int i = 0; i < numAttributes; ++i)
+        {
+            const auto &name = xml.getAttributeName(i);
+            if (name.startsWith("base64:"))
+            {
+                MemoryBlock binaryData;
+                if (binaryData.fromBase64Encoding(xml.getAttributeValue(i)))
+                {
+                    v.data->properties.set(name.substring(7), var(binaryData));
+                    continue;
+                }
+            }
+
+            v.data->properties.set(name, var(xml.getAttributeValue(i)));
+        }
 
         forEachXmlChildElement(xml, e)
         {
@@ -423,6 +612,7 @@ SerializedData SerializedData::readFromStream(InputStream &input)
     SerializedData v(type);
 
     const auto numProps = input.readCompressedInt();
+    v.data->properties.ensureStorageAllocated(numProps);
 
     for (int i = 0; i < numProps; ++i)
     {
@@ -462,3 +652,60 @@ SerializedData SerializedData::readFromData(const void *data, size_t numBytes)
     MemoryInputStream in(data, numBytes, false);
     return readFromStream(in);
 }
+
+#if JUCE_UNIT_TESTS
+
+class SerializedDataTests final : public UnitTest
+{
+public:
+    SerializedDataTests() : UnitTest("Serialized data tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Inline and heap properties");
+
+        SerializedData small("small");
+        SerializedData big("big");
+        for (int i = 0; i < 10; ++i)
+        {
+            big.setProperty("p" + String(i), i);
+            if (i < 3)
+            {
+                small.setProperty("p" + String(i), i);
+            }
+        }
+
+        big.setProperty("p2", "updated");
+
+        expectEquals(small.getNumProperties(), 3);
+        expectEquals(big.getNumProperties(), 10);
+        expectEquals(big.getPropertyName(9).toString(), String("p9"));
+        expectEquals(big.getProperty("p2").toString(), String("updated"));
+        expectEquals(int(big.getProperty("p7")), 7);
+        expect(big.getProperty("missing").isVoid());
+        expect(!big.hasProperty("missing"));
+
+        beginTest("Equivalence and copies");
+
+        SerializedData reordered("big");
+        for (int i = 9; i >= 0; --i)
+        {
+            reordered.setProperty("p" + String(i), i == 2 ? var("updated") : var(i));
+        }
+
+        expect(reordered.isEquivalentTo(big));
+        expect(big.createCopy().isEquivalentTo(big));
+        expect(!small.isEquivalentTo(big));
+
+        MemoryOutputStream stream;
+        big.writeToStream(stream);
+        expect(SerializedData::readFromData(stream.getData(), stream.getDataSize()).isEquivalentTo(big));
+
+        const auto xml = big.writeToXml();
+        expectEquals(SerializedData::readFromXml(*xml).getProperty("p9").toString(), String("9"));
+    }
+};
+
+static SerializedDataTests serializedDataTests;
+
+#endif
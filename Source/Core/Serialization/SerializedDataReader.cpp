@@ -0,0 +1,586 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "SerializedDataReader.h"
+
+// the markers of var's binary layout, as written by var::writeToStream
+enum VarMarker
+{
+    varMarker_Int = 1,
+    varMarker_BoolTrue = 2,
+    varMarker_BoolFalse = 3,
+    varMarker_Double = 4,
+    varMarker_String = 5,
+    varMarker_Int64 = 6
+};
+
+static double readLittleEndianDouble(const char *data) noexcept
+{
+    const auto bits = ByteOrder::littleEndianInt64(data);
+    double result;
+    memcpy(&result, &bits, sizeof(double));
+    return result;
+}
+
+const Identifier SerializedDataReader::sectionReference = "Helio3::section";
+const Identifier SerializedDataReader::sectionIndex = "index";
+const Identifier SerializedDataReader::sectionNodeType = "type";
+
+SerializedDataReader::SerializedDataReader(const void *data,
+    size_t numBytes, Sections *sections) noexcept :
+    position(static_cast<const char *>(data)),
+    end(static_cast<const char *>(data) + numBytes),
+    sections(sections) {}
+
+bool SerializedDataReader::isExhausted() const noexcept
+{
+    if (this->position < this->end)
+    {
+        return false;
+    }
+
+    for (const auto &returnPoint : this->returnPoints)
+    {
+        if (returnPoint.position < returnPoint.end)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SerializedDataReader::isNodeOfType(const Identifier &type) const
+{
+    if (this->sections == nullptr ||
+        (this->position < this->end && !this->isAtSectionReference()))
+    {
+        return isRawNodeOfType(this->position, this->end, type);
+    }
+
+    auto reader = *this;
+    reader.leaveFinishedSections();
+
+    if (reader.isAtSectionReference())
+    {
+        // the referenced node type is checked without fetching its section
+        const SerializedDataReader reference(reader.position, size_t(reader.end - reader.position));
+        const auto referencedType = reference.peekProperty(sectionNodeType);
+        if (referencedType.isString())
+        {
+            return referencedType.toString() == type.toString();
+        }
+
+        reader.enterSectionIfReferenced();
+    }
+
+    return isRawNodeOfType(reader.position, reader.end, type);
+}
+
+var SerializedDataReader::peekProperty(const Identifier &name) const
+{
+    auto reader = *this;
+    const auto numProperties = reader.beginNode();
+    for (int i = 0; i < numProperties; ++i)
+    {
+        if (name == reader.readPropertyName())
+        {
+            return reader.readValue();
+        }
+
+        reader.skipValue();
+    }
+
+    return {};
+}
+
+int SerializedDataReader::beginNode()
+{
+    this->enterSectionIfReferenced();
+    this->readCString();
+    return this->readCompressedInt();
+}
+
+StringRef SerializedDataReader::readPropertyName() noexcept
+{
+    return this->readCString();
+}
+
+int SerializedDataReader::readInt()
+{
+    const auto value = this->readRawValue();
+    if (value.numBytes == 0)
+    {
+        return 0;
+    }
+
+    switch (value.data[0])
+    {
+    case varMarker_Int:
+        if (value.numBytes >= 5) { return int(ByteOrder::littleEndianInt(value.data + 1)); }
+        break;
+    case varMarker_Double:
+        if (value.numBytes >= 9) { return int(readLittleEndianDouble(value.data + 1)); }
+        break;
+    case varMarker_BoolTrue: return 1;
+    case varMarker_BoolFalse: return 0;
+    default: break;
+    }
+
+    return int(toVar(value));
+}
+
+float SerializedDataReader::readFloat()
+{
+    const auto value = this->readRawValue();
+    if (value.numBytes == 0)
+    {
+        return 0.f;
+    }
+
+    switch (value.data[0])
+    {
+    case varMarker_Int:
+        if (value.numBytes >= 5) { return float(double(int(ByteOrder::littleEndianInt(value.data + 1)))); }
+        break;
+    case varMarker_Double:
+        if (value.numBytes >= 9) { return float(readLittleEndianDouble(value.data + 1)); }
+        break;
+    default: break;
+    }
+
+    return float(toVar(value));
+}
+
+StringRef SerializedDataReader::readString() noexcept
+{
+    const auto value = this->readRawValue();
+    if (value.numBytes >= 2 && value.data[0] == varMarker_String &&
+        value.data[value.numBytes - 1] == 0)
+    {
+        return value.data + 1;
+    }
+
+    return {};
+}
+
+var SerializedDataReader::readValue()
+{
+    return toVar(this->readRawValue());
+}
+
+void SerializedDataReader::skipValue() noexcept
+{
+    this->readRawValue();
+}
+
+int SerializedDataReader::readNumChildren() noexcept
+{
+    return this->readCompressedInt();
+}
+
+void SerializedDataReader::skipChildren() noexcept
+{
+    const auto numChildren = this->readNumChildren();
+    for (int i = 0; i < numChildren && !this->isExhausted(); ++i)
+    {
+        this->skipTree();
+    }
+}
+
+SerializedData SerializedDataReader::readNodeHeader()
+{
+    this->enterSectionIfReferenced();
+    const auto *typeName = this->readCString();
+    const auto numProperties = this->readCompressedInt();
+
+    if (*typeName == 0)
+    {
+        // a null node, as written by writeToStream
+        jassert(numProperties == 0);
+        return {};
+    }
+
+    SerializedData node(typeName);
+    for (int i = 0; i < numProperties; ++i)
+    {
+        const auto *propertyName = this->readCString();
+        if (*propertyName != 0)
+        {
+            node.setProperty(propertyName, this->readValue());
+        }
+        else
+        {
+            jassertfalse;
+            this->skipValue();
+        }
+    }
+
+    return node;
+}
+
+SerializedData SerializedDataReader::readTree()
+{
+    if (this->sections == nullptr)
+    {
+        MemoryInputStream input(this->position, size_t(this->end - this->position), false);
+        const auto result = SerializedData::readFromStream(input);
+        this->position += input.getPosition();
+        return result;
+    }
+
+    // any node in the subtree might be a reference, so it's read node by node
+    auto node = this->readNodeHeader();
+    const auto numChildren = this->readNumChildren();
+    for (int i = 0; i < numChildren && !this->isExhausted(); ++i)
+    {
+        const auto child = this->readTree();
+        if (node.isValid())
+        {
+            node.appendChild(child);
+        }
+    }
+
+    return node;
+}
+
+void SerializedDataReader::skipTree() noexcept
+{
+    // the references are skipped as they are, without fetching their sections
+    this->readCString();
+    const auto numProperties = this->readCompressedInt();
+    for (int i = 0; i < numProperties; ++i)
+    {
+        this->readCString();
+        this->readRawValue();
+    }
+
+    this->skipChildren();
+}
+
+SerializedDataReader::RawValue SerializedDataReader::readRawValue() noexcept
+{
+    const auto *start = this->position;
+    const auto numBytes = this->readCompressedInt();
+    if (numBytes < 0 || numBytes > this->end - this->position)
+    {
+        jassertfalse;
+        this->position = this->end;
+        return { start, start, 0 };
+    }
+
+    const auto *data = this->position;
+    this->position += numBytes;
+    return { start, data, numBytes };
+}
+
+var SerializedDataReader::toVar(const RawValue &value)
+{
+    if (value.numBytes == 0)
+    {
+        return {};
+    }
+
+    MemoryInputStream input(value.start, size_t(value.data + value.numBytes - value.start), false);
+    return var::readFromStream(input);
+}
+
+const char *SerializedDataReader::readCString() noexcept
+{
+    if (this->position >= this->end)
+    {
+        this->leaveFinishedSections();
+    }
+
+    const auto *start = this->position;
+    const auto *terminator = static_cast<const char *>(memchr(start, 0,
+        size_t(jmax(ptrdiff_t(0), this->end - start))));
+
+    if (terminator == nullptr)
+    {
+        this->position = this->end;
+        return "";
+    }
+
+    this->position = terminator + 1;
+    return start;
+}
+
+// same as InputStream::readCompressedInt
+int SerializedDataReader::readCompressedInt() noexcept
+{
+    if (this->position >= this->end)
+    {
+        this->leaveFinishedSections();
+        if (this->position >= this->end)
+        {
+            return 0;
+        }
+    }
+
+    const auto sizeByte = uint8(*this->position++);
+    if (sizeByte == 0)
+    {
+        return 0;
+    }
+
+    const int numBytes = (sizeByte & 0x7f);
+    if (numBytes > 4 || numBytes > this->end - this->position)
+    {
+        jassertfalse;
+        this->position = this->end;
+        return 0;
+    }
+
+    char bytes[4] = { 0 };
+    memcpy(bytes, this->position, size_t(numBytes));
+    this->position += numBytes;
+
+    const auto num = int(ByteOrder::littleEndianInt(bytes));
+    return (sizeByte >> 7) ? -num : num;
+}
+
+bool SerializedDataReader::isRawNodeOfType(const char *position,
+    const char *end, const Identifier &type) noexcept
+{
+    const auto &typeName = type.toString();
+    const auto numBytes = typeName.getNumBytesAsUTF8() + 1;
+    return size_t(end - position) >= numBytes &&
+        memcmp(position, typeName.toRawUTF8(), numBytes) == 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Sections
+//===----------------------------------------------------------------------===//
+
+bool SerializedDataReader::isAtSectionReference() const noexcept
+{
+    return this->sections != nullptr &&
+        isRawNodeOfType(this->position, this->end, sectionReference);
+}
+
+void SerializedDataReader::enterSectionIfReferenced()
+{
+    this->leaveFinishedSections();
+    if (!this->isAtSectionReference())
+    {
+        return;
+    }
+
+    const auto *referenceStart = this->position;
+
+    int index = -1;
+    this->readCString();
+    const auto numProperties = this->readCompressedInt();
+    for (int i = 0; i < numProperties; ++i)
+    {
+        if (sectionIndex == this->readPropertyName())
+        {
+            index = this->readInt();
+        }
+        else
+        {
+            this->skipValue();
+        }
+    }
+
+    this->skipChildren();
+
+    const char *data = nullptr;
+    size_t numBytes = 0;
+    const bool hasSection = this->sections->getSection(index, data, numBytes);
+
+    // each section is referenced once, so the sections being read
+    // are not supposed to be referenced from within themselves
+    bool isSectionBeingRead = (data + numBytes == this->end);
+    for (const auto &returnPoint : this->returnPoints)
+    {
+        isSectionBeingRead = isSectionBeingRead || (data + numBytes == returnPoint.end);
+    }
+
+    if (!hasSection || isSectionBeingRead)
+    {
+        // corrupted data, so the reference is read as an unknown node
+        jassertfalse;
+        this->position = referenceStart;
+        return;
+    }
+
+    this->returnPoints.add({ this->position, this->end });
+    this->position = data;
+    this->end = data + numBytes;
+}
+
+void SerializedDataReader::leaveFinishedSections() noexcept
+{
+    while (this->position >= this->end && !this->returnPoints.isEmpty())
+    {
+        const auto &returnPoint = this->returnPoints.getReference(this->returnPoints.size() - 1);
+        this->position = returnPoint.position;
+        this->end = returnPoint.end;
+        this->returnPoints.removeLast();
+    }
+}
+
+#if JUCE_UNIT_TESTS
+
+class SerializedDataReaderTests final : public UnitTest
+{
+public:
+    SerializedDataReaderTests() : UnitTest("Serialized data reader tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        SerializedData root("root");
+        root.setProperty("name", "test");
+
+        SerializedData skipped("skipped");
+        skipped.setProperty("value", 1);
+        skipped.appendChild(SerializedData("nested"));
+        root.appendChild(skipped);
+
+        SerializedData event("event");
+        event.setProperty("id", "abcd");
+        event.setProperty("int", -12345);
+        event.setProperty("double", 0.25);
+        event.setProperty("bool", true);
+        event.setProperty("int64", int64(1) << 40);
+        root.appendChild(event);
+
+        MemoryOutputStream stream;
+        root.writeToStream(stream);
+
+        beginTest("Reading trees");
+
+        {
+            SerializedDataReader reader(stream.getData(), stream.getDataSize());
+            expect(reader.readTree().isEquivalentTo(root));
+            expect(reader.isExhausted());
+        }
+
+        beginTest("Reading values in place");
+
+        {
+            SerializedDataReader reader(stream.getData(), stream.getDataSize());
+            expect(reader.isNodeOfType("root"));
+            expect(!reader.isNodeOfType("roo"));
+            expectEquals(reader.peekProperty("name").toString(), String("test"));
+
+            const auto header = reader.readNodeHeader();
+            expect(header.hasType("root"));
+            expectEquals(header.getProperty("name").toString(), String("test"));
+            expectEquals(reader.readNumChildren(), 2);
+
+            expect(reader.isNodeOfType("skipped"));
+            reader.skipTree();
+
+            expect(reader.isNodeOfType("event"));
+            expectEquals(reader.beginNode(), 5);
+
+            expect(Identifier("id") == reader.readPropertyName());
+            expect(reader.readString() == "abcd");
+            expect(Identifier("int") == reader.readPropertyName());
+            expectEquals(reader.readInt(), -12345);
+            expect(Identifier("double") == reader.readPropertyName());
+            expectEquals(reader.readFloat(), 0.25f);
+            expect(Identifier("bool") == reader.readPropertyName());
+            expectEquals(reader.readInt(), 1);
+            expect(Identifier("int64") == reader.readPropertyName());
+            expect(reader.readValue() == var(int64(1) << 40));
+
+            reader.skipChildren();
+            expect(reader.isExhausted());
+        }
+
+        beginTest("Following section references");
+
+        {
+            // the same tree, with both children moved into sections
+            SerializedData mainSection("root");
+            mainSection.setProperty("name", "test");
+            mainSection.appendChild(createReference(0, "skipped"));
+            mainSection.appendChild(createReference(1, "event"));
+
+            TestSections sections;
+            sections.add(skipped);
+            sections.add(event);
+
+            MemoryOutputStream mainStream;
+            mainSection.writeToStream(mainStream);
+
+            SerializedDataReader reader(mainStream.getData(), mainStream.getDataSize(), &sections);
+            expect(reader.readTree().isEquivalentTo(root));
+            expect(reader.isExhausted());
+            expectEquals(sections.numFetched, 2);
+
+            sections.numFetched = 0;
+            SerializedDataReader streamingReader(mainStream.getData(), mainStream.getDataSize(), &sections);
+            streamingReader.readNodeHeader();
+            expectEquals(streamingReader.readNumChildren(), 2);
+
+            // the types are known without fetching the sections, and skipping doesn't fetch them
+            expect(streamingReader.isNodeOfType("skipped"));
+            streamingReader.skipTree();
+            expect(streamingReader.isNodeOfType("event"));
+            expectEquals(sections.numFetched, 0);
+
+            expect(streamingReader.peekProperty("id").toString() == "abcd");
+            expect(streamingReader.readTree().isEquivalentTo(event));
+            expect(streamingReader.isExhausted());
+            expectEquals(sections.numFetched, 2);
+        }
+    }
+
+private:
+
+    struct TestSections final : SerializedDataReader::Sections
+    {
+        void add(const SerializedData &node)
+        {
+            node.writeToStream(*this->streams.add(new MemoryOutputStream()));
+        }
+
+        bool getSection(int index, const char *&data, size_t &numBytes) override
+        {
+            if (auto *stream = this->streams[index])
+            {
+                this->numFetched++;
+                data = static_cast<const char *>(stream->getData());
+                numBytes = stream->getDataSize();
+                return true;
+            }
+
+            return false;
+        }
+
+        OwnedArray<MemoryOutputStream> streams;
+        int numFetched = 0;
+    };
+
+    static SerializedData createReference(int index, const String &type)
+    {
+        SerializedData reference(SerializedDataReader::sectionReference);
+        reference.setProperty(SerializedDataReader::sectionIndex, index);
+        reference.setProperty(SerializedDataReader::sectionNodeType, type);
+        return reference;
+    }
+};
+
+static SerializedDataReaderTests serializedDataReaderTests;
+
+#endif
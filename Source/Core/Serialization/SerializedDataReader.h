@@ -0,0 +1,131 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SerializedData.h"
+
+// A pull-style reader of the binary format written by SerializedData::writeToStream
+// and SerializedDataBinaryWriter, which works right on top of the raw data
+// (typically, a memory-mapped file), so that the objects like sequences with
+// thousands of events can construct themselves without the intermediate trees.
+
+// All names and strings it returns point into the raw data,
+// so they are only valid while the data is alive.
+
+// The nodes are read in the same order as they were written:
+// the type, the properties, the number of children, then the children;
+// the small nodes can also be read as regular trees via readTree().
+
+// Some nodes might be stored elsewhere, like the sections of BinarySerializer,
+// leaving the reference nodes in their places; the reader follows them
+// transparently, so the sections that are skipped are never even fetched.
+
+class SerializedDataReader final
+{
+public:
+
+    class Sections
+    {
+    public:
+
+        virtual ~Sections() = default;
+
+        // might be called from different threads, since the readers are
+        // copied to read the sequences in background; returns false,
+        // if the section is missing or corrupted
+        virtual bool getSection(int index, const char *&data, size_t &numBytes) = 0;
+    };
+
+    // the reference node has the section index and the type of the node it replaces
+    static const Identifier sectionReference;
+    static const Identifier sectionIndex;
+    static const Identifier sectionNodeType;
+
+    SerializedDataReader(const void *data, size_t numBytes,
+        Sections *sections = nullptr) noexcept;
+
+    bool isExhausted() const noexcept;
+
+    // checks the type of the node at the current position, without reading it
+    bool isNodeOfType(const Identifier &type) const;
+
+    // finds the property of the node at the current position, without reading it
+    var peekProperty(const Identifier &name) const;
+
+    // reads the node type and returns the number of its properties,
+    // each of which should be read by readPropertyName() + any of the value readers
+    int beginNode();
+
+    StringRef readPropertyName() noexcept;
+
+    // the fast paths for the values, converted the same way var converts them
+    int readInt();
+    float readFloat();
+    StringRef readString() noexcept; // empty, if the value is not a string
+    var readValue();
+    void skipValue() noexcept;
+
+    // after all properties are read
+    int readNumChildren() noexcept;
+    void skipChildren() noexcept;
+
+    // reads the node type and properties into a tree,
+    // leaving the children to be read by the caller
+    SerializedData readNodeHeader();
+
+    // reads or skips the whole node at the current position
+    SerializedData readTree();
+    void skipTree() noexcept;
+
+private:
+
+    struct RawValue final
+    {
+        const char *start;
+        const char *data;
+        int numBytes;
+    };
+
+    RawValue readRawValue() noexcept;
+    static var toVar(const RawValue &value);
+    static bool isRawNodeOfType(const char *position,
+        const char *end, const Identifier &type) noexcept;
+
+    const char *readCString() noexcept;
+    int readCompressedInt() noexcept;
+
+    bool isAtSectionReference() const noexcept;
+    void enterSectionIfReferenced();
+    void leaveFinishedSections() noexcept;
+
+    const char *position;
+    const char *end;
+
+    Sections *sections = nullptr;
+
+    // where to continue, once the sections being read are finished
+    struct ReturnPoint final
+    {
+        const char *position;
+        const char *end;
+    };
+
+    Array<ReturnPoint> returnPoints;
+
+    JUCE_LEAK_DETECTOR(SerializedDataReader)
+};
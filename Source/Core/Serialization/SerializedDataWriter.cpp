@@ -0,0 +1,194 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "SerializedDataWriter.h"
+
+void SerializedDataWriter::beginNode(const SerializedData &header, int numChildren)
+{
+    const int numProperties = header.getNumProperties();
+    this->beginNode(header.getType(), numProperties, numChildren);
+
+    for (int i = 0; i < numProperties; ++i)
+    {
+        const auto name = header.getPropertyName(i);
+        this->writeProperty(name, header.getProperty(name));
+    }
+}
+
+void SerializedDataWriter::writeTree(const SerializedData &tree)
+{
+    this->beginNode(tree, tree.getNumChildren());
+
+    for (const auto &child : tree)
+    {
+        this->writeTree(child);
+    }
+
+    this->endNode();
+}
+
+//===----------------------------------------------------------------------===//
+// Tree writer
+//===----------------------------------------------------------------------===//
+
+void SerializedDataTreeWriter::beginNode(const Identifier &type, int, int)
+{
+    SerializedData node(type);
+
+    if (this->stack.isEmpty())
+    {
+        jassert(!this->result.isValid());
+        this->result = node;
+    }
+    else
+    {
+        this->stack.getReference(this->stack.size() - 1).appendChild(node);
+    }
+
+    this->stack.add(node);
+}
+
+void SerializedDataTreeWriter::writeProperty(const Identifier &name, const var &value)
+{
+    jassert(!this->stack.isEmpty());
+    this->stack.getReference(this->stack.size() - 1).setProperty(name, value);
+}
+
+void SerializedDataTreeWriter::endNode()
+{
+    jassert(!this->stack.isEmpty());
+    this->stack.removeLast();
+}
+
+SerializedData SerializedDataTreeWriter::getResult() const noexcept
+{
+    jassert(this->stack.isEmpty());
+    return this->result;
+}
+
+//===----------------------------------------------------------------------===//
+// Binary writer
+//===----------------------------------------------------------------------===//
+
+void SerializedDataBinaryWriter::beginNode(const Identifier &type, int numProperties, int numChildren)
+{
+    if (!this->stack.isEmpty())
+    {
+        auto &parent = this->stack.getReference(this->stack.size() - 1);
+        jassert(parent.numPropertiesLeft == 0);
+        jassert(parent.numChildrenLeft > 0);
+        parent.numChildrenLeft--;
+    }
+
+    this->output.writeString(type.toString());
+    this->output.writeCompressedInt(numProperties);
+
+    if (numProperties == 0)
+    {
+        this->output.writeCompressedInt(numChildren);
+    }
+
+    this->stack.add({ numProperties, numChildren, numChildren });
+}
+
+void SerializedDataBinaryWriter::writeProperty(const Identifier &name, const var &value)
+{
+    jassert(!this->stack.isEmpty());
+    auto &node = this->stack.getReference(this->stack.size() - 1);
+    jassert(node.numPropertiesLeft > 0);
+
+    this->output.writeString(name.toString());
+    value.writeToStream(this->output);
+
+    node.numPropertiesLeft--;
+    if (node.numPropertiesLeft == 0)
+    {
+        this->output.writeCompressedInt(node.numChildren);
+    }
+}
+
+void SerializedDataBinaryWriter::endNode()
+{
+    jassert(!this->stack.isEmpty());
+    jassert(this->stack.getLast().numPropertiesLeft == 0);
+    jassert(this->stack.getLast().numChildrenLeft == 0);
+    this->stack.removeLast();
+}
+
+#if JUCE_UNIT_TESTS
+
+class SerializedDataWriterTests final : public UnitTest
+{
+public:
+    SerializedDataWriterTests() : UnitTest("Serialized data writers tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        const auto tree = this->createTestTree();
+
+        beginTest("Tree writer");
+
+        SerializedDataTreeWriter treeWriter;
+        treeWriter.writeTree(tree);
+        expect(treeWriter.getResult().isEquivalentTo(tree));
+
+        beginTest("Binary writer");
+
+        MemoryOutputStream expected;
+        tree.writeToStream(expected);
+
+        MemoryOutputStream streamed;
+        SerializedDataBinaryWriter binaryWriter(streamed);
+        binaryWriter.writeTree(tree);
+
+        expect(streamed.getMemoryBlock() == expected.getMemoryBlock());
+
+        const auto restored = SerializedData::readFromData(streamed.getData(), streamed.getDataSize());
+        expect(restored.isEquivalentTo(tree));
+    }
+
+private:
+
+    SerializedData createTestTree() const
+    {
+        SerializedData root("root");
+        root.setProperty("name", "test");
+
+        SerializedData empty("empty");
+        root.appendChild(empty);
+
+        SerializedData noProperties("noProperties");
+        noProperties.appendChild(SerializedData("leaf"));
+        root.appendChild(noProperties);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            SerializedData child("child");
+            child.setProperty("int", i);
+            child.setProperty("double", i * 0.5);
+            child.setProperty("string", String(i));
+            root.appendChild(child);
+        }
+
+        return root;
+    }
+};
+
+static SerializedDataWriterTests serializedDataWriterTests;
+
+#endif
@@ -0,0 +1,95 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "SerializedData.h"
+
+// A push-style alternative to building SerializedData trees:
+// the objects which can write themselves directly (like sequences with
+// thousands of events) use it to avoid allocating the intermediate tree,
+// and all the others just write their trees via writeTree().
+
+// The number of properties and children is passed in advance,
+// since the binary format stores the counts before the contents.
+
+class SerializedDataWriter
+{
+public:
+
+    virtual ~SerializedDataWriter() = default;
+
+    virtual void beginNode(const Identifier &type, int numProperties, int numChildren) = 0;
+    virtual void writeProperty(const Identifier &name, const var &value) = 0;
+    virtual void endNode() = 0;
+
+    // begins the node with the type and all properties of the given one
+    void beginNode(const SerializedData &header, int numChildren);
+    void writeTree(const SerializedData &tree);
+};
+
+// Collects whatever is written into a regular tree,
+// used by the serializers which can't stream
+
+class SerializedDataTreeWriter final : public SerializedDataWriter
+{
+public:
+
+    SerializedDataTreeWriter() = default;
+
+    using SerializedDataWriter::beginNode;
+    void beginNode(const Identifier &type, int numProperties, int numChildren) override;
+    void writeProperty(const Identifier &name, const var &value) override;
+    void endNode() override;
+
+    SerializedData getResult() const noexcept;
+
+private:
+
+    SerializedData result;
+    Array<SerializedData> stack;
+
+    JUCE_DECLARE_NON_COPYABLE(SerializedDataTreeWriter)
+};
+
+// Writes exactly the same as SerializedData::writeToStream would
+
+class SerializedDataBinaryWriter final : public SerializedDataWriter
+{
+public:
+
+    explicit SerializedDataBinaryWriter(OutputStream &output) : output(output) {}
+
+    using SerializedDataWriter::beginNode;
+    void beginNode(const Identifier &type, int numProperties, int numChildren) override;
+    void writeProperty(const Identifier &name, const var &value) override;
+    void endNode() override;
+
+private:
+
+    struct Node final
+    {
+        int numPropertiesLeft;
+        int numChildren;
+        int numChildrenLeft;
+    };
+
+    OutputStream &output;
+    Array<Node> stack;
+
+    JUCE_DECLARE_NON_COPYABLE(SerializedDataBinaryWriter)
+};
@@ -19,6 +19,7 @@
 
 class Serializable;
 class SerializedData;
+class SerializedDataWriter;
 
 class Serializer
 {
@@ -27,8 +28,30 @@ public:
     virtual ~Serializer() = default;
 
     virtual Result saveToFile(File file, const SerializedData &tree) const = 0;
+
+    // streams the data written by the given function without building
+    // the whole tree, if the format allows; by default, the tree is collected
+    // and saved as usual, so the saved data is the same in both cases
+    using WriteFunction = Function<void(SerializedDataWriter &writer)>;
+    virtual Result streamToFile(File file, const WriteFunction &write) const
+    {
+        SerializedDataTreeWriter treeWriter;
+        write(treeWriter);
+        return this->saveToFile(file, treeWriter.getResult());
+    }
+
     virtual SerializedData loadFromFile(const File &file) const = 0;
 
+    // lets the given function read the file contents in place, if the format allows;
+    // the text formats can't do that, and re-encoding their trees just to read them
+    // would only make loading slower, so by default this fails without calling
+    // the function, and the callers should load the tree as usual
+    using ReadFunction = Function<void(SerializedDataReader &reader)>;
+    virtual Result streamFromFile(const File &file, const ReadFunction &read) const
+    {
+        return Result::fail("Reading in place is not supported");
+    }
+
     virtual Result saveToString(String &string, const SerializedData &tree) const = 0;
     virtual SerializedData loadFromString(const String &string) const = 0;
 
@@ -163,25 +163,6 @@ void AutomationTrackNode::resetStateTo(const VCS::TrackedItem &newState)
 // Serializable
 //===----------------------------------------------------------------------===//
 
-SerializedData AutomationTrackNode::serialize() const
-{
-    SerializedData tree(Serialization::Core::treeNode);
-
-    this->serializeVCSUuid(tree);
-
-    tree.setProperty(Serialization::Core::treeNodeType, this->type);
-    tree.setProperty(Serialization::Core::treeNodeName, this->name);
-
-    this->serializeTrackProperties(tree);
-
-    tree.appendChild(this->sequence->serialize());
-    tree.appendChild(this->pattern->serialize());
-
-    TreeNodeSerializer::serializeChildren(*this, tree);
-
-    return tree;
-}
-
 void AutomationTrackNode::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -203,6 +184,32 @@ void AutomationTrackNode::deserialize(const SerializedData &data)
     TreeNode::deserialize(data);
 }
 
+void AutomationTrackNode::deserializeFrom(SerializedDataReader &reader)
+{
+    this->reset();
+
+    // the track properties are read into a small tree,
+    // and the sequence events are created right from the raw data
+    this->deserializeTrackHeader(reader.readNodeHeader());
+
+    const auto numChildren = reader.readNumChildren();
+    for (int i = 0; i < numChildren; ++i)
+    {
+        if (reader.isNodeOfType(Serialization::Midi::automation))
+        {
+            this->deserializeSequenceFrom(reader);
+        }
+        else if (reader.isNodeOfType(Serialization::Midi::pattern))
+        {
+            this->pattern->deserialize(reader.readTree());
+        }
+        else
+        {
+            TreeNodeSerializer::deserializeChild(*this, reader);
+        }
+    }
+}
+
 
 //===----------------------------------------------------------------------===//
 // Deltas
@@ -42,8 +42,8 @@ public:
     // Serializable
     //===------------------------------------------------------------------===//
 
-    SerializedData serialize() const override;
     void deserialize(const SerializedData &data) override;
+    void deserializeFrom(SerializedDataReader &reader) override;
 
     //===------------------------------------------------------------------===//
     // Deltas
@@ -18,6 +18,7 @@
 #include "Common.h"
 #include "MidiTrackNode.h"
 #include "TrackGroupNode.h"
+#include "TreeNodeSerializer.h"
 
 #include "ProjectNode.h"
 #include "MainLayout.h"
@@ -32,6 +33,7 @@
 
 #include "UndoStack.h"
 #include "MidiTrackActions.h"
+#include "PackedDeltaHelpers.h"
 
 MidiTrackNode::MidiTrackNode(const String &name, const Identifier &type) :
     TreeNode(name, type),
@@ -73,15 +75,15 @@ String MidiTrackNode::getVCSName() const
 
 SerializedData MidiTrackNode::serializeClipsDelta() const
 {
-    SerializedData tree(Serialization::VCS::PatternDeltas::clipsAdded);
-
+    Array<Clip> clips;
+    clips.ensureStorageAllocated(this->getPattern()->size());
     for (int i = 0; i < this->getPattern()->size(); ++i)
     {
-        const auto clip = this->getPattern()->getUnchecked(i);
-        tree.appendChild(clip->serialize());
+        clips.add(*this->getPattern()->getUnchecked(i));
     }
 
-    return tree;
+    return VCS::PackedDeltaHelpers::packClips(clips,
+        Serialization::VCS::PatternDeltas::clipsAdded);
 }
 
 void MidiTrackNode::resetClipsDelta(const SerializedData &state)
@@ -92,11 +94,9 @@ void MidiTrackNode::resetClipsDelta(const SerializedData &state)
     this->getPattern()->reset();
 
     Pattern *pattern = this->getPattern();
-    forEachChildWithType(state, e, Serialization::Midi::clip)
+    for (const auto &clip : VCS::PackedDeltaHelpers::unpackClips(state))
     {
-        Clip c(pattern);
-        c.deserialize(e);
-        pattern->silentImport(c);
+        pattern->silentImport(clip);
     }
 }
 
@@ -427,6 +427,90 @@ ProjectNode *MidiTrackNode::getProject() const noexcept
     return this->lastFoundParent;
 }
 
+//===----------------------------------------------------------------------===//
+// Serializable
+//===----------------------------------------------------------------------===//
+
+// the track layout, shared by the synchronous saves and the snapshots,
+// which only differ in whether the parts are written as they are or copied
+static void writeTrack(SerializedDataWriter &writer, const SerializedData &header,
+    const SerializedSnapshot &sequence, const SerializedSnapshot &pattern,
+    const Array<SerializedSnapshot> &children)
+{
+    writer.beginNode(header, 2 + children.size());
+    sequence(writer);
+    pattern(writer);
+    for (const auto &child : children)
+    {
+        child(writer);
+    }
+    writer.endNode();
+}
+
+SerializedData MidiTrackNode::serialize() const
+{
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+void MidiTrackNode::serializeTo(SerializedDataWriter &writer) const
+{
+    // the sequence is written event by event, without building its tree
+    const auto *sequence = this->sequence.get();
+    const auto *pattern = this->pattern.get();
+
+    writeTrack(writer, this->serializeTrackHeader(),
+        [sequence](SerializedDataWriter &w) { sequence->serializeTo(w); },
+        [pattern](SerializedDataWriter &w) { pattern->serializeTo(w); },
+        TreeNodeSerializer::createChildrenWriters(*this));
+}
+
+SerializedSnapshot MidiTrackNode::createSnapshot() const
+{
+    const auto header = this->serializeTrackHeader();
+
+    const auto sequence = this->sequence->createSnapshot();
+    const auto pattern = this->pattern->createSnapshot();
+    const auto children = TreeNodeSerializer::createChildrenSnapshots(*this);
+
+    return [header, sequence, pattern, children](SerializedDataWriter &writer)
+    {
+        writeTrack(writer, header, sequence, pattern, children);
+    };
+}
+
+SerializedData MidiTrackNode::serializeTrackHeader() const
+{
+    SerializedData header(Serialization::Core::treeNode);
+
+    this->serializeVCSUuid(header);
+
+    header.setProperty(Serialization::Core::treeNodeType, this->type);
+    header.setProperty(Serialization::Core::treeNodeName, this->name);
+
+    this->serializeTrackProperties(header);
+    return header;
+}
+
+void MidiTrackNode::deserializeTrackHeader(const SerializedData &header)
+{
+    this->deserializeVCSUuid(header);
+    this->deserializeTrackProperties(header);
+    this->name = header.getProperty(Serialization::Core::treeNodeName);
+}
+
+void MidiTrackNode::deserializeSequenceFrom(SerializedDataReader &reader)
+{
+    // sequences are the heaviest part of the project, and they don't depend
+    // on each other, so the project builds them in parallel while it's loading
+    if (this->lastFoundParent == nullptr ||
+        !this->lastFoundParent->deserializeSequenceInBackground(this->sequence.get(), reader))
+    {
+        this->sequence->deserializeFrom(reader);
+    }
+}
+
 //===----------------------------------------------------------------------===//
 // Add to tree and remove from tree callbacks
 //===----------------------------------------------------------------------===//
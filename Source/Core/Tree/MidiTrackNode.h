@@ -94,6 +94,16 @@ public:
 
     ProjectNode *getProject() const noexcept override;
 
+    //===------------------------------------------------------------------===//
+    // Serializable
+    //===------------------------------------------------------------------===//
+
+    // piano and automation tracks are laid out the same way,
+    // and only differ in the types of their sequences
+    SerializedData serialize() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
+    SerializedSnapshot createSnapshot() const override;
+
     //===------------------------------------------------------------------===//
     // Dragging
     //===------------------------------------------------------------------===//
@@ -119,6 +129,13 @@ protected:
 
     ProjectNode *lastFoundParent;
 
+    void deserializeSequenceFrom(SerializedDataReader &reader);
+
+    // the node's own properties, without the sequence, pattern and children,
+    // shared by all the ways the track is serialized
+    SerializedData serializeTrackHeader() const;
+    void deserializeTrackHeader(const SerializedData &header);
+
     UniquePointer<MidiSequence> sequence;
     UniquePointer<Pattern> pattern;
     
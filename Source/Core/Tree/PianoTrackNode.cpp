@@ -29,6 +29,7 @@
 
 #include "Delta.h"
 #include "PianoTrackDiffLogic.h"
+#include "PackedDeltaHelpers.h"
 
 PianoTrackNode::PianoTrackNode(const String &name) :
     MidiTrackNode(name, Serialization::Core::pianoTrack)
@@ -168,25 +169,6 @@ void PianoTrackNode::resetStateTo(const VCS::TrackedItem &newState)
 // Serializable
 //===----------------------------------------------------------------------===//
 
-SerializedData PianoTrackNode::serialize() const
-{
-    SerializedData tree(Serialization::Core::treeNode);
-
-    this->serializeVCSUuid(tree);
-
-    tree.setProperty(Serialization::Core::treeNodeType, this->type);
-    tree.setProperty(Serialization::Core::treeNodeName, this->name);
-
-    this->serializeTrackProperties(tree);
-
-    tree.appendChild(this->sequence->serialize());
-    tree.appendChild(this->pattern->serialize());
-
-    TreeNodeSerializer::serializeChildren(*this, tree);
-
-    return tree;
-}
-
 void PianoTrackNode::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -208,6 +190,32 @@ void PianoTrackNode::deserialize(const SerializedData &data)
     TreeNode::deserialize(data);
 }
 
+void PianoTrackNode::deserializeFrom(SerializedDataReader &reader)
+{
+    this->reset();
+
+    // the track properties are read into a small tree,
+    // and the sequence events are created right from the raw data
+    this->deserializeTrackHeader(reader.readNodeHeader());
+
+    const auto numChildren = reader.readNumChildren();
+    for (int i = 0; i < numChildren; ++i)
+    {
+        if (reader.isNodeOfType(Serialization::Midi::track))
+        {
+            this->deserializeSequenceFrom(reader);
+        }
+        else if (reader.isNodeOfType(Serialization::Midi::pattern))
+        {
+            this->pattern->deserialize(reader.readTree());
+        }
+        else
+        {
+            TreeNodeSerializer::deserializeChild(*this, reader);
+        }
+    }
+}
+
 
 //===----------------------------------------------------------------------===//
 // Deltas
@@ -239,14 +247,15 @@ SerializedData PianoTrackNode::serializeInstrumentDelta() const
 
 SerializedData PianoTrackNode::serializeEventsDelta() const
 {
-    SerializedData tree(Serialization::VCS::PianoSequenceDeltas::notesAdded);
+    Array<const MidiEvent *> notes;
+    notes.ensureStorageAllocated(this->getSequence()->size());
     for (int i = 0; i < this->getSequence()->size(); ++i)
     {
-        const MidiEvent *event = this->getSequence()->getUnchecked(i);
-        tree.appendChild(event->serialize());
+        notes.add(this->getSequence()->getUnchecked(i));
     }
 
-    return tree;
+    return VCS::PackedDeltaHelpers::packNotes(notes,
+        Serialization::VCS::PianoSequenceDeltas::notesAdded);
 }
 
 void PianoTrackNode::resetPathDelta(const SerializedData &state)
@@ -280,9 +289,9 @@ void PianoTrackNode::resetEventsDelta(const SerializedData &state)
     jassert(state.hasType(Serialization::VCS::PianoSequenceDeltas::notesAdded));
 
     this->getSequence()->reset();
-    forEachChildWithType(state, e, Serialization::Midi::note)
+    for (const auto &note : VCS::PackedDeltaHelpers::unpackNotes(state))
     {
-        this->getSequence()->checkoutEvent<Note>(e);
+        this->getSequence()->checkoutEvent<Note>(note);
     }
 
     this->getSequence()->updateBeatRange(false);
@@ -88,6 +88,7 @@ ProjectNode::ProjectNode(const File &existingFile) :
 void ProjectNode::initialize()
 {
     this->undoStack = make<UndoStack>(*this);
+    this->serializer = make<BinarySerializer>(BinarySerializer::Format::Sectioned);
     this->autosaver = make<Autosaver>(*this);
 
     auto &orchestra = App::Workspace().getAudioCore();
@@ -516,22 +517,59 @@ void ProjectNode::reset()
     TreeNode::reset();
 }
 
-SerializedData ProjectNode::save() const
+// the project layout, shared by the synchronous saves and the snapshots,
+// which only differ in whether the parts are written as they are or copied
+static void writeProject(SerializedDataWriter &writer,
+    const String &name, const String &id,
+    const Array<SerializedSnapshot> &parts,
+    const Array<SerializedSnapshot> &children)
 {
-    SerializedData tree(Serialization::Core::project);
+    writer.beginNode(Serialization::Core::project, 2, parts.size() + children.size());
 
-    tree.setProperty(Serialization::Core::treeNodeName, this->name);
-    tree.setProperty(Serialization::Core::projectId, this->id);
+    writer.writeProperty(Serialization::Core::treeNodeName, name);
+    writer.writeProperty(Serialization::Core::projectId, id);
 
-    tree.appendChild(this->metadata->serialize());
-    tree.appendChild(this->timeline->serialize());
-    tree.appendChild(this->undoStack->serialize());
-    tree.appendChild(this->transport->serialize());
-    tree.appendChild(this->sequencerLayout->serialize());
+    for (const auto &part : parts)
+    {
+        part(writer);
+    }
 
-    TreeNodeSerializer::serializeChildren(*this, tree);
+    for (const auto &child : children)
+    {
+        child(writer);
+    }
 
-    return tree;
+    writer.endNode();
+}
+
+Array<const Serializable *> ProjectNode::getSerializedParts() const
+{
+    Array<const Serializable *> parts;
+    parts.add(this->metadata.get());
+    parts.add(this->timeline.get());
+    parts.add(this->undoStack.get());
+    parts.add(this->transport.get());
+    parts.add(this->sequencerLayout.get());
+    return parts;
+}
+
+SerializedData ProjectNode::save() const
+{
+    SerializedDataTreeWriter writer;
+    this->save(writer);
+    return writer.getResult();
+}
+
+void ProjectNode::save(SerializedDataWriter &writer) const
+{
+    Array<SerializedSnapshot> parts;
+    for (const auto *part : this->getSerializedParts())
+    {
+        parts.add([part](SerializedDataWriter &w) { part->serializeTo(w); });
+    }
+
+    writeProject(writer, this->name, this->id, parts,
+        TreeNodeSerializer::createChildrenWriters(*this));
 }
 
 void ProjectNode::load(const SerializedData &tree)
@@ -552,6 +590,101 @@ void ProjectNode::load(const SerializedData &tree)
     // Proceed with basic properties and children
     TreeNode::deserialize(root);
 
+    this->onProjectContentLoaded(root);
+}
+
+bool ProjectNode::load(SerializedDataReader &reader)
+{
+    if (!reader.isNodeOfType(Serialization::Core::project))
+    {
+        const auto tree = reader.readTree();
+        if (!tree.isValid())
+        {
+            return false;
+        }
+
+        this->load(tree);
+        return true;
+    }
+
+    this->broadcastBeforeReloadProjectContent();
+    this->reset();
+
+    auto root = reader.readNodeHeader();
+    const auto numChildren = reader.readNumChildren();
+
+    // all children except tree nodes are small, and they are needed before
+    // the tracks are created, so the first pass reads them and skips the rest
+    {
+        auto scanner = reader;
+        for (int i = 0; i < numChildren; ++i)
+        {
+            if (scanner.isNodeOfType(Serialization::Core::treeNode))
+            {
+                scanner.skipTree();
+            }
+            else
+            {
+                root.appendChild(scanner.readTree());
+            }
+        }
+    }
+
+    this->id = root.getProperty(Serialization::Core::projectId, Uuid().toString());
+
+    this->metadata->deserialize(root);
+    this->timeline->deserialize(root);
+
+    // Proceed with basic properties and children, the tracks are read in place,
+    // and their sequences are built in parallel while the tree is being read
+    this->name = root.getProperty(Serialization::Core::treeNodeName);
+    this->sequencesLoader = make<MidiSequencesLoader>();
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        if (reader.isNodeOfType(Serialization::Core::treeNode))
+        {
+            TreeNodeSerializer::deserializeChild(*this, reader);
+        }
+        else
+        {
+            reader.skipTree();
+        }
+    }
+
+    // all sequences are built by now, and the loader threads are stopped
+    this->sequencesLoader = nullptr;
+
+    // the tracks were attached without notifications,
+    // so that no listener could touch a sequence that is still being read;
+    // now it's safe to register them, and onProjectContentLoaded
+    // will notify everyone by broadcasting the content reload
+    this->isTracksCacheOutdated = true;
+    {
+        const ScopedWriteLock lock(this->vcsInfoLock);
+        for (auto *track : this->findChildrenOfType<MidiTrackNode>())
+        {
+            this->vcsItems.addIfNotAlreadyThere(track);
+        }
+    }
+
+    this->onProjectContentLoaded(root);
+    return true;
+}
+
+bool ProjectNode::deserializeSequenceInBackground(MidiSequence *sequence, SerializedDataReader &reader)
+{
+    if (this->sequencesLoader == nullptr)
+    {
+        return false;
+    }
+
+    this->sequencesLoader->deserializeInBackground(sequence, reader);
+    return true;
+}
+
+void ProjectNode::onProjectContentLoaded(const SerializedData &root)
+{
     // Legacy support: if no pattern set manager found, create one
     if (nullptr == this->findChildOfType<PatternEditorNode>())
     {
@@ -863,6 +996,22 @@ bool ProjectNode::onDocumentLoad(File &file)
 {
     if (file.existsAsFile())
     {
+        this->undoStack->setJournalFile(file);
+
+        // the project is read right from the file, without building the whole tree
+        bool loaded = false;
+        const bool wasReadInPlace = DocumentHelpers::load(file,
+            [this, &loaded](SerializedDataReader &reader)
+            {
+                loaded = this->load(reader);
+            });
+
+        if (wasReadInPlace)
+        {
+            return loaded;
+        }
+
+        // the formats which can't be read in place, like xml or json
         const auto tree = DocumentHelpers::load(file);
         if (tree.isValid())
         {
@@ -883,11 +1032,49 @@ void ProjectNode::onDocumentDidLoad(File &file)
 
 bool ProjectNode::onDocumentSave(File &file)
 {
-    const auto projectNode(this->save());
+    this->undoStack->setJournalFile(file);
+    this->undoStack->flushJournal();
+
+#if DEBUG
+    DocumentHelpers::save<XmlSerializer>(file.withFileExtension("xml"), this->save());
+#endif
+
+    // tracks are streamed right into the file, without building the whole tree
+    return DocumentHelpers::save(file, *this->serializer,
+        [this](SerializedDataWriter &writer) { this->save(writer); });
+}
+
+SerializedSnapshot ProjectNode::onDocumentCreateSnapshot()
+{
+    // only copies the data here, on the message thread, e.g. the events
+    // and the history item references, and the whole tree is then
+    // built and encoded on the autosaver thread
+    const auto name = this->name;
+    const auto id = this->id;
+
+    this->undoStack->setJournalFile(this->getDocument()->getFile());
+    this->undoStack->flushJournal();
+
+    Array<SerializedSnapshot> parts;
+    for (const auto *part : this->getSerializedParts())
+    {
+        parts.add(part->createSnapshot());
+    }
+
+    const auto children = TreeNodeSerializer::createChildrenSnapshots(*this);
+
+    return [name, id, parts, children](SerializedDataWriter &writer)
+    {
+        writeProject(writer, name, id, parts, children);
+    };
+}
+
+bool ProjectNode::onDocumentSaveSnapshot(const File &file, const SerializedSnapshot &snapshot)
+{
 #if DEBUG
-    DocumentHelpers::save<XmlSerializer>(file.withFileExtension("xml"), projectNode);
+    DocumentHelpers::save<XmlSerializer>(file.withFileExtension("xml"), snapshot);
 #endif
-    return DocumentHelpers::save<BinarySerializer>(file, projectNode);
+    return DocumentHelpers::save(file, *this->serializer, snapshot);
 }
 
 void ProjectNode::onDocumentImport(File &file)
@@ -18,6 +18,7 @@
 #pragma once
 
 class Autosaver;
+class BinarySerializer;
 class Document;
 class ProjectListener;
 class SequencerLayout;
@@ -125,6 +126,10 @@ public:
     void deserialize(const SerializedData &data) override;
     void reset() override;
 
+    // while the project is loading, the tracks hand their sequences over here
+    // to be built by the workers pool; returns false if not loading
+    bool deserializeSequenceInBackground(MidiSequence *sequence, SerializedDataReader &reader);
+
     //===------------------------------------------------------------------===//
     // Project listeners
     //===------------------------------------------------------------------===//
@@ -197,6 +202,8 @@ protected:
     bool onDocumentLoad(File &file) override;
     void onDocumentDidLoad(File &file) override;
     bool onDocumentSave(File &file) override;
+    SerializedSnapshot onDocumentCreateSnapshot() override;
+    bool onDocumentSaveSnapshot(const File &file, const SerializedSnapshot &snapshot) override;
     void onDocumentImport(File &file) override;
     bool onDocumentExport(File &file) override;
 
@@ -212,6 +219,9 @@ private:
 
     void collectTracks(Array<MidiTrack *> &resultArray, bool onlySelected = false) const;
 
+    // keeps the sections of the last save, so it's created for each project,
+    // and it's declared before the autosaver, which might use it when deleted
+    UniquePointer<BinarySerializer> serializer;
     UniquePointer<Autosaver> autosaver;
     UniquePointer<Transport> transport;
     UniquePointer<MidiRecorder> midiRecorder;
@@ -233,8 +243,19 @@ private:
 private:
 
     void initialize();
+
+    // the metadata, timeline, history, transport and layout, in the saved order
+    Array<const Serializable *> getSerializedParts() const;
+
+    // the tree is only built for debugging, the project is saved via the writer
     SerializedData save() const;
+    void save(SerializedDataWriter &writer) const;
     void load(const SerializedData &tree);
+    bool load(SerializedDataReader &reader);
+    void onProjectContentLoaded(const SerializedData &root);
+
+    // only exists while the project is loading
+    UniquePointer<MidiSequencesLoader> sequencesLoader;
 
 private:
 
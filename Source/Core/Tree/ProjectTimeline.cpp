@@ -324,26 +324,68 @@ void ProjectTimeline::reset()
     this->timeSignaturesSequence->reset();
 }
 
-SerializedData ProjectTimeline::serialize() const
+// the timeline layout, shared by the synchronous saves and the snapshots
+static void writeTimeline(SerializedDataWriter &writer, const SerializedData &header,
+    const SerializedSnapshot &annotations,
+    const SerializedSnapshot &keySignatures,
+    const SerializedSnapshot &timeSignatures)
 {
-    SerializedData tree(this->vcsDiffLogic->getType());
+    writer.beginNode(header, 3);
+    annotations(writer);
+    keySignatures(writer);
+    timeSignatures(writer);
+    writer.endNode();
+}
 
-    this->serializeVCSUuid(tree);
+SerializedData ProjectTimeline::serializeTimelineHeader() const
+{
+    SerializedData header(this->vcsDiffLogic->getType());
 
-    tree.setProperty(Serialization::Core::annotationsTrackId,
+    this->serializeVCSUuid(header);
+
+    header.setProperty(Serialization::Core::annotationsTrackId,
         this->annotationsTrackId);
 
-    tree.setProperty(Serialization::Core::keySignaturesTrackId,
+    header.setProperty(Serialization::Core::keySignaturesTrackId,
         this->keySignaturesTrackId);
 
-    tree.setProperty(Serialization::Core::timeSignaturesTrackId,
+    header.setProperty(Serialization::Core::timeSignaturesTrackId,
         this->timeSignaturesTrackId);
 
-    tree.appendChild(this->annotationsSequence->serialize());
-    tree.appendChild(this->keySignaturesSequence->serialize());
-    tree.appendChild(this->timeSignaturesSequence->serialize());
+    return header;
+}
 
-    return tree;
+SerializedData ProjectTimeline::serialize() const
+{
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+void ProjectTimeline::serializeTo(SerializedDataWriter &writer) const
+{
+    const auto *annotations = this->annotationsSequence.get();
+    const auto *keySignatures = this->keySignaturesSequence.get();
+    const auto *timeSignatures = this->timeSignaturesSequence.get();
+
+    writeTimeline(writer, this->serializeTimelineHeader(),
+        [annotations](SerializedDataWriter &w) { annotations->serializeTo(w); },
+        [keySignatures](SerializedDataWriter &w) { keySignatures->serializeTo(w); },
+        [timeSignatures](SerializedDataWriter &w) { timeSignatures->serializeTo(w); });
+}
+
+SerializedSnapshot ProjectTimeline::createSnapshot() const
+{
+    const auto header = this->serializeTimelineHeader();
+
+    const auto annotations = this->annotationsSequence->createSnapshot();
+    const auto keySignatures = this->keySignaturesSequence->createSnapshot();
+    const auto timeSignatures = this->timeSignaturesSequence->createSnapshot();
+
+    return [header, annotations, keySignatures, timeSignatures](SerializedDataWriter &writer)
+    {
+        writeTimeline(writer, header, annotations, keySignatures, timeSignatures);
+    };
 }
 
 void ProjectTimeline::deserialize(const SerializedData &data)
@@ -82,6 +82,8 @@ public:
 
     void reset() override;
     SerializedData serialize() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
+    SerializedSnapshot createSnapshot() const override;
     void deserialize(const SerializedData &data) override;
     
     //===------------------------------------------------------------------===//
@@ -99,6 +101,9 @@ public:
 
 private:
 
+    // the timeline's own properties, without the sequences
+    SerializedData serializeTimelineHeader() const;
+
     UniquePointer<VCS::DiffLogic> vcsDiffLogic;
 
     OwnedArray<VCS::Delta> deltas;
@@ -19,6 +19,7 @@
 #include "TrackGroupNode.h"
 #include "ProjectNode.h"
 #include "PianoTrackNode.h"
+#include "TreeNodeSerializer.h"
 #include "Icons.h"
 
 #define GROUP_COMPACT_SEPARATOR 5
@@ -143,3 +144,55 @@ UniquePointer<Component> TrackGroupNode::createMenu()
 {
     return nullptr;
 }
+
+//===----------------------------------------------------------------------===//
+// Serializable
+//===----------------------------------------------------------------------===//
+
+// same layout as TreeNode::serialize(), but lets the nested tracks stream,
+// shared by the synchronous saves and the snapshots
+static void writeGroup(SerializedDataWriter &writer,
+    const String &type, const String &name,
+    const Array<SerializedSnapshot> &children)
+{
+    writer.beginNode(Serialization::Core::treeNode, 2, children.size());
+    writer.writeProperty(Serialization::Core::treeNodeType, type);
+    writer.writeProperty(Serialization::Core::treeNodeName, name);
+    for (const auto &child : children)
+    {
+        child(writer);
+    }
+    writer.endNode();
+}
+
+SerializedData TrackGroupNode::serialize() const
+{
+    SerializedDataTreeWriter writer;
+    this->serializeTo(writer);
+    return writer.getResult();
+}
+
+void TrackGroupNode::serializeTo(SerializedDataWriter &writer) const
+{
+    writeGroup(writer, this->type, this->name,
+        TreeNodeSerializer::createChildrenWriters(*this));
+}
+
+SerializedSnapshot TrackGroupNode::createSnapshot() const
+{
+    const auto type = this->type;
+    const auto name = this->name;
+    const auto children = TreeNodeSerializer::createChildrenSnapshots(*this);
+
+    return [type, name, children](SerializedDataWriter &writer)
+    {
+        writeGroup(writer, type, name, children);
+    };
+}
+
+void TrackGroupNode::deserializeFrom(SerializedDataReader &reader)
+{
+    const auto header = reader.readNodeHeader();
+    this->name = header.getProperty(Serialization::Core::treeNodeName);
+    TreeNodeSerializer::deserializeChildren(*this, reader);
+}
@@ -44,4 +44,13 @@ public:
     bool hasMenu() const noexcept override;
     UniquePointer<Component> createMenu() override;
 
+    //===------------------------------------------------------------------===//
+    // Serializable
+    //===------------------------------------------------------------------===//
+
+    SerializedData serialize() const override;
+    void serializeTo(SerializedDataWriter &writer) const override;
+    SerializedSnapshot createSnapshot() const override;
+    void deserializeFrom(SerializedDataReader &reader) override;
+
 };
@@ -40,6 +40,39 @@ void TreeNodeSerializer::serializeChildren(const TreeNode &parentItem, Serialize
     }
 }
 
+Array<SerializedSnapshot> TreeNodeSerializer::createChildrenSnapshots(const TreeNode &parentItem)
+{
+    Array<SerializedSnapshot> result;
+    for (int i = 0; i < parentItem.getNumChildren(); ++i)
+    {
+        if (auto *sub = parentItem.getChild(i))
+        {
+            auto *treeItem = static_cast<TreeNode *>(sub);
+            result.add(treeItem->createSnapshot());
+        }
+    }
+
+    return result;
+}
+
+Array<SerializedSnapshot> TreeNodeSerializer::createChildrenWriters(const TreeNode &parentItem)
+{
+    Array<SerializedSnapshot> result;
+    for (int i = 0; i < parentItem.getNumChildren(); ++i)
+    {
+        if (auto *sub = parentItem.getChild(i))
+        {
+            const auto *treeItem = static_cast<TreeNode *>(sub);
+            result.add([treeItem](SerializedDataWriter &writer)
+            {
+                treeItem->serializeTo(writer);
+            });
+        }
+    }
+
+    return result;
+}
+
 void TreeNodeSerializer::deserializeChildren(TreeNode &parentItem, const SerializedData &parent)
 {
     using namespace Serialization;
@@ -47,23 +80,58 @@ void TreeNodeSerializer::deserializeChildren(TreeNode &parentItem, const Seriali
     forEachChildWithType(parent, e, Core::treeNode)
     {
         const auto type = Identifier(e.getProperty(Core::treeNodeType));
-
-        TreeNode *child = nullptr;
-
-        if (type == Core::project)              { child = new ProjectNode(); }
-        else if (type == Core::settings)        { child = new SettingsNode(); }
-        else if (type == Core::trackGroup)      { child = new TrackGroupNode(""); }
-        else if (type == Core::pianoTrack)      { child = new PianoTrackNode(""); }
-        else if (type == Core::automationTrack) { child = new AutomationTrackNode(""); }
-        else if (type == Core::instrumentsList) { child = new OrchestraPitNode(); }
-        else if (type == Core::instrumentRoot)  { child = new InstrumentNode(); }
-        else if (type == Core::versionControl)  { child = new VersionControlNode(); }
-        else if (type == Core::patternSet)      { child = new PatternEditorNode(); }
-
-        if (child != nullptr)
+        if (auto *child = createNodeOfType(type))
         {
             parentItem.addChildNode(child);
             child->deserialize(e);
         }
     }
 }
+
+void TreeNodeSerializer::deserializeChildren(TreeNode &parentItem, SerializedDataReader &reader)
+{
+    const auto numChildren = reader.readNumChildren();
+    for (int i = 0; i < numChildren; ++i)
+    {
+        deserializeChild(parentItem, reader);
+    }
+}
+
+void TreeNodeSerializer::deserializeChild(TreeNode &parentItem, SerializedDataReader &reader)
+{
+    using namespace Serialization;
+
+    if (!reader.isNodeOfType(Core::treeNode))
+    {
+        reader.skipTree();
+        return;
+    }
+
+    const auto type = Identifier(reader.peekProperty(Core::treeNodeType));
+    if (auto *child = createNodeOfType(type))
+    {
+        parentItem.addChildNode(child, -1, false);
+        child->deserializeFrom(reader);
+    }
+    else
+    {
+        reader.skipTree();
+    }
+}
+
+TreeNode *TreeNodeSerializer::createNodeOfType(const Identifier &type)
+{
+    using namespace Serialization;
+
+    if (type == Core::project)              { return new ProjectNode(); }
+    else if (type == Core::settings)        { return new SettingsNode(); }
+    else if (type == Core::trackGroup)      { return new TrackGroupNode(""); }
+    else if (type == Core::pianoTrack)      { return new PianoTrackNode(""); }
+    else if (type == Core::automationTrack) { return new AutomationTrackNode(""); }
+    else if (type == Core::instrumentsList) { return new OrchestraPitNode(); }
+    else if (type == Core::instrumentRoot)  { return new InstrumentNode(); }
+    else if (type == Core::versionControl)  { return new VersionControlNode(); }
+    else if (type == Core::patternSet)      { return new PatternEditorNode(); }
+
+    return nullptr;
+}
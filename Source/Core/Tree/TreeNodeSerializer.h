@@ -24,5 +24,24 @@ class TreeNodeSerializer
 public:
 
     static void serializeChildren(const TreeNode &parentItem, SerializedData &parent);
+    static Array<SerializedSnapshot> createChildrenSnapshots(const TreeNode &parentItem);
+
+    // same as createChildrenSnapshots(), but writes the children as they are,
+    // so that the synchronous saves and the snapshots share the same layout;
+    // these can only be called right away, while the children don't change
+    static Array<SerializedSnapshot> createChildrenWriters(const TreeNode &parentItem);
+
     static void deserializeChildren(TreeNode &parentItem, const SerializedData &parent);
+
+    // reads the number of children after the node header, then the child nodes;
+    // the streamed reading is only used for loading the whole project, and
+    // the sequences might still be read in background at this point, so the
+    // children are attached silently: the project registers all tracks and
+    // broadcasts reloading its content after everything is loaded
+    static void deserializeChildren(TreeNode &parentItem, SerializedDataReader &reader);
+    static void deserializeChild(TreeNode &parentItem, SerializedDataReader &reader);
+
+private:
+
+    static TreeNode *createNodeOfType(const Identifier &type);
 };
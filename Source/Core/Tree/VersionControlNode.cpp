@@ -231,6 +231,33 @@ SerializedData VersionControlNode::serialize() const
     return tree;
 }
 
+SerializedSnapshot VersionControlNode::createSnapshot() const
+{
+    const auto type = this->type;
+    const auto vcs = this->vcs != nullptr ?
+        this->vcs->createSnapshot() : SerializedSnapshot();
+    const auto children = TreeNodeSerializer::createChildrenSnapshots(*this);
+
+    return [type, vcs, children](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::Core::treeNode, 1,
+            (vcs != nullptr ? 1 : 0) + children.size());
+        writer.writeProperty(Serialization::Core::treeNodeType, type);
+
+        if (vcs != nullptr)
+        {
+            vcs(writer);
+        }
+
+        for (const auto &child : children)
+        {
+            child(writer);
+        }
+
+        writer.endNode();
+    };
+}
+
 void VersionControlNode::deserialize(const SerializedData &data)
 {
     this->reset();
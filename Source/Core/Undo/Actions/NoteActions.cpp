@@ -476,8 +476,59 @@ int NotesGroupChangeAction::getSizeInUnits()
         (sizeof(Note) * this->notesAfter.size());
 }
 
+// picks the compact transform when the change allows it:
+static UndoAction *createGroupChangeAction(MidiTrackSource &source,
+    const String &trackId, Array<Note> &groupBefore, Array<Note> &groupAfter)
+{
+    if (auto *transform = NotesGroupTransformAction::tryCreate(source,
+        trackId, groupBefore, groupAfter))
+    {
+        return transform;
+    }
+
+    return new NotesGroupChangeAction(source, trackId, groupBefore, groupAfter);
+}
+
+static bool haveSameIds(const Array<Note> &notes, const Array<MidiEvent::Id> &ids) noexcept
+{
+    if (notes.size() != ids.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < notes.size(); ++i)
+    {
+        if (notes.getReference(i).getId() != ids.getUnchecked(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 UndoAction *NotesGroupChangeAction::createCoalescedAction(UndoAction *nextAction)
 {
+    if (auto *nextTransform = dynamic_cast<NotesGroupTransformAction *>(nextAction))
+    {
+        if (nextTransform->trackId != this->trackId ||
+            !haveSameIds(this->notesAfter, nextTransform->noteIds))
+        {
+            return nullptr;
+        }
+
+        // the transform was created from exactly this group's final state
+        Array<Note> groupBefore(this->notesBefore);
+        Array<Note> groupAfter;
+        groupAfter.ensureStorageAllocated(this->notesAfter.size());
+        for (const auto &note : this->notesAfter)
+        {
+            groupAfter.add(nextTransform->transformed(note, true));
+        }
+
+        return createGroupChangeAction(this->source, this->trackId, groupBefore, groupAfter);
+    }
+
     if (auto *nextChanger = dynamic_cast<NotesGroupChangeAction *>(nextAction))
     {
         if (nextChanger->trackId != this->trackId)
@@ -566,3 +617,390 @@ void NotesGroupChangeAction::reset()
     this->notesAfter.clear();
     this->trackId.clear();
 }
+
+//===----------------------------------------------------------------------===//
+// Transform Group
+//===----------------------------------------------------------------------===//
+
+static bool areNotesIdentical(const Note &a, const Note &b) noexcept
+{
+    return a.getId() == b.getId() &&
+        a.getKey() == b.getKey() &&
+        a.getBeat() == b.getBeat() &&
+        a.getLength() == b.getLength() &&
+        a.getVelocity() == b.getVelocity() &&
+        a.getTuplet() == b.getTuplet();
+}
+
+NotesGroupTransformAction *NotesGroupTransformAction::tryCreate(MidiTrackSource &source,
+    const String &trackId, const Array<Note> &groupBefore, const Array<Note> &groupAfter)
+{
+    if (groupBefore.size() < NotesGroupTransformAction::minGroupSize ||
+        groupBefore.size() != groupAfter.size())
+    {
+        return nullptr;
+    }
+
+    UniquePointer<NotesGroupTransformAction> action(new NotesGroupTransformAction(source));
+    action->trackId = trackId;
+
+    const auto &firstBefore = groupBefore.getReference(0);
+    const auto &firstAfter = groupAfter.getReference(0);
+    action->deltaKey = firstAfter.getKey() - firstBefore.getKey();
+    action->deltaBeat = firstAfter.getBeat() - firstBefore.getBeat();
+    action->deltaLength = firstAfter.getLength() - firstBefore.getLength();
+    action->deltaVelocity = firstAfter.getVelocity() - firstBefore.getVelocity();
+
+    // the notes are found by their exact parameters in the sequence,
+    // so the transform must reproduce both states bit by bit,
+    // including all the rounding and clamping in the Note's methods
+    action->noteIds.ensureStorageAllocated(groupBefore.size());
+    for (int i = 0; i < groupBefore.size(); ++i)
+    {
+        const auto &before = groupBefore.getReference(i);
+        const auto &after = groupAfter.getReference(i);
+
+        if (!areNotesIdentical(action->transformed(before, true), after) ||
+            !areNotesIdentical(action->transformed(after, false), before))
+        {
+            return nullptr;
+        }
+
+        action->noteIds.add(before.getId());
+    }
+
+    return action.release();
+}
+
+Note NotesGroupTransformAction::transformed(const Note &note, bool forward) const noexcept
+{
+    const auto sign = forward ? 1 : -1;
+    return note
+        .withDeltaKey(this->deltaKey * sign)
+        .withDeltaBeat(this->deltaBeat * float(sign))
+        .withDeltaLength(this->deltaLength * float(sign))
+        .withDeltaVelocity(this->deltaVelocity * float(sign));
+}
+
+bool NotesGroupTransformAction::findNotes(const PianoSequence &sequence, Array<Note> &result) const
+{
+    FlatHashMap<MidiEvent::Id, const Note *> notesById;
+    notesById.reserve(size_t(sequence.size()));
+    for (const auto *event : sequence)
+    {
+        notesById[event->getId()] = static_cast<const Note *>(event);
+    }
+
+    result.ensureStorageAllocated(this->noteIds.size());
+    for (const auto &id : this->noteIds)
+    {
+        const auto found = notesById.find(id);
+        if (found == notesById.end())
+        {
+            jassertfalse;
+            return false;
+        }
+
+        result.add(*found->second);
+    }
+
+    return true;
+}
+
+bool NotesGroupTransformAction::apply(bool forward)
+{
+    if (PianoSequence *sequence =
+        this->source.findSequenceByTrackId<PianoSequence>(this->trackId))
+    {
+        Array<Note> groupBefore;
+        if (!this->findNotes(*sequence, groupBefore))
+        {
+            return false;
+        }
+
+        Array<Note> groupAfter;
+        groupAfter.ensureStorageAllocated(groupBefore.size());
+        for (const auto &note : groupBefore)
+        {
+            groupAfter.add(this->transformed(note, forward));
+        }
+
+        return sequence->changeGroup(groupBefore, groupAfter, false);
+    }
+
+    return false;
+}
+
+bool NotesGroupTransformAction::perform()
+{
+    return this->apply(true);
+}
+
+bool NotesGroupTransformAction::undo()
+{
+    return this->apply(false);
+}
+
+int NotesGroupTransformAction::getSizeInUnits()
+{
+    return sizeof(Note) + (sizeof(MidiEvent::Id) * this->noteIds.size());
+}
+
+UndoAction *NotesGroupTransformAction::createCoalescedAction(UndoAction *nextAction)
+{
+    if (auto *nextChanger = dynamic_cast<NotesGroupChangeAction *>(nextAction))
+    {
+        if (nextChanger->trackId != this->trackId ||
+            !haveSameIds(nextChanger->notesBefore, this->noteIds))
+        {
+            return nullptr;
+        }
+
+        // the change starts from this transform's result,
+        // so the initial state is that result transformed backwards
+        Array<Note> groupBefore;
+        groupBefore.ensureStorageAllocated(nextChanger->notesBefore.size());
+        for (const auto &note : nextChanger->notesBefore)
+        {
+            groupBefore.add(this->transformed(note, false));
+        }
+
+        Array<Note> groupAfter(nextChanger->notesAfter);
+        return createGroupChangeAction(this->source, this->trackId, groupBefore, groupAfter);
+    }
+
+    auto *nextTransform = dynamic_cast<NotesGroupTransformAction *>(nextAction);
+    if (nextTransform == nullptr ||
+        nextTransform->trackId != this->trackId ||
+        nextTransform->noteIds != this->noteIds)
+    {
+        return nullptr;
+    }
+
+    PianoSequence *sequence = this->source.findSequenceByTrackId<PianoSequence>(this->trackId);
+    if (sequence == nullptr)
+    {
+        return nullptr;
+    }
+
+    // both actions are already performed, so the sequence has the final state,
+    // and the initial one is restored by applying both transforms backwards
+    Array<Note> groupAfter;
+    if (!nextTransform->findNotes(*sequence, groupAfter))
+    {
+        return nullptr;
+    }
+
+    Array<Note> groupBefore;
+    groupBefore.ensureStorageAllocated(groupAfter.size());
+    for (const auto &note : groupAfter)
+    {
+        groupBefore.add(this->transformed(nextTransform->transformed(note, false), false));
+    }
+
+    // the summed deltas might not be reversible, then it just keeps the copies
+    return createGroupChangeAction(this->source, this->trackId, groupBefore, groupAfter);
+}
+
+//===----------------------------------------------------------------------===//
+// Serializable
+//===----------------------------------------------------------------------===//
+
+SerializedData NotesGroupTransformAction::serialize() const
+{
+    SerializedData tree(Serialization::Undo::notesGroupTransformAction);
+    tree.setProperty(Serialization::Undo::trackId, this->trackId);
+    tree.setProperty(Serialization::Undo::deltaKey, this->deltaKey);
+    tree.setProperty(Serialization::Undo::deltaBeat, this->deltaBeat);
+    tree.setProperty(Serialization::Undo::deltaLength, this->deltaLength);
+    tree.setProperty(Serialization::Undo::deltaVelocity, this->deltaVelocity);
+
+    MemoryOutputStream ids;
+    for (int i = 0; i < this->noteIds.size(); ++i)
+    {
+        if (i > 0) { ids << ' '; }
+        ids << MidiEvent::packId(this->noteIds.getUnchecked(i));
+    }
+
+    tree.setProperty(Serialization::Undo::noteIds, ids.toUTF8());
+    return tree;
+}
+
+void NotesGroupTransformAction::deserialize(const SerializedData &data)
+{
+    this->reset();
+
+    this->trackId = data.getProperty(Serialization::Undo::trackId);
+    this->deltaKey = data.getProperty(Serialization::Undo::deltaKey);
+    this->deltaBeat = data.getProperty(Serialization::Undo::deltaBeat);
+    this->deltaLength = data.getProperty(Serialization::Undo::deltaLength);
+    this->deltaVelocity = data.getProperty(Serialization::Undo::deltaVelocity);
+
+    const String ids = data.getProperty(Serialization::Undo::noteIds);
+    for (const auto &id : StringArray::fromTokens(ids, " ", ""))
+    {
+        this->noteIds.add(MidiEvent::unpackId(id));
+    }
+}
+
+void NotesGroupTransformAction::reset()
+{
+    this->noteIds.clear();
+    this->trackId.clear();
+    this->deltaKey = 0;
+    this->deltaBeat = 0.f;
+    this->deltaLength = 0.f;
+    this->deltaVelocity = 0.f;
+}
+
+//===----------------------------------------------------------------------===//
+// Tests
+//===----------------------------------------------------------------------===//
+
+#if JUCE_UNIT_TESTS
+
+class NoteActionsTests final : public UnitTest
+{
+public:
+    NoteActionsTests() : UnitTest("Note actions tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        EmptyMidiTrack track;
+        EmptyEventDispatcher dispatcher;
+        PianoSequence sequence(track, dispatcher);
+        SequenceSource source(sequence);
+
+        for (int i = 0; i < numNotes; ++i)
+        {
+            const Note note(&sequence, 60 + i % 12, float(i), 1.f, 0.5f);
+            sequence.importMidiEvent<Note>(note);
+        }
+
+        const auto initialState = getNotes(sequence);
+
+        beginTest("Group transform undo and redo");
+
+        Array<Note> transposed;
+        for (const auto &note : initialState)
+        {
+            transposed.add(note.withDeltaKey(2));
+        }
+
+        UniquePointer<NotesGroupTransformAction> transform(NotesGroupTransformAction::tryCreate(source,
+            trackId, initialState, transposed));
+
+        expect(transform != nullptr);
+        expect(transform->perform());
+        this->expectNotes(sequence, transposed);
+        expect(transform->undo());
+        this->expectNotes(sequence, initialState);
+        expect(transform->perform());
+        this->expectNotes(sequence, transposed);
+
+        beginTest("Group transform coalesces with the next group change");
+
+        auto changeBefore = transposed;
+        auto changeAfter = withUnevenVelocities(transposed);
+        UniquePointer<NotesGroupChangeAction> change(new NotesGroupChangeAction(source,
+            trackId, changeBefore, changeAfter));
+
+        expect(change->perform());
+        const auto transformedAndChanged = getNotes(sequence);
+
+        UniquePointer<UndoAction> coalesced(transform->createCoalescedAction(change.get()));
+        expect(coalesced != nullptr);
+        expect(coalesced->undo());
+        this->expectNotes(sequence, initialState);
+        expect(coalesced->perform());
+        this->expectNotes(sequence, transformedAndChanged);
+        expect(coalesced->undo());
+
+        beginTest("Group change coalesces with the next group transform");
+
+        changeBefore = initialState;
+        changeAfter = withUnevenVelocities(initialState);
+        change.reset(new NotesGroupChangeAction(source, trackId, changeBefore, changeAfter));
+        expect(change->perform());
+
+        const auto changed = getNotes(sequence);
+        Array<Note> changedAndTransposed;
+        for (const auto &note : changed)
+        {
+            changedAndTransposed.add(note.withDeltaKey(-3));
+        }
+
+        transform.reset(NotesGroupTransformAction::tryCreate(source,
+            trackId, changed, changedAndTransposed));
+
+        expect(transform != nullptr);
+        expect(transform->perform());
+
+        coalesced.reset(change->createCoalescedAction(transform.get()));
+        expect(coalesced != nullptr);
+        expect(coalesced->undo());
+        this->expectNotes(sequence, initialState);
+        expect(coalesced->perform());
+        this->expectNotes(sequence, changedAndTransposed);
+    }
+
+private:
+
+    static constexpr auto numNotes = NotesGroupTransformAction::minGroupSize * 2;
+    const String trackId = "track";
+
+    class SequenceSource final : public EmptyMidiTrackSource
+    {
+    public:
+
+        explicit SequenceSource(PianoSequence &sequence) : sequence(sequence) {}
+
+    protected:
+
+        MidiSequence *getSequenceByTrackId(const String &trackId) override
+        {
+            return &this->sequence;
+        }
+
+    private:
+
+        PianoSequence &sequence;
+    };
+
+    static Array<Note> getNotes(const PianoSequence &sequence)
+    {
+        Array<Note> result;
+        for (const auto *event : sequence)
+        {
+            result.add(*static_cast<const Note *>(event));
+        }
+
+        return result;
+    }
+
+    // different velocities can't be stored as a transform
+    static Array<Note> withUnevenVelocities(const Array<Note> &notes)
+    {
+        Array<Note> result;
+        for (int i = 0; i < notes.size(); ++i)
+        {
+            result.add(notes.getReference(i).withVelocity(0.25f + float(i % 4) * 0.125f));
+        }
+
+        return result;
+    }
+
+    void expectNotes(const PianoSequence &sequence, const Array<Note> &expected)
+    {
+        const auto actual = getNotes(sequence);
+        expectEquals(actual.size(), expected.size());
+        for (int i = 0; i < jmin(actual.size(), expected.size()); ++i)
+        {
+            expect(areNotesIdentical(actual.getReference(i), expected.getReference(i)));
+        }
+    }
+};
+
+static NoteActionsTests noteActionsTests;
+
+#endif
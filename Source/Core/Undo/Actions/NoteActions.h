@@ -214,5 +214,59 @@ private:
     Array<Note> notesBefore;
     Array<Note> notesAfter;
 
+    friend class NotesGroupTransformAction;
+
     JUCE_DECLARE_NON_COPYABLE(NotesGroupChangeAction)
 };
+
+//===----------------------------------------------------------------------===//
+// Transform Group
+//===----------------------------------------------------------------------===//
+
+// A compact alternative to NotesGroupChangeAction for the bulk edits,
+// which move all notes by the same offsets, like transposing or shifting:
+// it only keeps the note ids and the deltas, and finds the notes by ids
+// when performing; it is only created when applying the deltas back and forth
+// gives exactly the same notes as the full copies would, see tryCreate()
+
+class NotesGroupTransformAction final : public UndoAction
+{
+public:
+
+    explicit NotesGroupTransformAction(MidiTrackSource &source) noexcept :
+        UndoAction(source) {}
+
+    // returns nullptr, if the change isn't an exactly reversible transform
+    static NotesGroupTransformAction *tryCreate(MidiTrackSource &source,
+        const String &trackId, const Array<Note> &groupBefore, const Array<Note> &groupAfter);
+
+    bool perform() override;
+    bool undo() override;
+    int getSizeInUnits() override;
+    UndoAction *createCoalescedAction(UndoAction *nextAction) override;
+
+    SerializedData serialize() const override;
+    void deserialize(const SerializedData &data) override;
+    void reset() override;
+
+    // smaller groups are cheap to keep as full copies
+    static constexpr int minGroupSize = 32;
+
+private:
+
+    Note transformed(const Note &note, bool forward) const noexcept;
+    bool findNotes(const PianoSequence &sequence, Array<Note> &result) const;
+    bool apply(bool forward);
+
+    String trackId;
+    Array<MidiEvent::Id> noteIds;
+
+    Note::Key deltaKey = 0;
+    float deltaBeat = 0.f;
+    float deltaLength = 0.f;
+    float deltaVelocity = 0.f;
+
+    friend class NotesGroupChangeAction;
+
+    JUCE_DECLARE_NON_COPYABLE(NotesGroupTransformAction)
+};
@@ -19,6 +19,8 @@
 
 class MidiTrackSource;
 
+#include "UndoActionPool.h"
+
 class UndoAction : public Serializable
 {
 public:
@@ -39,6 +41,16 @@ public:
         (void) nextAction;
         return nullptr;
     }
+
+    static void *operator new(size_t size)
+    {
+        return UndoActionPool::allocate(size);
+    }
+
+    static void operator delete(void *block, size_t size) noexcept
+    {
+        UndoActionPool::deallocate(block, size);
+    }
     
 protected:
     
@@ -0,0 +1,245 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "UndoActionPool.h"
+
+UndoActionPool &UndoActionPool::getInstance()
+{
+    static UndoActionPool pool;
+    return pool;
+}
+
+UndoActionPool::~UndoActionPool()
+{
+    for (auto &bucket : this->buckets)
+    {
+        for (auto *chunk : bucket.chunks)
+        {
+            std::free(chunk);
+        }
+    }
+}
+
+void *UndoActionPool::allocate(size_t size)
+{
+    if (size == 0 || size > maxBlockSize)
+    {
+        return ::operator new(size);
+    }
+
+    const auto bucketIndex = (size - 1) / blockSizeGranularity;
+    const auto blockSize = (bucketIndex + 1) * blockSizeGranularity;
+    auto &bucket = getInstance().buckets[bucketIndex];
+
+    const SpinLock::ScopedLockType lock(bucket.lock);
+
+    if (bucket.freeBlocks == nullptr)
+    {
+        const auto numBlocks = getNumBlocksInChunk(blockSize);
+        auto *chunk = static_cast<char *>(std::malloc(numBlocks * blockSize));
+        if (chunk == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        bucket.chunks.add(chunk);
+
+        for (auto i = numBlocks; i-- > 0;)
+        {
+            auto *block = reinterpret_cast<FreeBlock *>(chunk + i * blockSize);
+            block->next = bucket.freeBlocks;
+            bucket.freeBlocks = block;
+        }
+    }
+
+    auto *block = bucket.freeBlocks;
+    bucket.freeBlocks = block->next;
+    return block;
+}
+
+void UndoActionPool::deallocate(void *block, size_t size) noexcept
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+
+    if (size == 0 || size > maxBlockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    auto &bucket = getInstance().buckets[(size - 1) / blockSizeGranularity];
+
+    const SpinLock::ScopedLockType lock(bucket.lock);
+
+    auto *freeBlock = static_cast<FreeBlock *>(block);
+    freeBlock->next = bucket.freeBlocks;
+    bucket.freeBlocks = freeBlock;
+}
+
+void UndoActionPool::releaseUnusedChunks()
+{
+    auto &pool = getInstance();
+
+    for (size_t bucketIndex = 0; bucketIndex < numBuckets; ++bucketIndex)
+    {
+        auto &bucket = pool.buckets[bucketIndex];
+        const auto blockSize = (bucketIndex + 1) * blockSizeGranularity;
+        const auto numBlocksInChunk = getNumBlocksInChunk(blockSize);
+        const auto chunkBytes = numBlocksInChunk * blockSize;
+
+        const SpinLock::ScopedLockType lock(bucket.lock);
+
+        if (bucket.chunks.isEmpty())
+        {
+            continue;
+        }
+
+        // sorted by address, so that each free block's chunk is found quickly
+        std::sort(bucket.chunks.begin(), bucket.chunks.end(), std::less<void *>());
+
+        const auto findChunkIndex = [&bucket, chunkBytes](const FreeBlock *block)
+        {
+            const auto *address = reinterpret_cast<const char *>(block);
+            const auto found = std::upper_bound(bucket.chunks.begin(), bucket.chunks.end(),
+                address, [](const char *a, void *chunk) { return a < static_cast<const char *>(chunk); });
+
+            const auto chunkIndex = int(found - bucket.chunks.begin()) - 1;
+            jassert(chunkIndex >= 0 && address <
+                static_cast<const char *>(bucket.chunks.getUnchecked(chunkIndex)) + chunkBytes);
+            return chunkIndex;
+        };
+
+        Array<size_t> numFreeBlocks;
+        numFreeBlocks.insertMultiple(0, 0, bucket.chunks.size());
+
+        for (auto *block = bucket.freeBlocks; block != nullptr; block = block->next)
+        {
+            numFreeBlocks.getReference(findChunkIndex(block))++;
+        }
+
+        // the blocks of the chunks to be released are dropped from the free list
+        FreeBlock *remainingFreeBlocks = nullptr;
+        for (auto *block = bucket.freeBlocks; block != nullptr;)
+        {
+            auto *next = block->next;
+            if (numFreeBlocks[findChunkIndex(block)] != numBlocksInChunk)
+            {
+                block->next = remainingFreeBlocks;
+                remainingFreeBlocks = block;
+            }
+
+            block = next;
+        }
+
+        bucket.freeBlocks = remainingFreeBlocks;
+
+        for (int i = bucket.chunks.size(); i-- > 0;)
+        {
+            if (numFreeBlocks[i] == numBlocksInChunk)
+            {
+                std::free(bucket.chunks.getUnchecked(i));
+                bucket.chunks.remove(i);
+            }
+        }
+    }
+}
+
+#if JUCE_UNIT_TESTS
+
+class UndoActionPoolTests final : public UnitTest
+{
+public:
+    UndoActionPoolTests() : UnitTest("Undo action pool tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        beginTest("Reusing freed blocks");
+
+        auto *first = UndoActionPool::allocate(40);
+        auto *second = UndoActionPool::allocate(48);
+        expect(first != second);
+
+        UndoActionPool::deallocate(first, 40);
+        expect(UndoActionPool::allocate(33) == first);
+
+        Array<void *> blocks;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto *block = UndoActionPool::allocate(size_t(i % 600 + 1));
+            zeromem(block, size_t(i % 600 + 1));
+            expect(!blocks.contains(block));
+            blocks.add(block);
+        }
+
+        for (int i = 0; i < blocks.size(); ++i)
+        {
+            UndoActionPool::deallocate(blocks.getUnchecked(i), size_t(i % 600 + 1));
+        }
+
+        UndoActionPool::deallocate(first, 40);
+        UndoActionPool::deallocate(second, 48);
+
+        beginTest("Releasing unused chunks");
+
+        // a bucket used by nothing else, so that all its chunks are known here,
+        // these go to the 512-byte blocks, 32 of them in a chunk
+        constexpr size_t blockSize = 500;
+        constexpr int numBlocksInChunk = 32;
+
+        Array<void *> manyBlocks;
+        for (int i = 0; i < 100; ++i)
+        {
+            manyBlocks.add(UndoActionPool::allocate(blockSize));
+        }
+
+        auto *inUse = manyBlocks.removeAndReturn(50);
+        for (auto *block : manyBlocks)
+        {
+            UndoActionPool::deallocate(block, blockSize);
+        }
+
+        UndoActionPool::releaseUnusedChunks();
+
+        // only the chunk with the block in use is kept, and its free blocks
+        // are still reused, while the released ones are not in the free list
+        Array<void *> reused;
+        for (int i = 0; i < numBlocksInChunk - 1; ++i)
+        {
+            auto *block = UndoActionPool::allocate(blockSize);
+            expect(block != inUse);
+            expect(std::abs(static_cast<char *>(block) - static_cast<char *>(inUse)) <
+                numBlocksInChunk * int(blockSize));
+            reused.add(block);
+        }
+
+        for (auto *block : reused)
+        {
+            UndoActionPool::deallocate(block, blockSize);
+        }
+
+        UndoActionPool::deallocate(inUse, blockSize);
+        UndoActionPool::releaseUnusedChunks();
+    }
+};
+
+static UndoActionPoolTests undoActionPoolTests;
+
+#endif
@@ -0,0 +1,70 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Editing sessions create and trim lots of undo actions, and all of them
+// are of a few different sizes, so instead of going to the heap every time,
+// they are allocated from the fixed-size blocks, which are taken from
+// big chunks and are reused as soon as the actions are deleted;
+// this keeps the heap from fragmenting and the memory usage from creeping up
+
+class UndoActionPool final
+{
+public:
+
+    static void *allocate(size_t size);
+    static void deallocate(void *block, size_t size) noexcept;
+
+    // gives the chunks with no blocks in use back to the system,
+    // called when the undo history is cleared or deleted
+    static void releaseUnusedChunks();
+
+    ~UndoActionPool();
+
+private:
+
+    UndoActionPool() = default;
+    static UndoActionPool &getInstance();
+
+    struct FreeBlock final
+    {
+        FreeBlock *next;
+    };
+
+    struct Bucket final
+    {
+        SpinLock lock;
+        FreeBlock *freeBlocks = nullptr;
+        Array<void *> chunks;
+    };
+
+    static constexpr size_t blockSizeGranularity = 16;
+    static constexpr size_t maxBlockSize = 512;
+    static constexpr size_t chunkSize = 16 * 1024;
+    static constexpr size_t numBuckets = maxBlockSize / blockSizeGranularity;
+
+    static size_t getNumBlocksInChunk(size_t blockSize) noexcept
+    {
+        return jmax(size_t(8), chunkSize / blockSize);
+    }
+
+    Bucket buckets[numBuckets];
+
+    JUCE_DECLARE_NON_COPYABLE(UndoActionPool)
+};
+
@@ -0,0 +1,356 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "UndoJournal.h"
+#include "DocumentHelpers.h"
+
+// record layout: type, stamp, payload size, payload
+static constexpr int32 journalTransactionRecord = 0x52544a55; // "UJTR"
+static constexpr int32 journalResetRecord = 0x53524a55; // "UJRS"
+static constexpr int64 journalRecordHeaderSize = 16;
+
+// old records are only thrown away when there are way too many of them
+static constexpr int journalCompactionFactor = 4;
+
+UndoJournal::UndoJournal(const File &file) :
+    file(file) {}
+
+File UndoJournal::getFileFor(const File &projectFile)
+{
+    const auto pathHash = String::toHexString(projectFile.getFullPathName().hashCode64());
+    return DocumentHelpers::getConfigSlot("UndoHistory/" +
+        projectFile.getFileNameWithoutExtension() + "-" + pathHash + ".undo");
+}
+
+const File &UndoJournal::getFile() const noexcept
+{
+    return this->file;
+}
+
+int UndoJournal::getNumRecords()
+{
+    this->scanIfNeeded();
+    return this->records.size();
+}
+
+UndoJournal::Stamp UndoJournal::getRecordStamp(int recordIndex) const noexcept
+{
+    if (isPositiveAndBelow(recordIndex, this->records.size()))
+    {
+        return this->records.getReference(recordIndex).stamp;
+    }
+
+    return 0;
+}
+
+UndoJournal::Stamp UndoJournal::writeTransaction(int recordIndex, const SerializedData &transaction)
+{
+    MemoryOutputStream payload;
+    transaction.writeToStream(payload);
+    return this->writeRecord(recordIndex, journalTransactionRecord, payload.getMemoryBlock());
+}
+
+bool UndoJournal::writeResetMarker()
+{
+    return this->writeRecord(this->getNumRecords(), journalResetRecord, {}) != 0;
+}
+
+UndoJournal::Stamp UndoJournal::writeRecord(int recordIndex, int32 type, const MemoryBlock &payload)
+{
+    this->scanIfNeeded();
+
+    recordIndex = jlimit(0, this->records.size(), recordIndex);
+    const auto offset = recordIndex < this->records.size() ?
+        this->records.getReference(recordIndex).offset : this->endOffset;
+
+    if (!this->file.getParentDirectory().createDirectory())
+    {
+        return 0;
+    }
+
+    FileOutputStream out(this->file);
+    if (!out.openedOk() || !out.setPosition(offset) || out.truncate().failed())
+    {
+        return 0;
+    }
+
+    this->records.removeRange(recordIndex, this->records.size() - recordIndex);
+    this->endOffset = offset;
+
+    Stamp stamp = 0;
+    while (stamp == 0)
+    {
+        stamp = Random::getSystemRandom().nextInt64();
+    }
+
+    out.writeInt(type);
+    out.writeInt64(stamp);
+    out.writeInt(int(payload.getSize()));
+    if (payload.getSize() > 0)
+    {
+        out.write(payload.getData(), payload.getSize());
+    }
+
+    out.flush();
+
+    if (out.getStatus().failed())
+    {
+        // the broken tail will be overwritten by the next record
+        return 0;
+    }
+
+    this->records.add({ offset, int32(payload.getSize()), stamp, type == journalResetRecord });
+    this->endOffset = out.getPosition();
+    return stamp;
+}
+
+void UndoJournal::scanIfNeeded()
+{
+    if (this->isScanned)
+    {
+        return;
+    }
+
+    this->isScanned = true;
+    this->records.clearQuick();
+    this->endOffset = 0;
+
+    FileInputStream in(this->file);
+    if (!in.openedOk())
+    {
+        return;
+    }
+
+    const auto totalLength = in.getTotalLength();
+    for (;;)
+    {
+        const auto offset = in.getPosition();
+        if (totalLength - offset < journalRecordHeaderSize)
+        {
+            break;
+        }
+
+        const auto type = in.readInt();
+        const auto stamp = in.readInt64();
+        const auto payloadSize = in.readInt();
+
+        // stop at the tail which might have been left by a crash
+        if ((type != journalTransactionRecord && type != journalResetRecord) ||
+            payloadSize < 0 || totalLength - in.getPosition() < payloadSize)
+        {
+            break;
+        }
+
+        in.setPosition(in.getPosition() + payloadSize);
+        this->records.add({ offset, payloadSize, stamp, type == journalResetRecord });
+        this->endOffset = in.getPosition();
+    }
+}
+
+int UndoJournal::restore(Stamp lastStamp, int maxRecords, Array<SerializedData> &result)
+{
+    this->scanIfNeeded();
+
+    int lastRecord = -1;
+    for (int i = this->records.size(); --i >= 0;)
+    {
+        const auto &record = this->records.getReference(i);
+        if (!record.isResetMarker && record.stamp == lastStamp)
+        {
+            lastRecord = i;
+            break;
+        }
+    }
+
+    if (lastRecord < 0)
+    {
+        return -1;
+    }
+
+    int firstRecord = lastRecord;
+    while (firstRecord > 0 && (lastRecord - firstRecord + 1) < maxRecords &&
+        !this->records.getReference(firstRecord - 1).isResetMarker)
+    {
+        firstRecord--;
+    }
+
+    FileInputStream in(this->file);
+    if (!in.openedOk())
+    {
+        return -1;
+    }
+
+    for (int i = firstRecord; i <= lastRecord; ++i)
+    {
+        const auto &record = this->records.getReference(i);
+        MemoryBlock payload;
+        in.setPosition(record.offset + journalRecordHeaderSize);
+        if (in.readIntoMemoryBlock(payload, record.payloadSize) != size_t(record.payloadSize))
+        {
+            result.clearQuick();
+            return -1;
+        }
+
+        result.add(SerializedData::readFromData(payload.getData(), payload.getSize()));
+    }
+
+    // whatever follows wasn't saved with the project, so it doesn't apply,
+    // and it will be truncated when the next record is written:
+    if (lastRecord + 1 < this->records.size())
+    {
+        this->endOffset = this->records.getReference(lastRecord + 1).offset;
+        this->records.removeRange(lastRecord + 1, this->records.size() - lastRecord - 1);
+    }
+
+    return firstRecord - this->trim(firstRecord, maxRecords);
+}
+
+int UndoJournal::trim(int firstRecordToKeep, int maxRecords)
+{
+    this->scanIfNeeded();
+
+    if (firstRecordToKeep <= maxRecords * journalCompactionFactor ||
+        firstRecordToKeep >= this->records.size())
+    {
+        return 0;
+    }
+
+    return this->compact(firstRecordToKeep) ? firstRecordToKeep : 0;
+}
+
+bool UndoJournal::compact(int firstRecordToKeep)
+{
+    jassert(firstRecordToKeep < this->records.size());
+    const auto startOffset = this->records.getReference(firstRecordToKeep).offset;
+
+    TemporaryFile tempFile(this->file);
+
+    {
+        FileInputStream in(this->file);
+        FileOutputStream out(tempFile.getFile());
+        if (!in.openedOk() || !out.openedOk() || !in.setPosition(startOffset))
+        {
+            return false;
+        }
+
+        const auto numBytes = this->endOffset - startOffset;
+        if (out.writeFromInputStream(in, numBytes) != numBytes)
+        {
+            return false;
+        }
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+    {
+        return false;
+    }
+
+    this->records.removeRange(0, firstRecordToKeep);
+    for (auto &record : this->records)
+    {
+        record.offset -= startOffset;
+    }
+
+    this->endOffset -= startOffset;
+    return true;
+}
+
+#if JUCE_UNIT_TESTS
+
+class UndoJournalTests final : public UnitTest
+{
+public:
+    UndoJournalTests() : UnitTest("Undo journal tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        const TemporaryFile tempFile;
+
+        beginTest("Writing and rewriting records");
+
+        UndoJournal journal(tempFile.getFile());
+        expect(journal.writeResetMarker());
+        expect(journal.writeTransaction(1, transaction(1)) != 0);
+        expect(journal.writeTransaction(2, transaction(2)) != 0);
+        const auto stamp3 = journal.writeTransaction(3, transaction(3));
+        expectEquals(journal.getNumRecords(), 4);
+
+        // rewriting a record drops the ones after it
+        const auto stamp2 = journal.writeTransaction(2, transaction(20));
+        expectEquals(journal.getNumRecords(), 3);
+        expect(journal.getRecordStamp(2) == stamp2);
+
+        beginTest("Restoring records");
+
+        UndoJournal reopened(tempFile.getFile());
+        Array<SerializedData> restored;
+        expectEquals(reopened.restore(stamp3, 10, restored), -1);
+        expectEquals(reopened.restore(stamp2, 10, restored), 1);
+        expectEquals(restored.size(), 2);
+        expect(restored[1].isEquivalentTo(transaction(20)));
+
+        restored.clearQuick();
+        expectEquals(reopened.restore(stamp2, 1, restored), 2);
+        expectEquals(restored.size(), 1);
+
+        beginTest("Reset markers separate histories");
+
+        expect(reopened.writeResetMarker());
+        const auto stamp4 = reopened.writeTransaction(reopened.getNumRecords(), transaction(4));
+
+        restored.clearQuick();
+        expectEquals(UndoJournal(tempFile.getFile()).restore(stamp4, 10, restored), 4);
+        expectEquals(restored.size(), 1);
+        expect(restored[0].isEquivalentTo(transaction(4)));
+
+        beginTest("Trimming old records");
+
+        const TemporaryFile trimmedFile;
+        UndoJournal trimmed(trimmedFile.getFile());
+        UndoJournal::Stamp lastStamp = 0;
+        for (int i = 0; i < 60; ++i)
+        {
+            lastStamp = trimmed.writeTransaction(i, transaction(i));
+        }
+
+        // the records are only dropped when there are too many of them
+        expectEquals(trimmed.trim(30, 10), 0);
+        expectEquals(trimmed.trim(50, 10), 50);
+        expectEquals(trimmed.getNumRecords(), 10);
+
+        restored.clearQuick();
+        expectEquals(UndoJournal(trimmedFile.getFile()).restore(lastStamp, 10, restored), 0);
+        expectEquals(restored.size(), 10);
+        expect(restored[0].isEquivalentTo(transaction(50)));
+    }
+
+private:
+
+    static SerializedData transaction(int value)
+    {
+        SerializedData tree("transaction");
+        SerializedData action("action");
+        action.setProperty("value", value);
+        tree.appendChild(action);
+        return tree;
+    }
+};
+
+static UndoJournalTests undoJournalTests;
+
+#endif
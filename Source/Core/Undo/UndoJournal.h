@@ -0,0 +1,78 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// An append-only file with serialized undo transactions, which allows
+// the project to only save a stamp of its last transaction instead of
+// re-serializing the transactions themselves, and to keep a much deeper history;
+// the records are only ever appended, and when some record is rewritten,
+// e.g. when a new edit discards the redo branch, the file is truncated there;
+// the reset markers separate the histories before and after clearing the undo stack
+
+class UndoJournal final
+{
+public:
+
+    using Stamp = int64;
+
+    explicit UndoJournal(const File &file);
+
+    // each project file has its own journal in the config folder,
+    // so that the copies of the same project don't share the history
+    static File getFileFor(const File &projectFile);
+    const File &getFile() const noexcept;
+
+    int getNumRecords();
+    Stamp getRecordStamp(int recordIndex) const noexcept;
+
+    // writes the transaction at the given index, dropping all records after it,
+    // returns the stamp of the new record, or 0 if the file could not be written
+    Stamp writeTransaction(int recordIndex, const SerializedData &transaction);
+    bool writeResetMarker();
+
+    // finds the record with the given stamp and reads up to maxRecords transactions
+    // ending with it, oldest first; drops all records after it and returns the index
+    // of the first read record, or -1 if the stamp is not found
+    int restore(Stamp lastStamp, int maxRecords, Array<SerializedData> &result);
+
+    // drops the records before the given one, once there are way too many of them,
+    // returns the number of dropped records, so that the callers can shift their indices
+    int trim(int firstRecordToKeep, int maxRecords);
+
+private:
+
+    void scanIfNeeded();
+    Stamp writeRecord(int recordIndex, int32 type, const MemoryBlock &payload);
+    bool compact(int firstRecordToKeep);
+
+    struct Record final
+    {
+        int64 offset;
+        int32 payloadSize;
+        Stamp stamp;
+        bool isResetMarker;
+    };
+
+    const File file;
+
+    Array<Record> records;
+    int64 endOffset = 0;
+    bool isScanned = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UndoJournal)
+};
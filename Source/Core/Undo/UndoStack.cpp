@@ -127,6 +127,7 @@ UndoAction *UndoStack::Transaction::createUndoActionByTag(const Identifier &tagN
     else if (tagName == Undo::notesGroupInsertAction)                { return new NotesGroupInsertAction(this->project); }
     else if (tagName == Undo::notesGroupRemoveAction)                { return new NotesGroupRemoveAction(this->project); }
     else if (tagName == Undo::notesGroupChangeAction)                { return new NotesGroupChangeAction(this->project); }
+    else if (tagName == Undo::notesGroupTransformAction)             { return new NotesGroupTransformAction(this->project); }
     else if (tagName == Undo::annotationEventInsertAction)           { return new AnnotationEventInsertAction(this->project); }
     else if (tagName == Undo::annotationEventRemoveAction)           { return new AnnotationEventRemoveAction(this->project); }
     else if (tagName == Undo::annotationEventChangeAction)           { return new AnnotationEventChangeAction(this->project); }
@@ -164,11 +165,21 @@ UndoStack::UndoStack(ProjectNode &parentProject,
     maxNumUnitsToKeep(maxNumberOfUnitsToKeep),
     minimumTransactionsToKeep(minimumTransactions) {}
 
+UndoStack::~UndoStack()
+{
+    // the actions are deleted first, so that their chunks can be released
+    this->transactions.clear();
+    UndoActionPool::releaseUnusedChunks();
+}
+
 void UndoStack::clearUndoHistory()
 {
     this->transactions.clear();
     this->totalUnitsStored = 0;
     this->nextIndex = 0;
+    this->journalNeedsResetMarker = true;
+
+    UndoActionPool::releaseUnusedChunks();
 }
 
 bool UndoStack::perform(UndoAction *const newAction, UndoActionId transactionId)
@@ -214,9 +225,14 @@ bool UndoStack::perform(UndoAction *const newAction)
                         actionSet->actions.removeLast();
                     }
                 }
+
+                actionSet->isJournaled = false;
             }
             else
             {
+                // the previous transaction is complete now
+                this->flushJournal();
+
                 actionSet = new Transaction(this->project, this->newUndoActionId);
                 this->transactions.insert(nextIndex, actionSet);
                 this->nextIndex++;
@@ -395,6 +411,126 @@ int UndoStack::getNumActionsInCurrentTransaction() const
     return 0;
 }
 
+//===----------------------------------------------------------------------===//
+// Journal
+//===----------------------------------------------------------------------===//
+
+void UndoStack::setJournalFile(const File &projectFile)
+{
+    const auto journalFile = UndoJournal::getFileFor(projectFile);
+    if (this->journal != nullptr && this->journal->getFile() == journalFile)
+    {
+        return;
+    }
+
+    // the project has been moved or saved as another file,
+    // so the whole history is written into the new journal
+    this->journal = make<UndoJournal>(journalFile);
+    this->journalNeedsResetMarker = true;
+
+    for (auto *transaction : this->transactions)
+    {
+        transaction->journalRecord = -1;
+        transaction->isJournaled = false;
+    }
+}
+
+int UndoStack::getFirstJournaledIndex() const noexcept
+{
+    // there's no point in keeping more than can be restored
+    return jmax(0, this->nextIndex - UndoStack::maxTransactionsToRestore);
+}
+
+void UndoStack::flushJournal()
+{
+    if (this->nextIndex == 0 || this->journal == nullptr)
+    {
+        return;
+    }
+
+    const auto firstIndex = this->getFirstJournaledIndex();
+    auto *firstTransaction = this->transactions.getUnchecked(firstIndex);
+
+    // when the history doesn't continue any of the journal records,
+    // it is separated from them, so that they are never restored with it
+    if (this->journalNeedsResetMarker || firstTransaction->journalRecord < 0)
+    {
+        if (!this->journal->writeResetMarker())
+        {
+            return;
+        }
+
+        this->journalNeedsResetMarker = false;
+    }
+
+    for (int i = firstIndex; i < this->nextIndex; ++i)
+    {
+        auto *transaction = this->transactions.getUnchecked(i);
+        if (transaction->isJournaled)
+        {
+            continue;
+        }
+
+        // each transaction follows the previous one in the journal,
+        // and the first one might be either rewritten in place or appended
+        const auto record = (i > firstIndex) ?
+            this->transactions.getUnchecked(i - 1)->journalRecord + 1 :
+            (transaction->journalRecord >= 0 ? transaction->journalRecord : this->journal->getNumRecords());
+
+        if (this->journal->writeTransaction(record, transaction->serialize()) == 0)
+        {
+            return;
+        }
+
+        // all records after this one are dropped from the journal,
+        // and all the next transactions will be written after it:
+        for (int j = 0; j < this->transactions.size(); ++j)
+        {
+            auto *other = this->transactions.getUnchecked(j);
+            if (j > i || other->journalRecord >= record)
+            {
+                other->journalRecord = -1;
+                other->isJournaled = false;
+            }
+        }
+
+        transaction->journalRecord = record;
+        transaction->isJournaled = true;
+    }
+
+    // and the records older than the restored ones are thrown away
+    const auto numDroppedRecords = this->journal->trim(firstTransaction->journalRecord,
+        UndoStack::maxTransactionsToRestore);
+
+    if (numDroppedRecords > 0)
+    {
+        for (auto *transaction : this->transactions)
+        {
+            transaction->journalRecord = (transaction->journalRecord >= numDroppedRecords) ?
+                transaction->journalRecord - numDroppedRecords : -1;
+            transaction->isJournaled = transaction->isJournaled && transaction->journalRecord >= 0;
+        }
+    }
+}
+
+UndoJournal::Stamp UndoStack::getJournalStamp() const
+{
+    if (this->nextIndex == 0 || this->journal == nullptr)
+    {
+        return 0;
+    }
+
+    for (int i = this->getFirstJournaledIndex(); i < this->nextIndex; ++i)
+    {
+        if (!this->transactions.getUnchecked(i)->isJournaled)
+        {
+            return 0;
+        }
+    }
+
+    return this->journal->getRecordStamp(this->transactions.getUnchecked(this->nextIndex - 1)->journalRecord);
+}
+
 //===----------------------------------------------------------------------===//
 // Serializable
 //===----------------------------------------------------------------------===//
@@ -402,7 +538,21 @@ int UndoStack::getNumActionsInCurrentTransaction() const
 SerializedData UndoStack::serialize() const
 {
     SerializedData tree(Serialization::Undo::undoStack);
-    
+
+    if (this->nextIndex == 0)
+    {
+        return tree;
+    }
+
+    // normally, the transactions are in the journal, see flushJournal(),
+    // and the project only needs a reference to the current one
+    if (const auto stamp = this->getJournalStamp())
+    {
+        tree.setProperty(Serialization::Undo::journalStamp, stamp);
+        return tree;
+    }
+
+    // but if the journal can't be written, keep the last ones in the project:
     int currentIndex = (this->nextIndex - 1);
     int numStoredTransactions = 0;
     
@@ -430,7 +580,35 @@ void UndoStack::deserialize(const SerializedData &data)
     { return; }
     
     this->reset();
-    
+
+    if (root.hasProperty(Serialization::Undo::journalStamp))
+    {
+        const UndoJournal::Stamp stamp = root.getProperty(Serialization::Undo::journalStamp);
+
+        Array<SerializedData> restoredTransactions;
+        const auto firstRecord = (this->journal == nullptr) ? -1 :
+            this->journal->restore(stamp, UndoStack::maxTransactionsToRestore, restoredTransactions);
+
+        if (firstRecord >= 0)
+        {
+            for (const auto &childTransaction : restoredTransactions)
+            {
+                auto *actionSet = new Transaction(this->project, {});
+                actionSet->deserialize(childTransaction);
+                actionSet->journalRecord = firstRecord + this->nextIndex;
+                actionSet->isJournaled = true;
+                this->transactions.insert(this->nextIndex, actionSet);
+                ++this->nextIndex;
+            }
+
+            this->journalNeedsResetMarker = false;
+        }
+
+        return;
+    }
+
+    // legacy projects keep the transactions inline,
+    // they will be moved into the journal on the next save
     for (const auto &childTransaction : root)
     {
         auto *actionSet = new Transaction(this->project, {});
@@ -483,6 +661,7 @@ bool UndoStack::mergeTransactionsUpTo(UndoActionId transactionId)
             // hack warning: manually moving owned objects
             // from one owned array to another to avoid copying:
             targetTransaction->actions.addArray(t->actions);
+            targetTransaction->isJournaled = false;
             t->actions.clear(false);
         }
 
@@ -21,6 +21,7 @@ class ProjectNode;
 
 #include "UndoAction.h"
 #include "UndoActionIDs.h"
+#include "UndoJournal.h"
 
 // Basically the same JUCE's UndoManager, but serializable;
 // plus most actions need a reference to project, which it has
@@ -32,6 +33,8 @@ public:
     explicit UndoStack(ProjectNode &parentProject,
         int maxNumberOfUnitsToKeep = 30000,
         int minimumTransactionsToKeep = 30);
+
+    ~UndoStack() override;
     
     void clearUndoHistory();
 
@@ -70,6 +73,14 @@ public:
     // for multi-step interactive actions which might involve >1 checkpoints
     bool mergeTransactionsUpTo(UndoActionId transactionId);
 
+    // the transactions are kept in the journal of the given project file,
+    // see UndoJournal::getFileFor(); a different file starts a new journal
+    void setJournalFile(const File &projectFile);
+
+    // writes the complete transactions into the journal before saving,
+    // so that serialize() only needs to refer to the current one
+    void flushJournal();
+
 private:
     
     void getActionsInCurrentTransaction(Array<const UndoAction *> &actionsFound) const;
@@ -92,15 +103,39 @@ private:
 
         UndoAction *createUndoActionByTag(const Identifier &tagName) const;
 
+        static void *operator new(size_t size)
+        {
+            return UndoActionPool::allocate(size);
+        }
+
+        static void operator delete(void *block, size_t size) noexcept
+        {
+            UndoActionPool::deallocate(block, size);
+        }
+
         OwnedArray<UndoAction> actions;
         UndoActionId id;
 
+        // the index of this transaction's record in the journal,
+        // and whether that record is up to date
+        int journalRecord = -1;
+        bool isJournaled = false;
+
         ProjectNode &project;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Transaction)
     };
 
     static constexpr auto maxTransactionsToSerialize = 10;
+    static constexpr auto maxTransactionsToRestore = 100;
+
+    // returns the stamp of the current transaction, if all the transactions
+    // to be restored are in the journal, or 0 otherwise
+    UndoJournal::Stamp getJournalStamp() const;
+    int getFirstJournaledIndex() const noexcept;
+
+    UniquePointer<UndoJournal> journal;
+    bool journalNeedsResetMarker = true;
     
     void setCurrentUndoActionId(UndoActionId transactionId) noexcept;
     OwnedArray<Transaction> transactions;
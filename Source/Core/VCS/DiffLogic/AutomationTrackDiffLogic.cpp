@@ -75,6 +75,11 @@ Diff *AutomationTrackDiffLogic::createDiff(const TrackedItem &initialState) cons
 
     for (int i = 0; i < this->target.getNumDeltas(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            break;
+        }
+
         const Delta *myDelta = this->target.getDelta(i);
 
         const auto myDeltaData(this->target.getDeltaData(i));
@@ -512,6 +517,11 @@ Array<DeltaDiff> createAutoEventsDiffs(const SerializedData &state, const Serial
     // собственно, само сравнение
     for (int i = 0; i < stateEvents.size(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundNoteInChanges = false;
         const AutomationEvent *stateEvent = static_cast<AutomationEvent *>(stateEvents.getUnchecked(i));
 
@@ -547,6 +557,11 @@ Array<DeltaDiff> createAutoEventsDiffs(const SerializedData &state, const Serial
     // теперь ищем в изменениях ноты, которые отсутствуют в состоянии
     for (int i = 0; i < changesEvents.size(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundNoteInState = false;
         const AutomationEvent *changesNote = static_cast<AutomationEvent *>(changesEvents.getUnchecked(i));
 
@@ -69,4 +69,10 @@ DiffLogic *DiffLogic::createLogicFor(TrackedItem &targetItem, const Identifier &
     return new DummyDiffLogic(targetItem);
 }
 
+bool DiffLogic::shouldCancelDiff() noexcept
+{
+    const auto *job = ThreadPoolJob::getCurrentThreadPoolJob();
+    return job != nullptr && job->shouldExit();
+}
+
 }
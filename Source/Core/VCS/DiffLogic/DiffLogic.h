@@ -37,6 +37,11 @@ namespace VCS
         virtual Diff *createDiff(const TrackedItem &initialState) const = 0;
         virtual Diff *createMergedItem(const TrackedItem &initialState) const = 0;
 
+        // true when the diff is built by a pool job which is asked to stop,
+        // so that the long comparison loops can bail out early;
+        // whatever is returned after that is discarded by the caller
+        static bool shouldCancelDiff() noexcept;
+
     protected:
 
         TrackedItem &target;
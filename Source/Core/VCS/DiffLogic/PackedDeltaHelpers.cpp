@@ -0,0 +1,471 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "PackedDeltaHelpers.h"
+#include "SerializationKeys.h"
+
+namespace VCS
+{
+
+// Bump these when changing the layout of columns
+static constexpr uint8 packedNotesFormat = 1;
+static constexpr uint8 packedClipsFormat = 2;
+
+//===----------------------------------------------------------------------===//
+// Varints
+//===----------------------------------------------------------------------===//
+
+static inline uint32 zigZagEncode(int32 value) noexcept
+{
+    return (uint32(value) << 1) ^ uint32(value >> 31);
+}
+
+static inline int32 zigZagDecode(uint32 value) noexcept
+{
+    return int32(value >> 1) ^ -int32(value & 1);
+}
+
+static void writeVarInt(MemoryOutputStream &out, uint32 value)
+{
+    while (value >= 0x80)
+    {
+        out.writeByte(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+
+    out.writeByte(char(value));
+}
+
+static uint32 readVarInt(MemoryInputStream &in)
+{
+    uint32 result = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        const auto byte = uint8(in.readByte());
+        result |= uint32(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+static inline void writeSignedVarInt(MemoryOutputStream &out, int32 value)
+{
+    writeVarInt(out, zigZagEncode(value));
+}
+
+static inline int32 readSignedVarInt(MemoryInputStream &in)
+{
+    return zigZagDecode(readVarInt(in));
+}
+
+//===----------------------------------------------------------------------===//
+// Packing
+//===----------------------------------------------------------------------===//
+
+bool PackedDeltaHelpers::isPacked(const SerializedData &deltaData)
+{
+    return deltaData.hasProperty(Serialization::VCS::packedEvents);
+}
+
+MemoryBlock PackedDeltaHelpers::getPackedData(const SerializedData &deltaData)
+{
+    const auto &packed = deltaData.getProperty(Serialization::VCS::packedEvents);
+
+    if (const auto *binary = packed.getBinaryData())
+    {
+        return *binary;
+    }
+
+    // text-based formats store binary properties as base64 strings
+    MemoryBlock block;
+    if (!block.fromBase64Encoding(packed.toString()))
+    {
+        jassertfalse;
+        return {};
+    }
+
+    return block;
+}
+
+SerializedData PackedDeltaHelpers::packNotes(const Array<const MidiEvent *> &notes, const Identifier &deltaType)
+{
+    MemoryOutputStream out;
+    out.writeByte(char(packedNotesFormat));
+    writeVarInt(out, uint32(notes.size()));
+
+    for (const auto *event : notes)
+    {
+        jassert(event->isTypeOf(MidiEvent::Type::Note));
+        out.writeInt(event->getId());
+    }
+
+    int lastTicks = 0;
+    for (const auto *event : notes)
+    {
+        const int ticks = int(event->getBeat() * Globals::ticksPerBeat);
+        writeSignedVarInt(out, ticks - lastTicks);
+        lastTicks = ticks;
+    }
+
+    for (const auto *event : notes)
+    {
+        writeSignedVarInt(out, static_cast<const Note *>(event)->getKey());
+    }
+
+    for (const auto *event : notes)
+    {
+        const auto *note = static_cast<const Note *>(event);
+        writeSignedVarInt(out, int(note->getLength() * Globals::ticksPerBeat));
+    }
+
+    for (const auto *event : notes)
+    {
+        const auto *note = static_cast<const Note *>(event);
+        writeVarInt(out, uint32(note->getVelocity() * Globals::velocitySaveResolution));
+    }
+
+    for (const auto *event : notes)
+    {
+        out.writeByte(char(static_cast<const Note *>(event)->getTuplet()));
+    }
+
+    SerializedData tree(deltaType);
+    tree.setProperty(Serialization::VCS::packedEvents, var(out.getMemoryBlock()));
+    return tree;
+}
+
+SerializedData PackedDeltaHelpers::packClips(const Array<Clip> &clips, const Identifier &deltaType)
+{
+    MemoryOutputStream out;
+    out.writeByte(char(packedClipsFormat));
+    writeVarInt(out, uint32(clips.size()));
+
+    for (const auto &clip : clips)
+    {
+        out.writeInt(clip.getId());
+    }
+
+    int lastTicks = 0;
+    for (const auto &clip : clips)
+    {
+        const int ticks = int(clip.getBeat() * Globals::ticksPerBeat);
+        writeSignedVarInt(out, ticks - lastTicks);
+        lastTicks = ticks;
+    }
+
+    for (const auto &clip : clips)
+    {
+        writeSignedVarInt(out, clip.getKey());
+    }
+
+    for (const auto &clip : clips)
+    {
+        writeVarInt(out, uint32(clip.getVelocity() * Globals::velocitySaveResolution));
+    }
+
+    for (const auto &clip : clips)
+    {
+        out.writeByte(char((clip.isMuted() ? 1 : 0) | (clip.isSoloed() ? 2 : 0)));
+    }
+
+    SerializedData tree(deltaType);
+    tree.setProperty(Serialization::VCS::packedEvents, var(out.getMemoryBlock()));
+    return tree;
+}
+
+//===----------------------------------------------------------------------===//
+// Unpacking
+//===----------------------------------------------------------------------===//
+
+Array<Note> PackedDeltaHelpers::unpackNotes(const SerializedData &deltaData)
+{
+    Array<Note> result;
+
+    if (!deltaData.isValid())
+    {
+        return result;
+    }
+
+    if (!isPacked(deltaData))
+    {
+        forEachChildWithType(deltaData, e, Serialization::Midi::note)
+        {
+            Note note;
+            note.deserialize(e);
+            result.add(note);
+        }
+
+        return result;
+    }
+
+    const auto block = getPackedData(deltaData);
+    MemoryInputStream in(block, false);
+
+    if (in.isExhausted() || uint8(in.readByte()) != packedNotesFormat)
+    {
+        jassertfalse;
+        return result;
+    }
+
+    const int numNotes = int(readVarInt(in));
+    // a sanity check: each note takes at least 9 bytes
+    if (numNotes < 0 || in.getNumBytesRemaining() < int64(numNotes) * 9)
+    {
+        jassertfalse;
+        return result;
+    }
+
+    result.resize(numNotes);
+
+    for (auto &note : result)
+    {
+        note.id = in.readInt();
+    }
+
+    int ticks = 0;
+    for (auto &note : result)
+    {
+        ticks += readSignedVarInt(in);
+        note.beat = float(ticks) / Globals::ticksPerBeat;
+    }
+
+    for (auto &note : result)
+    {
+        note.key = readSignedVarInt(in);
+    }
+
+    for (auto &note : result)
+    {
+        note.length = float(readSignedVarInt(in)) / Globals::ticksPerBeat;
+    }
+
+    for (auto &note : result)
+    {
+        const auto vol = float(readVarInt(in)) / Globals::velocitySaveResolution;
+        note.velocity = jmax(jmin(vol, 1.f), 0.f);
+    }
+
+    for (auto &note : result)
+    {
+        note.tuplet = Note::Tuplet(jmax(1, int(in.readByte())));
+    }
+
+    return result;
+}
+
+Array<Clip> PackedDeltaHelpers::unpackClips(const SerializedData &deltaData)
+{
+    Array<Clip> result;
+
+    if (!deltaData.isValid())
+    {
+        return result;
+    }
+
+    if (!isPacked(deltaData))
+    {
+        forEachChildWithType(deltaData, e, Serialization::Midi::clip)
+        {
+            Clip clip;
+            clip.deserialize(e);
+            result.add(clip);
+        }
+
+        return result;
+    }
+
+    const auto block = getPackedData(deltaData);
+    MemoryInputStream in(block, false);
+
+    if (in.isExhausted() || uint8(in.readByte()) != packedClipsFormat)
+    {
+        jassertfalse;
+        return result;
+    }
+
+    const int numClips = int(readVarInt(in));
+    // a sanity check: each clip takes at least 8 bytes
+    if (numClips < 0 || in.getNumBytesRemaining() < int64(numClips) * 8)
+    {
+        jassertfalse;
+        return result;
+    }
+
+    result.resize(numClips);
+
+    for (auto &clip : result)
+    {
+        clip.id = in.readInt();
+    }
+
+    int ticks = 0;
+    for (auto &clip : result)
+    {
+        ticks += readSignedVarInt(in);
+        clip.beat = float(ticks) / Globals::ticksPerBeat;
+    }
+
+    for (auto &clip : result)
+    {
+        clip.key = readSignedVarInt(in);
+    }
+
+    for (auto &clip : result)
+    {
+        const auto vol = float(readVarInt(in)) / Globals::velocitySaveResolution;
+        clip.velocity = jmax(jmin(vol, 1.f), 0.f);
+    }
+
+    for (auto &clip : result)
+    {
+        const auto flags = uint8(in.readByte());
+        clip.mute = (flags & 1) != 0;
+        clip.solo = (flags & 2) != 0;
+        clip.updateCaches();
+    }
+
+    return result;
+}
+
+} // namespace VCS
+
+//===----------------------------------------------------------------------===//
+// Tests
+//===----------------------------------------------------------------------===//
+
+#if JUCE_UNIT_TESTS
+
+class PackedDeltaFormatTests final : public UnitTest
+{
+public:
+    PackedDeltaFormatTests() : UnitTest("Packed VCS deltas format tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        using namespace Serialization::VCS;
+        using VCS::PackedDeltaHelpers;
+
+        beginTest("Notes delta packing");
+
+        SerializedData legacyNotes(PianoSequenceDeltas::notesAdded);
+        legacyNotes.appendChild(this->makeNote("a", 60, 0, 4, 256, 1));
+        legacyNotes.appendChild(this->makeNote("b1", 64, 16, 8, 1024, 3));
+        legacyNotes.appendChild(this->makeNote("xZ0", 35, 8, 1, 0, 5));
+        legacyNotes.appendChild(this->makeNote("Zz", -3, 1024, 64, 512, 1));
+
+        const auto notes = PackedDeltaHelpers::unpackNotes(legacyNotes);
+        expectEquals(notes.size(), 4);
+
+        Array<const MidiEvent *> notesToPack;
+        for (const auto &note : notes)
+        {
+            notesToPack.add(&note);
+        }
+
+        const auto packedNotes = PackedDeltaHelpers::packNotes(notesToPack, PianoSequenceDeltas::notesAdded);
+        expect(PackedDeltaHelpers::isPacked(packedNotes));
+        expectEquals(packedNotes.getNumChildren(), 0);
+        this->expectSameNotes(notes, PackedDeltaHelpers::unpackNotes(packedNotes));
+
+        // text-based serializers will store the binary data as base64 strings:
+        SerializedData packedNotesAsText(PianoSequenceDeltas::notesAdded);
+        packedNotesAsText.setProperty(packedEvents, packedNotes.getProperty(packedEvents).toString());
+        this->expectSameNotes(notes, PackedDeltaHelpers::unpackNotes(packedNotesAsText));
+
+        beginTest("Clips delta packing");
+
+        SerializedData legacyClips(PatternDeltas::clipsAdded);
+        legacyClips.appendChild(this->makeClip("a", 0, 0, 1024, false, false));
+        legacyClips.appendChild(this->makeClip("b1", -12, 64, 512, true, false));
+        legacyClips.appendChild(this->makeClip("xZ0", 7, 32, 0, true, true));
+
+        const auto clips = PackedDeltaHelpers::unpackClips(legacyClips);
+        expectEquals(clips.size(), 3);
+
+        const auto packedClips = PackedDeltaHelpers::packClips(clips, PatternDeltas::clipsAdded);
+        expect(PackedDeltaHelpers::isPacked(packedClips));
+
+        const auto unpackedClips = PackedDeltaHelpers::unpackClips(packedClips);
+        expectEquals(unpackedClips.size(), clips.size());
+        for (int i = 0; i < clips.size(); ++i)
+        {
+            expectEquals(unpackedClips[i].getId(), clips[i].getId());
+            expectEquals(unpackedClips[i].getKey(), clips[i].getKey());
+            expectEquals(unpackedClips[i].getBeat(), clips[i].getBeat());
+            expectEquals(unpackedClips[i].getVelocity(), clips[i].getVelocity());
+            expect(unpackedClips[i].isMuted() == clips[i].isMuted());
+            expect(unpackedClips[i].isSoloed() == clips[i].isSoloed());
+        }
+
+        beginTest("Empty deltas packing");
+
+        expect(PackedDeltaHelpers::unpackNotes(PackedDeltaHelpers::packNotes({}, PianoSequenceDeltas::notesAdded)).isEmpty());
+        expect(PackedDeltaHelpers::unpackClips(PackedDeltaHelpers::packClips({}, PatternDeltas::clipsAdded)).isEmpty());
+        expect(PackedDeltaHelpers::unpackNotes({}).isEmpty());
+    }
+
+private:
+
+    SerializedData makeNote(const String &id, int key, int ticks, int length, int volume, int tuplet)
+    {
+        using namespace Serialization;
+        SerializedData note(Midi::note);
+        note.setProperty(Midi::id, id);
+        note.setProperty(Midi::key, key);
+        note.setProperty(Midi::timestamp, ticks);
+        note.setProperty(Midi::length, length);
+        note.setProperty(Midi::volume, volume);
+        note.setProperty(Midi::tuplet, tuplet);
+        return note;
+    }
+
+    SerializedData makeClip(const String &id, int key, int ticks, int volume, bool mute, bool solo)
+    {
+        using namespace Serialization;
+        SerializedData clip(Midi::clip);
+        clip.setProperty(Midi::id, id);
+        clip.setProperty(Midi::key, key);
+        clip.setProperty(Midi::timestamp, ticks);
+        clip.setProperty(Midi::volume, volume);
+        clip.setProperty(Midi::mute, mute ? 1 : 0);
+        clip.setProperty(Midi::solo, solo ? 1 : 0);
+        return clip;
+    }
+
+    void expectSameNotes(const Array<Note> &expected, const Array<Note> &actual)
+    {
+        expectEquals(actual.size(), expected.size());
+        for (int i = 0; i < jmin(actual.size(), expected.size()); ++i)
+        {
+            expectEquals(actual[i].getId(), expected[i].getId());
+            expectEquals(actual[i].getKey(), expected[i].getKey());
+            expectEquals(actual[i].getBeat(), expected[i].getBeat());
+            expectEquals(actual[i].getLength(), expected[i].getLength());
+            expectEquals(actual[i].getVelocity(), expected[i].getVelocity());
+            expectEquals(int(actual[i].getTuplet()), int(expected[i].getTuplet()));
+        }
+    }
+};
+
+static PackedDeltaFormatTests packedDeltaFormatTests;
+
+#endif
@@ -0,0 +1,49 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Note.h"
+#include "Clip.h"
+
+namespace VCS
+{
+    // A compact alternative to storing notes and clips deltas
+    // as trees with one child node per event: all events' fields
+    // are packed into typed columns of a single binary property,
+    // ids are stored as raw ints and timestamps are delta-encoded.
+    // The readers here accept both forms, so that older histories
+    // (and the legacy tree-based deltas in general) still work.
+
+    class PackedDeltaHelpers final
+    {
+    public:
+
+        static bool isPacked(const SerializedData &deltaData);
+
+        static SerializedData packNotes(const Array<const MidiEvent *> &notes, const Identifier &deltaType);
+        static SerializedData packClips(const Array<Clip> &clips, const Identifier &deltaType);
+
+        static Array<Note> unpackNotes(const SerializedData &deltaData);
+        static Array<Clip> unpackClips(const SerializedData &deltaData);
+
+    private:
+
+        static MemoryBlock getPackedData(const SerializedData &deltaData);
+
+    };
+} // namespace VCS
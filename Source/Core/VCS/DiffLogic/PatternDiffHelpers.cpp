@@ -17,6 +17,8 @@
 
 #include "Common.h"
 #include "PatternDiffHelpers.h"
+#include "PackedDeltaHelpers.h"
+#include "DiffLogic.h"
 #include "Clip.h"
 #include "SerializationKeys.h"
 
@@ -26,37 +28,20 @@ namespace VCS
 void deserializePatternChanges(const SerializedData &state, const SerializedData &changes,
     Array<Clip> &stateClips, Array<Clip> &changesClips)
 {
-    if (state.isValid())
+    for (const auto &clip : PackedDeltaHelpers::unpackClips(state))
     {
-        forEachChildWithType(state, e, Serialization::Midi::clip)
-        {
-            Clip clip;
-            clip.deserialize(e);
-            stateClips.addSorted(clip, clip);
-        }
+        stateClips.addSorted(clip, clip);
     }
 
-    if (changes.isValid())
+    for (const auto &clip : PackedDeltaHelpers::unpackClips(changes))
     {
-        forEachChildWithType(changes, e, Serialization::Midi::clip)
-        {
-            Clip clip;
-            clip.deserialize(e);
-            changesClips.addSorted(clip, clip);
-        }
+        changesClips.addSorted(clip, clip);
     }
 }
 
 SerializedData serializePattern(Array<Clip> changes, const Identifier &tag)
 {
-    SerializedData tree(tag);
-
-    for (int i = 0; i < changes.size(); ++i)
-    {
-        tree.appendChild(changes.getUnchecked(i).serialize());
-    }
-
-    return tree;
+    return PackedDeltaHelpers::packClips(changes, tag);
 }
 
 DeltaDiff PatternDiffHelpers::serializePatternChanges(Array<Clip> changes,
@@ -189,6 +174,11 @@ Array<VCS::DeltaDiff> PatternDiffHelpers::createClipsDiffs(const SerializedData
 
     for (int i = 0; i < stateClips.size(); ++i)
     {
+        if (VCS::DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundInChanges = false;
         const Clip stateClip(stateClips.getUnchecked(i));
 
@@ -220,6 +210,11 @@ Array<VCS::DeltaDiff> PatternDiffHelpers::createClipsDiffs(const SerializedData
 
     for (int i = 0; i < changesClips.size(); ++i)
     {
+        if (VCS::DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundInState = false;
         const Clip changesClip(changesClips.getUnchecked(i));
 
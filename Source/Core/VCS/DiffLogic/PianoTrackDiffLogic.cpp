@@ -19,6 +19,7 @@
 #include "PianoTrackDiffLogic.h"
 #include "PianoTrackNode.h"
 #include "PatternDiffHelpers.h"
+#include "PackedDeltaHelpers.h"
 #include "Note.h"
 #include "PianoSequence.h"
 #include "SerializationKeys.h"
@@ -66,6 +67,11 @@ Diff *PianoTrackDiffLogic::createDiff(const TrackedItem &initialState) const
 
     for (int i = 0; i < this->target.getNumDeltas(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            break;
+        }
+
         const Delta *myDelta = this->target.getDelta(i);
 
         const auto myDeltaData(this->target.getDeltaData(i));
@@ -270,7 +276,7 @@ Diff *PianoTrackDiffLogic::createMergedItem(const TrackedItem &initialState) con
             const bool foundMissingClip = !stateHasClips && PatternDiffHelpers::checkIfDeltaIsPatternType(targetDelta);
             if (foundMissingClip)
             {
-                SerializedData emptyClipDeltaData(serializePianoSequence({}, PatternDeltas::clipsAdded));
+                SerializedData emptyClipDeltaData(PatternDeltas::clipsAdded);
                 const bool incrementalMerge = clipsDeltaData.isValid();
 
                 if (targetDelta->hasType(PatternDeltas::clipsAdded))
@@ -477,6 +483,11 @@ Array<DeltaDiff> createEventsDiffs(const SerializedData &state, const Serialized
     // собственно, само сравнение
     for (int i = 0; i < stateNotes.size(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundNoteInChanges = false;
         const Note *stateNote(stateNotes.getUnchecked(i));
 
@@ -515,6 +526,11 @@ Array<DeltaDiff> createEventsDiffs(const SerializedData &state, const Serialized
     // теперь ищем в изменениях ноты, которые отсутствуют в состоянии
     for (int i = 0; i < changesNotes.size(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            return res;
+        }
+
         bool foundNoteInState = false;
         const Note *changesNote = changesNotes.getUnchecked(i);
 
@@ -569,24 +585,16 @@ Array<DeltaDiff> createEventsDiffs(const SerializedData &state, const Serialized
 void deserializeLayerChanges(const SerializedData &state, const SerializedData &changes,
         OwnedArray<Note> &stateNotes, OwnedArray<Note> &changesNotes)
 {
-    if (state.isValid())
+    for (const auto &n : PackedDeltaHelpers::unpackNotes(state))
     {
-        forEachChildWithType(state, e, Serialization::Midi::note)
-        {
-            auto *note = new Note();
-            note->deserialize(e);
-            stateNotes.addSorted(*note, note);
-        }
+        auto *note = new Note(n);
+        stateNotes.addSorted(*note, note);
     }
 
-    if (changes.isValid())
+    for (const auto &n : PackedDeltaHelpers::unpackNotes(changes))
     {
-        forEachChildWithType(changes, e, Serialization::Midi::note)
-        {
-            auto *note = new Note();
-            note->deserialize(e);
-            changesNotes.addSorted(*note, note);
-        }
+        auto *note = new Note(n);
+        changesNotes.addSorted(*note, note);
     }
 }
 
@@ -601,15 +609,7 @@ DeltaDiff serializePianoTrackChanges(Array<const MidiEvent *> changes,
 
 SerializedData serializePianoSequence(Array<const MidiEvent *> changes, const Identifier &tag)
 {
-    SerializedData tree(tag);
-
-    for (int i = 0; i < changes.size(); ++i)
-    {
-        const MidiEvent *event = changes.getUnchecked(i);
-        tree.appendChild(event->serialize());
-    }
-
-    return tree;
+    return PackedDeltaHelpers::packNotes(changes, tag);
 }
 
 bool checkIfDeltaIsNotesType(const Delta *d)
@@ -71,6 +71,11 @@ Diff *ProjectTimelineDiffLogic::createDiff(const TrackedItem &initialState) cons
 
     for (int i = 0; i < this->target.getNumDeltas(); ++i)
     {
+        if (DiffLogic::shouldCancelDiff())
+        {
+            break;
+        }
+
         const Delta *myDelta = this->target.getDelta(i);
 
         const auto myDeltaData(this->target.getDeltaData(i));
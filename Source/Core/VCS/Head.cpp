@@ -463,6 +463,34 @@ SerializedData Head::serialize() const
     return tree;
 }
 
+SerializedSnapshot Head::createSnapshot() const
+{
+    ReferenceCountedArray<RevisionItem> stateItems;
+
+    {
+        const ScopedReadLock lock(this->stateLock);
+
+        for (int i = 0; i < this->state->getNumTrackedItems(); ++i)
+        {
+            stateItems.add(static_cast<RevisionItem *>(this->state->getTrackedItem(i)));
+        }
+    }
+
+    return [stateItems](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::VCS::head, 0, 1);
+        writer.beginNode(Serialization::VCS::snapshot, 0, stateItems.size());
+
+        for (const auto *stateItem : stateItems)
+        {
+            stateItem->serializeTo(writer);
+        }
+
+        writer.endNode();
+        writer.endNode();
+    };
+}
+
 void Head::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -512,196 +540,217 @@ void Head::run()
     this->setRebuildingDiffMode(true);
     this->sendChangeMessage();
 
+    if (this->rebuildDiff(true))
     {
-        const ScopedWriteLock lock(this->diffLock);
-        this->diff->reset();
+        this->setDiffOutdated(false);
     }
 
-    const ScopedReadLock threadStateLock(this->stateLock);
-
-    for (int i = 0; i < this->state->getNumTrackedItems(); ++i)
-    {
-        if (this->threadShouldExit())
-        {
-            this->setRebuildingDiffMode(false);
-            this->sendChangeMessage();
-            return;
-        }
-
-        bool foundItemInTarget = false;
-        const RevisionItem::Ptr stateItem = static_cast<RevisionItem *>(this->state->getTrackedItem(i));
+    this->setRebuildingDiffMode(false);
+    this->sendChangeMessage();
+}
 
-        // will check `removed` records later
-        if (stateItem->getType() == RevisionItem::Type::Removed) { continue; }
+void Head::rebuildDiffSynchronously()
+{
+    if (this->state == nullptr)
+    { return; }
+    
+    if (this->isRebuildingDiff())
+    { return; }
+    
+    this->setRebuildingDiffMode(true);
 
-        for (int j = 0; j < this->targetVcsItemsSource.getNumTrackedItems(); ++j)
-        {
-            if (this->threadShouldExit())
-            {
-                this->setRebuildingDiffMode(false);
-                this->sendChangeMessage();
-                return;
-            }
+    if (this->rebuildDiff(false))
+    {
+        this->setDiffOutdated(false);
+    }
 
-            TrackedItem *targetItem = this->targetVcsItemsSource.getTrackedItem(j); // i.e. LayerTreeItem
+    this->setRebuildingDiffMode(false);
+    this->sendChangeMessage();
+}
 
-            // state item exists in project, adding `changed` record, if needed
-            if (stateItem->getUuid() == targetItem->getUuid())
-            {
-                foundItemInTarget = true;
+//===----------------------------------------------------------------------===//
+// Diff building
+//===----------------------------------------------------------------------===//
 
-                UniquePointer<Diff> itemDiff(targetItem->getDiffLogic()->createDiff(*stateItem));
+// Diffs for different tracked items are independent of each other,
+// so each one is computed by a separate job in the workers pool;
+// the results are collected by the state item index, so that
+// the resulting revision has the same items order, as if it was built serially;
+// the diff logic checks shouldExit() of the current job in its loops,
+// so the cancelled jobs return early, and their partial results are dropped
+class ItemDiffJob final : public ThreadPoolJob
+{
+public:
 
-                if (itemDiff->hasAnyChanges())
-                {
-                    RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Changed, itemDiff.get()));
-                    const ScopedWriteLock itemDiffLock(this->diffLock);
-                    this->diff->addItem(revisionRecord);
-                }
+    ItemDiffJob(const RevisionItem::Ptr stateItem, TrackedItem *targetItem, int recordIndex) :
+        ThreadPoolJob("Item Diff Job"),
+        stateItem(stateItem),
+        targetItem(targetItem),
+        recordIndex(recordIndex) {}
 
-                break;
-            }
+    JobStatus runJob() override
+    {
+        if (this->shouldExit())
+        {
+            return jobHasFinished;
         }
 
-        // state item was not found in project, adding `removed` record
-        if (! foundItemInTarget)
+        this->result = createItemDiff(*this->stateItem, *this->targetItem);
+
+        if (this->shouldExit())
         {
-            UniquePointer<Diff> emptyDiff(new Diff(*stateItem));
-            RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Removed, emptyDiff.get()));
-            const ScopedWriteLock emptyDiffLock(this->diffLock);
-            this->diff->addItem(revisionRecord);
+            this->result = nullptr;
         }
+
+        return jobHasFinished;
     }
 
-    // search for project item that are missing (or deleted) in the state
-    for (int i = 0; i < this->targetVcsItemsSource.getNumTrackedItems(); ++i)
+    static RevisionItem::Ptr createItemDiff(const RevisionItem &stateItem, TrackedItem &targetItem)
     {
-        if (this->threadShouldExit())
+        UniquePointer<Diff> itemDiff(targetItem.getDiffLogic()->createDiff(stateItem));
+
+        if (itemDiff->hasAnyChanges())
         {
-            this->setRebuildingDiffMode(false);
-            this->sendChangeMessage();
-            return;
+            return new RevisionItem(RevisionItem::Type::Changed, itemDiff.get());
         }
 
-        bool foundItemInState = false;
-        TrackedItem *targetItem = this->targetVcsItemsSource.getTrackedItem(i);
+        return {};
+    }
 
-        for (int j = 0; j < this->state->getNumTrackedItems(); ++j)
-        {
-            const RevisionItem::Ptr stateItem = static_cast<RevisionItem *>(this->state->getTrackedItem(j));
+    const RevisionItem::Ptr stateItem;
+    TrackedItem *const targetItem;
+    const int recordIndex;
 
-            if (stateItem->getType() == RevisionItem::Type::Removed) { continue; }
+    // stays empty, if there are no changes
+    RevisionItem::Ptr result;
 
-            if (stateItem->getUuid() == targetItem->getUuid())
-            {
-                foundItemInState = true;
-                break;
-            }
-        }
+    JUCE_DECLARE_NON_COPYABLE(ItemDiffJob)
+};
 
-        // copy deltas from targetItem and add `added` record
-        if (! foundItemInState)
-        {
-            RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Added, targetItem));
-            const ScopedWriteLock lock(this->diffLock);
-            this->diff->addItem(revisionRecord);
-        }
-    }
+#define DIFF_BUILD_JOB_WAIT_TIMEOUT 50
 
-    this->setDiffOutdated(false);
-    this->setRebuildingDiffMode(false);
-    this->sendChangeMessage();
-}
-
-// FIXME: lots of duplicate code from Head::run
-void Head::rebuildDiffSynchronously()
+bool Head::rebuildDiff(bool cancellable)
 {
-    if (this->state == nullptr)
-    { return; }
-    
-    if (this->isRebuildingDiff())
-    { return; }
-    
-    this->setRebuildingDiffMode(true);
-    
+    const auto shouldCancel = [this, cancellable]()
+    {
+        return cancellable && this->threadShouldExit();
+    };
+
     {
         const ScopedWriteLock lock(this->diffLock);
         this->diff->reset();
     }
-    
+
+    // collect the project items once instead of doing lookups in nested loops
+    Array<TrackedItem *> targetItems;
+    FlatHashMap<String, TrackedItem *, StringHash> targetItemsById;
+    for (int i = 0; i < this->targetVcsItemsSource.getNumTrackedItems(); ++i)
+    {
+        auto *targetItem = this->targetVcsItemsSource.getTrackedItem(i);
+        targetItems.add(targetItem);
+        targetItemsById[targetItem->getUuid().toString()] = targetItem;
+    }
+
     const ScopedReadLock rebuildStateLock(this->stateLock);
-    
+
+    // stateItem is either matched with some job, or it gets a `removed` record
+    OwnedArray<ItemDiffJob> jobs;
+    Array<RevisionItem::Ptr> records;
+    FlatHashSet<String, StringHash> stateItemIds;
+
     for (int i = 0; i < this->state->getNumTrackedItems(); ++i)
     {
-        bool foundItemInTarget = false;
         const RevisionItem::Ptr stateItem = static_cast<RevisionItem *>(this->state->getTrackedItem(i));
-        
+
         // will check `removed` records later
         if (stateItem->getType() == RevisionItem::Type::Removed) { continue; }
-        
-        for (int j = 0; j < this->targetVcsItemsSource.getNumTrackedItems(); ++j)
+
+        const auto stateItemId = stateItem->getUuid().toString();
+        stateItemIds.insert(stateItemId);
+
+        const auto foundTarget = targetItemsById.find(stateItemId);
+        if (foundTarget != targetItemsById.end())
         {
-            TrackedItem *targetItem = this->targetVcsItemsSource.getTrackedItem(j); // i.e. LayerTreeItem
-            
             // state item exists in project, adding `changed` record, if needed
-            if (stateItem->getUuid() == targetItem->getUuid())
-            {
-                foundItemInTarget = true;
-                
-                UniquePointer<Diff> itemDiff(targetItem->getDiffLogic()->createDiff(*stateItem));
-                
-                if (itemDiff->hasAnyChanges())
-                {
-                    RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Changed, itemDiff.get()));
-                    const ScopedWriteLock lock(this->diffLock);
-                    this->diff->addItem(revisionRecord);
-                }
-                
-                break;
-            }
+            jobs.add(new ItemDiffJob(stateItem, foundTarget->second, records.size()));
+            records.add(RevisionItem::Ptr());
         }
-        
-        // state item was not found in project, adding `removed` record
-        if (! foundItemInTarget)
+        else
         {
+            // state item was not found in project, adding `removed` record
             UniquePointer<Diff> emptyDiff(new Diff(*stateItem));
-            RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Removed, emptyDiff.get()));
-            const ScopedWriteLock lock(this->diffLock);
-            this->diff->addItem(revisionRecord);
+            records.add(RevisionItem::Ptr(new RevisionItem(RevisionItem::Type::Removed, emptyDiff.get())));
         }
     }
-    
-    // search for project item that are missing (or deleted) in the state
-    for (int i = 0; i < this->targetVcsItemsSource.getNumTrackedItems(); ++i)
+
+    if (!cancellable)
     {
-        bool foundItemInState = false;
-        TrackedItem *targetItem = this->targetVcsItemsSource.getTrackedItem(i);
-        
-        for (int j = 0; j < this->state->getNumTrackedItems(); ++j)
+        // the synchronous rebuild is called from the message thread,
+        // and it is not worth spinning up the workers for it
+        for (auto *job : jobs)
         {
-            const RevisionItem::Ptr stateItem = static_cast<RevisionItem *>(this->state->getTrackedItem(j));
-            
-            if (stateItem->getType() == RevisionItem::Type::Removed) { continue; }
-            
-            if (stateItem->getUuid() == targetItem->getUuid())
+            records.set(job->recordIndex,
+                ItemDiffJob::createItemDiff(*job->stateItem, *job->targetItem));
+        }
+    }
+    else if (!jobs.isEmpty())
+    {
+        // the workers only live for the duration of a rebuild;
+        // the pool is declared after the jobs, so it is destroyed first,
+        // and its destructor waits for any job that is still running
+        ThreadPool workers(jmin(jobs.size(), jmax(1, SystemStats::getNumCpus())));
+
+        for (auto *job : jobs)
+        {
+            workers.addJob(job, false);
+        }
+
+        for (auto *job : jobs)
+        {
+            while (!workers.waitForJobToFinish(job, DIFF_BUILD_JOB_WAIT_TIMEOUT))
             {
-                foundItemInState = true;
-                break;
+                if (shouldCancel())
+                {
+                    // the pending jobs are removed right away, and the running
+                    // ones are signalled to exit, which they check between
+                    // the events they compare, so this wait should be short
+                    const bool allJobsRemoved = workers.removeAllJobs(true, -1);
+                    jassert(allJobsRemoved);
+                    ignoreUnused(allJobsRemoved);
+
+                    return false;
+                }
             }
+
+            records.set(job->recordIndex, job->result);
         }
-        
-        // copy deltas from targetItem and add `added` record
-        if (! foundItemInState)
+    }
+
+    // search for project item that are missing (or deleted) in the state
+    // and copy deltas from targetItem and add `added` record
+    for (auto *targetItem : targetItems)
+    {
+        if (shouldCancel())
         {
-            RevisionItem::Ptr revisionRecord(new RevisionItem(RevisionItem::Type::Added, targetItem));
-            const ScopedWriteLock lock(this->diffLock);
-            this->diff->addItem(revisionRecord);
+            return false;
+        }
+
+        if (stateItemIds.find(targetItem->getUuid().toString()) == stateItemIds.end())
+        {
+            records.add(RevisionItem::Ptr(new RevisionItem(RevisionItem::Type::Added, targetItem)));
         }
     }
-    
-    this->setDiffOutdated(false);
-    this->setRebuildingDiffMode(false);
-    this->sendChangeMessage();
-}
 
+    const ScopedWriteLock lock(this->diffLock);
+    for (const auto &record : records)
+    {
+        if (record != nullptr)
+        {
+            this->diff->addItem(record);
+        }
+    }
+
+    return true;
 }
+
+} // namespace VCS
@@ -66,6 +66,7 @@ namespace VCS
         //===--------------------------------------------------------------===//
 
         SerializedData serialize() const override;
+        SerializedSnapshot createSnapshot() const override;
         void deserialize(const SerializedData &data) override;
         void reset() override;
         
@@ -82,6 +83,11 @@ namespace VCS
         //===--------------------------------------------------------------===//
 
         void run() override;
+
+        // shared by both the diff thread and the synchronous rebuild,
+        // returns false if the rebuild has been cancelled
+        bool rebuildDiff(bool cancellable);
+
         void checkoutItem(RevisionItem::Ptr stateItem);
         bool resetChangedItemToState(const RevisionItem::Ptr diffItem);
 
@@ -0,0 +1,472 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "HistoryCompaction.h"
+#include "Snapshot.h"
+#include "Diff.h"
+#include "ProjectInfoDiffLogic.h"
+
+namespace VCS
+{
+
+int64 HistoryCompaction::Report::getBytesSaved() const noexcept
+{
+    return jmax(int64(0), this->bytesBefore - this->bytesAfter);
+}
+
+String HistoryCompaction::Report::toString() const
+{
+    return "squashed " + String(this->numSquashedRevisions) +
+        " revisions in " + String(this->numSquashedChains) + " chains, removed " +
+        String(this->numRemovedItems) + " redundant items and " +
+        String(this->numRemovedStashes) + " empty stashes, shared " +
+        String(this->numDeduplicatedDeltas) + " identical deltas, " +
+        String(this->getBytesSaved()) + " bytes saved in " +
+        String(this->elapsedMs, 1) + " ms";
+}
+
+HistoryCompaction::HistoryCompaction(const RemoteCache &remoteCache,
+    Revision::Ptr head, Time olderThan) :
+    remoteCache(remoteCache),
+    head(head),
+    olderThanMs(olderThan.toMilliseconds()) {}
+
+void HistoryCompaction::squashChains(Revision::Ptr root, Report &report) const
+{
+    // collect all chains first, since squashing re-links the tree
+    Array<ReferenceCountedArray<Revision>> chains;
+    for (auto *child : root->getChildren())
+    {
+        this->findChains(child, chains);
+    }
+
+    for (const auto &chain : chains)
+    {
+        this->squashChain(chain, report);
+    }
+}
+
+void HistoryCompaction::deduplicateDeltas(Revision::Ptr root, Report &report) const
+{
+    DeltaDataIndex index;
+    deduplicateDeltas(root, index, report);
+}
+
+void HistoryCompaction::deduplicateDeltas(Revision::Ptr revision,
+    DeltaDataIndex &index, Report &report)
+{
+    const auto &items = revision->getItems();
+    for (int k = 0; k < items.size(); ++k)
+    {
+        // revision items are immutable once they are in the history,
+        // (e.g. the autosave snapshot might be writing them right now),
+        // so the deduplicated data goes to a copy which replaces the item
+        const RevisionItem::Ptr item = items.getUnchecked(k);
+        RevisionItem::Ptr compactedItem;
+
+        for (int i = 0; i < item->getNumDeltas(); ++i)
+        {
+            const auto data = item->getDeltaData(i);
+            if (!data.isValid())
+            {
+                continue;
+            }
+
+            MemoryOutputStream stream;
+            data.writeToStream(stream);
+
+            // FNV-1a over the binary form, only used to find the candidates,
+            // the data itself is compared before sharing anything
+            uint64 hash = 14695981039346656037ull;
+            const auto *bytes = static_cast<const uint8 *>(stream.getData());
+            for (size_t j = 0; j < stream.getDataSize(); ++j)
+            {
+                hash = (hash ^ bytes[j]) * 1099511628211ull;
+            }
+
+            auto &candidates = index[hash];
+
+            bool wasShared = false;
+            for (const auto &candidate : candidates)
+            {
+                if (candidate == data)
+                {
+                    wasShared = true;
+                    break;
+                }
+
+                if (candidate.isEquivalentTo(data))
+                {
+                    if (compactedItem == nullptr)
+                    {
+                        compactedItem = new RevisionItem(item->getType(), item.get());
+                    }
+
+                    compactedItem->shareDeltaData(i, candidate);
+                    report.numDeduplicatedDeltas++;
+                    wasShared = true;
+                    break;
+                }
+            }
+
+            if (!wasShared)
+            {
+                candidates.add(data);
+            }
+        }
+
+        if (compactedItem != nullptr)
+        {
+            revision->replaceItem(k, compactedItem);
+        }
+    }
+
+    for (auto *child : revision->getChildren())
+    {
+        deduplicateDeltas(child, index, report);
+    }
+}
+
+bool HistoryCompaction::canBeSquashed(const Revision::Ptr revision) const
+{
+    return revision != this->head &&
+        revision->getParent() != nullptr &&
+        revision->getTimeStamp() < this->olderThanMs &&
+        !this->remoteCache.hasRevisionTracked(revision);
+}
+
+void HistoryCompaction::findChains(Revision::Ptr revision,
+    Array<ReferenceCountedArray<Revision>> &result) const
+{
+    if (!this->canBeSquashed(revision))
+    {
+        for (auto *child : revision->getChildren())
+        {
+            this->findChains(child, result);
+        }
+
+        return;
+    }
+
+    ReferenceCountedArray<Revision> chain;
+    chain.add(revision);
+
+    auto last = revision;
+    while (last->getChildren().size() == 1 &&
+        this->canBeSquashed(last->getChildren().getFirst()))
+    {
+        last = last->getChildren().getFirst();
+        chain.add(last);
+    }
+
+    if (chain.size() > 1)
+    {
+        result.add(chain);
+    }
+
+    for (auto *child : last->getChildren())
+    {
+        this->findChains(child, result);
+    }
+}
+
+void HistoryCompaction::squashChain(const ReferenceCountedArray<Revision> &chain, Report &report) const
+{
+    Revision::Ptr first = chain.getFirst();
+    Revision::Ptr last = chain.getLast();
+    Revision::Ptr parent = first->getParent().get();
+    jassert(parent != nullptr);
+
+    int numItemsBefore = 0;
+    for (const auto *revision : chain)
+    {
+        numItemsBefore += revision->getItems().size();
+        report.bytesBefore += getSerializedSize(revision->serializeDeltas());
+    }
+
+    Snapshot stateBefore;
+    applyPath(stateBefore, parent);
+
+    Snapshot stateAfter(stateBefore);
+    for (auto *revision : chain)
+    {
+        applyRevision(stateAfter, revision);
+    }
+
+    // the squashed revision is the diff between the two states,
+    // this way, all the intermediate states of the items are dropped,
+    // and the items which ended up the same as before are skipped
+    Revision::Ptr squashed(new Revision());
+
+    for (int i = 0; i < stateBefore.getNumTrackedItems(); ++i)
+    {
+        RevisionItem::Ptr beforeItem = static_cast<RevisionItem *>(stateBefore.getTrackedItem(i));
+        if (beforeItem->getType() == RevisionItem::Type::Removed) { continue; }
+
+        const auto afterItem = stateAfter.getItemWithUuid(beforeItem->getUuid());
+        if (afterItem == nullptr || afterItem->getType() == RevisionItem::Type::Removed)
+        {
+            UniquePointer<Diff> emptyDiff(new Diff(*beforeItem));
+            squashed->addItem(new RevisionItem(RevisionItem::Type::Removed, emptyDiff.get()));
+            continue;
+        }
+
+        UniquePointer<Diff> itemDiff(afterItem->getDiffLogic()->createDiff(*beforeItem));
+        if (itemDiff->hasAnyChanges())
+        {
+            squashed->addItem(new RevisionItem(RevisionItem::Type::Changed, itemDiff.get()));
+        }
+    }
+
+    for (int i = 0; i < stateAfter.getNumTrackedItems(); ++i)
+    {
+        RevisionItem::Ptr afterItem = static_cast<RevisionItem *>(stateAfter.getTrackedItem(i));
+        if (afterItem->getType() == RevisionItem::Type::Removed) { continue; }
+
+        const auto beforeItem = stateBefore.getItemWithUuid(afterItem->getUuid());
+        if (beforeItem == nullptr || beforeItem->getType() == RevisionItem::Type::Removed)
+        {
+            squashed->addItem(new RevisionItem(RevisionItem::Type::Added, afterItem.get()));
+        }
+    }
+
+    // the last revision of the chain takes the place of the whole chain,
+    // keeping its id, message and timestamp, and all its children
+    last->copyDeltasFrom(squashed);
+
+    chain[chain.size() - 2]->removeChild(last);
+    parent->removeChild(first);
+    parent->addChild(last);
+
+    report.numSquashedChains++;
+    report.numSquashedRevisions += chain.size() - 1;
+    report.numRemovedItems += jmax(0, numItemsBefore - squashed->getItems().size());
+    report.bytesAfter += getSerializedSize(last->serializeDeltas());
+}
+
+void HistoryCompaction::applyPath(Snapshot &state, const Revision::Ptr revision)
+{
+    ReferenceCountedArray<Revision> treePath;
+    Revision::Ptr currentRevision(revision);
+    while (currentRevision != nullptr)
+    {
+        treePath.insert(0, currentRevision);
+        currentRevision = currentRevision->getParent().get();
+    }
+
+    for (auto *rev : treePath)
+    {
+        applyRevision(state, rev);
+    }
+}
+
+void HistoryCompaction::applyRevision(Snapshot &state, const Revision::Ptr revision)
+{
+    for (auto *item : revision->getItems())
+    {
+        switch (item->getType())
+        {
+        case RevisionItem::Type::Added:
+            state.addItem(item);
+            break;
+        case RevisionItem::Type::Removed:
+            state.removeItem(item);
+            break;
+        case RevisionItem::Type::Changed:
+            state.mergeItem(item);
+            break;
+        default:
+            jassertfalse;
+            break;
+        }
+    }
+}
+
+int64 HistoryCompaction::getSerializedSize(const SerializedData &data)
+{
+    MemoryOutputStream stream;
+    data.writeToStream(stream);
+    return int64(stream.getDataSize());
+}
+
+} // namespace VCS
+
+#if JUCE_UNIT_TESTS
+
+class HistoryCompactionTests final : public UnitTest
+{
+public:
+    HistoryCompactionTests() : UnitTest("VCS history compaction tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        using namespace VCS;
+
+        beginTest("Squashing a linear chain keeps the head state");
+
+        const Uuid itemId;
+        Revision::Ptr root(new Revision("root"));
+        root->addItem(new RevisionItem(RevisionItem::Type::Added, this->makeItem(itemId, "t0", "me")));
+
+        // root -> r1 -> r2 -> r3 -> head, and another branch root -> b1
+        Revision::Ptr last(root);
+        ReferenceCountedArray<Revision> chain;
+        for (int i = 1; i <= 4; ++i)
+        {
+            Revision::Ptr revision(new Revision("r" + String(i)));
+            revision->addItem(new RevisionItem(RevisionItem::Type::Changed,
+                this->makeItem(itemId, "t" + String(i), "me")));
+            last->addChild(revision);
+            chain.add(revision);
+            last = revision;
+        }
+
+        Revision::Ptr branch(new Revision("b1"));
+        branch->addItem(new RevisionItem(RevisionItem::Type::Changed, this->makeItem(itemId, "t1", "me")));
+        root->addChild(branch);
+
+        const auto head = chain.getLast();
+        expectEquals(this->getTitleAt(head), String("t4"));
+
+        // everything is older than that
+        const RemoteCache remoteCache;
+        const HistoryCompaction compaction(remoteCache, head, Time::getCurrentTime() + RelativeTime::minutes(1));
+
+        HistoryCompaction::Report report;
+        compaction.squashChains(root, report);
+
+        expectEquals(report.numSquashedChains, 1);
+        expectEquals(report.numSquashedRevisions, 2);
+
+        // r1 and r2 are gone, r3 took their place and has the same resulting state
+        expectEquals(root->getChildren().size(), 2);
+        expect(root->getChildren().contains(chain[2]));
+        expect(!root->getChildren().contains(chain[0]));
+        expect(chain[2]->getParent() == root.get());
+        expect(head->getParent() == chain[2].get());
+        expectEquals(this->getTitleAt(chain[2]), String("t3"));
+        expectEquals(this->getTitleAt(head), String("t4"));
+        expectEquals(this->getTitleAt(branch), String("t1"));
+
+        beginTest("Identical delta data is shared");
+
+        const auto authorData = this->getAuthorData(root);
+        expect(this->getAuthorData(branch) != authorData);
+
+        const auto bytesSavedBySquashing = report.getBytesSaved();
+        compaction.deduplicateDeltas(root, report);
+
+        expect(report.numDeduplicatedDeltas > 0);
+        expectEquals(report.getBytesSaved(), bytesSavedBySquashing);
+        expect(this->getAuthorData(branch) == authorData);
+        expect(this->getAuthorData(head) == authorData);
+        expectEquals(this->getTitleAt(head), String("t4"));
+
+        // running it again finds nothing new
+        HistoryCompaction::Report secondReport;
+        compaction.squashChains(root, secondReport);
+        compaction.deduplicateDeltas(root, secondReport);
+        expectEquals(secondReport.numSquashedRevisions, 0);
+        expectEquals(secondReport.numDeduplicatedDeltas, 0);
+    }
+
+private:
+
+    // a minimal tracked item with the project info logic and two deltas
+    struct TestItem final : VCS::TrackedItem
+    {
+        TestItem(const Uuid &id, const String &title, const String &author) :
+            title(title), author(author)
+        {
+            using namespace Serialization::VCS;
+            this->vcsUuid = id;
+            this->logic = make<VCS::ProjectInfoDiffLogic>(*this);
+            this->deltas.add(new VCS::Delta({}, ProjectInfoDeltas::projectTitle));
+            this->deltas.add(new VCS::Delta({}, ProjectInfoDeltas::projectAuthor));
+        }
+
+        int getNumDeltas() const override { return this->deltas.size(); }
+        VCS::Delta *getDelta(int index) const override { return this->deltas[index]; }
+
+        SerializedData getDeltaData(int index) const override
+        {
+            using namespace Serialization::VCS;
+            const auto type = this->deltas[index]->getType();
+            SerializedData data(type);
+            data.setProperty(delta, type == ProjectInfoDeltas::projectTitle ? this->title : this->author);
+            return data;
+        }
+
+        String getVCSName() const override { return "test"; }
+        VCS::DiffLogic *getDiffLogic() const override { return this->logic.get(); }
+        void resetStateTo(const VCS::TrackedItem &newState) override {}
+
+        const String title;
+        const String author;
+        OwnedArray<VCS::Delta> deltas;
+        UniquePointer<VCS::DiffLogic> logic;
+    };
+
+    VCS::TrackedItem *makeItem(const Uuid &id, const String &title, const String &author)
+    {
+        return this->items.add(new TestItem(id, title, author));
+    }
+
+    static SerializedData findDeltaData(const VCS::Revision::Ptr revision, const Identifier &type)
+    {
+        for (const auto *item : revision->getItems())
+        {
+            for (int i = 0; i < item->getNumDeltas(); ++i)
+            {
+                if (item->getDelta(i)->hasType(type))
+                {
+                    return item->getDeltaData(i);
+                }
+            }
+        }
+
+        return {};
+    }
+
+    SerializedData getAuthorData(const VCS::Revision::Ptr revision) const
+    {
+        return findDeltaData(revision, Serialization::VCS::ProjectInfoDeltas::projectAuthor);
+    }
+
+    // the most recent title along the path from the root
+    String getTitleAt(const VCS::Revision::Ptr revision) const
+    {
+        using namespace Serialization::VCS;
+        for (VCS::Revision::Ptr it(revision); it != nullptr; it = it->getParent().get())
+        {
+            const auto data = findDeltaData(it, ProjectInfoDeltas::projectTitle);
+            if (data.isValid())
+            {
+                return data.getProperty(delta);
+            }
+        }
+
+        return {};
+    }
+
+    OwnedArray<TestItem> items;
+};
+
+static HistoryCompactionTests historyCompactionTests;
+
+#endif
@@ -0,0 +1,84 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Revision.h"
+#include "RemoteCache.h"
+
+namespace VCS
+{
+    class Snapshot;
+
+    // Squashes old linear chains of revisions into single revisions,
+    // so that long-lived projects don't keep all the intermediate states forever.
+    // Only the revisions that were never synced are squashed, otherwise
+    // the next sync would bring the original ones back from the remote.
+    // Then makes all identical delta data in the history share one instance,
+    // e.g. the same track colour or the same key signatures stored over and over.
+
+    class HistoryCompaction final
+    {
+    public:
+
+        struct Report final
+        {
+            int numSquashedChains = 0;
+            int numSquashedRevisions = 0;
+            int numRemovedItems = 0;
+            int numRemovedStashes = 0;
+            int numDeduplicatedDeltas = 0;
+            int64 bytesBefore = 0;
+            int64 bytesAfter = 0;
+            double elapsedMs = 0.0;
+
+            // the shared deltas only save memory, since the writers
+            // still store each of them in full, so only squashing counts
+            int64 getBytesSaved() const noexcept;
+            String toString() const;
+        };
+
+        HistoryCompaction(const RemoteCache &remoteCache,
+            Revision::Ptr head, Time olderThan);
+
+        void squashChains(Revision::Ptr root, Report &report) const;
+        void deduplicateDeltas(Revision::Ptr root, Report &report) const;
+
+    private:
+
+        bool canBeSquashed(const Revision::Ptr revision) const;
+
+        void findChains(Revision::Ptr root,
+            Array<ReferenceCountedArray<Revision>> &result) const;
+
+        void squashChain(const ReferenceCountedArray<Revision> &chain, Report &report) const;
+
+        static void applyRevision(Snapshot &state, const Revision::Ptr revision);
+        static void applyPath(Snapshot &state, const Revision::Ptr revision);
+        static int64 getSerializedSize(const SerializedData &data);
+
+        using DeltaDataIndex = FlatHashMap<uint64, Array<SerializedData>>;
+        static void deduplicateDeltas(Revision::Ptr revision,
+            DeltaDataIndex &index, Report &report);
+
+        const RemoteCache &remoteCache;
+        const Revision::Ptr head;
+        const int64 olderThanMs;
+
+        JUCE_DECLARE_NON_COPYABLE(HistoryCompaction)
+    };
+} // namespace VCS
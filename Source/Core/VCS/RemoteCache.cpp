@@ -56,12 +56,43 @@ bool RemoteCache::isOutdated() const
         (Time::getCurrentTime() - this->lastSyncTime).inDays() > 1;
 }
 
+Array<String> RemoteCache::getPendingPulls() const
+{
+    ScopedReadLock lock(this->cacheLock);
+
+    Array<String> result;
+    for (const auto &revisionId : this->pendingPulls)
+    {
+        result.add(revisionId);
+    }
+
+    return result;
+}
+
+void RemoteCache::setPendingPulls(const Array<String> &revisionIds)
+{
+    ScopedWriteLock lock(this->cacheLock);
+
+    this->pendingPulls.clear();
+    for (const auto &revisionId : revisionIds)
+    {
+        this->pendingPulls.insert(revisionId);
+    }
+}
+
+void RemoteCache::updateForPulledRevision(const String &revisionId)
+{
+    ScopedWriteLock lock(this->cacheLock);
+    this->pendingPulls.erase(revisionId);
+}
+
 //===----------------------------------------------------------------------===//
 // Serializable
 //===----------------------------------------------------------------------===//
 
 SerializedData RemoteCache::serialize() const
 {
+    ScopedReadLock lock(this->cacheLock);
     SerializedData tree(Serialization::VCS::remoteCache);
 
     tree.setProperty(Serialization::VCS::remoteCacheSyncTime, this->lastSyncTime.toMilliseconds());
@@ -74,6 +105,13 @@ SerializedData RemoteCache::serialize() const
         tree.appendChild(revNode);
     }
 
+    for (const auto &revisionId : this->pendingPulls)
+    {
+        SerializedData pullNode(Serialization::VCS::remotePendingPull);
+        pullNode.setProperty(Serialization::VCS::remoteRevisionId, revisionId);
+        tree.appendChild(pullNode);
+    }
+
     return tree;
 }
 
@@ -94,11 +132,17 @@ void RemoteCache::deserialize(const SerializedData &data)
         const int64 revisionTimestamp = e.getProperty(Serialization::VCS::remoteRevisionTimeStamp);
         this->fetchCache[revisionId] = revisionTimestamp;
     }
+
+    forEachChildWithType(root, e, Serialization::VCS::remotePendingPull)
+    {
+        this->pendingPulls.insert(e.getProperty(Serialization::VCS::remoteRevisionId).toString());
+    }
 }
 
 void RemoteCache::reset()
 {
     this->fetchCache.clear();
+    this->pendingPulls.clear();
 }
 
 }
@@ -36,6 +36,13 @@ namespace VCS
 
         bool isOutdated() const;
 
+        // the revisions a sync has started pulling, but has not received yet;
+        // if the sync gets interrupted, the next one only resumes pulling them,
+        // leaving alone the shallow copies which were never requested to pull
+        Array<String> getPendingPulls() const;
+        void setPendingPulls(const Array<String> &revisionIds);
+        void updateForPulledRevision(const String &revisionId);
+
         //===------------------------------------------------------------------===//
         // Serializable
         //===------------------------------------------------------------------===//
@@ -50,6 +57,7 @@ namespace VCS
 
         ReadWriteLock cacheLock;
         FlatHashMap<String, int64, StringHash> fetchCache;
+        FlatHashSet<String, StringHash> pendingPulls;
         Time lastSyncTime;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteCache)
@@ -112,6 +112,12 @@ void Revision::addItem(RevisionItem::Ptr item)
     this->deltas.add(item);
 }
 
+void Revision::replaceItem(int index, RevisionItem::Ptr item)
+{
+    jassert(isPositiveAndBelow(index, this->deltas.size()));
+    this->deltas.set(index, item);
+}
+
 WeakReference<Revision> Revision::getParent() const noexcept
 {
     return this->parent;
@@ -174,6 +180,44 @@ SerializedData Revision::serialize() const
     return tree;
 }
 
+SerializedSnapshot Revision::createSnapshot() const
+{
+    // the items are never changed once they are in the history,
+    // so it's enough to hold them by reference
+    const auto items = this->deltas;
+
+    Array<SerializedSnapshot> children;
+    for (const auto *child : this->children)
+    {
+        children.add(child->createSnapshot());
+    }
+
+    const auto id = this->id;
+    const auto message = this->message;
+    const auto timestamp = this->timestamp;
+
+    return [id, message, timestamp, items, children](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::VCS::revision, 3, items.size() + children.size());
+
+        writer.writeProperty(Serialization::VCS::commitId, id);
+        writer.writeProperty(Serialization::VCS::commitMessage, message);
+        writer.writeProperty(Serialization::VCS::commitTimeStamp, timestamp);
+
+        for (const auto *item : items)
+        {
+            item->serializeTo(writer);
+        }
+
+        for (const auto &child : children)
+        {
+            child(writer);
+        }
+
+        writer.endNode();
+    };
+}
+
 void Revision::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -44,6 +44,7 @@ namespace VCS
 
         void addItem(RevisionItem *item);
         void addItem(RevisionItem::Ptr item);
+        void replaceItem(int index, RevisionItem::Ptr item);
 
         void addChild(Revision *revision);
         void addChild(Revision::Ptr revision);
@@ -71,6 +72,7 @@ namespace VCS
         void deserializeDeltas(SerializedData data);
 
         SerializedData serialize() const;
+        SerializedSnapshot createSnapshot() const override;
         void deserialize(const SerializedData &data);
         void reset();
 
@@ -67,6 +67,13 @@ String RevisionItem::getTypeAsString() const
     return {};
 }
 
+void RevisionItem::shareDeltaData(int deltaIndex, const SerializedData &equivalentData)
+{
+    jassert(isPositiveAndBelow(deltaIndex, this->deltasData.size()));
+    jassert(this->deltasData[deltaIndex].isEquivalentTo(equivalentData));
+    this->deltasData.set(deltaIndex, equivalentData);
+}
+
 //===----------------------------------------------------------------------===//
 // TrackedItem
 //===----------------------------------------------------------------------===//
@@ -128,6 +135,41 @@ SerializedData RevisionItem::serialize() const
     return tree;
 }
 
+void RevisionItem::serializeTo(SerializedDataWriter &writer) const
+{
+    // same as serialize(), but writes the shared delta data as is,
+    // without copying or re-parenting it, so it's safe to use in
+    // the autosave thread while the history is being used elsewhere
+    SerializedData header(Serialization::VCS::revisionItem);
+
+    this->serializeVCSUuid(header);
+
+    header.setProperty(Serialization::VCS::revisionItemType, int(this->getType()));
+    header.setProperty(Serialization::VCS::revisionItemName, this->getVCSName());
+    header.setProperty(Serialization::VCS::revisionItemDiffLogic, this->getDiffLogic()->getType().toString());
+
+    int numDeltasWithData = 0;
+    for (int i = 0; i < this->deltas.size(); ++i)
+    {
+        numDeltasWithData += this->getDeltaData(i).isValid() ? 1 : 0;
+    }
+
+    writer.beginNode(header, numDeltasWithData);
+
+    for (int i = 0; i < this->deltas.size(); ++i)
+    {
+        const SerializedData deltaData(this->getDeltaData(i));
+        if (deltaData.isValid())
+        {
+            writer.beginNode(this->deltas.getUnchecked(i)->serialize(), 1);
+            writer.writeTree(deltaData);
+            writer.endNode();
+        }
+    }
+
+    writer.endNode();
+}
+
 void RevisionItem::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -41,6 +41,11 @@ namespace VCS
         RevisionItem::Type getType() const noexcept;
         String getTypeAsString() const;
 
+        // used by history compaction to make equivalent delta data
+        // of different revisions point to the same instance;
+        // only call this on a fresh copy which is not in the history yet
+        void shareDeltaData(int deltaIndex, const SerializedData &equivalentData);
+
         //===--------------------------------------------------------------===//
         // TrackedItem
         //===--------------------------------------------------------------===//
@@ -58,6 +63,7 @@ namespace VCS
         //===--------------------------------------------------------------===//
 
         SerializedData serialize() const override;
+        void serializeTo(SerializedDataWriter &writer) const override;
         void deserialize(const SerializedData &data) override;
         void reset() override;
 
@@ -64,6 +64,25 @@ void StashesRepository::removeStash(Revision::Ptr stashToRemove)
     this->userStashes->removeChild(stashToRemove);
 }
 
+int StashesRepository::removeEmptyStashes()
+{
+    ReferenceCountedArray<Revision> emptyStashes;
+    for (auto *stash : this->userStashes->getChildren())
+    {
+        if (stash->isEmpty())
+        {
+            emptyStashes.add(stash);
+        }
+    }
+
+    for (auto *stash : emptyStashes)
+    {
+        this->userStashes->removeChild(stash);
+    }
+
+    return emptyStashes.size();
+}
+
 Revision::Ptr StashesRepository::getQuickStash() const noexcept
 {
     return this->quickStash;
@@ -106,6 +125,27 @@ SerializedData StashesRepository::serialize() const
     return tree;
 }
 
+SerializedSnapshot StashesRepository::createSnapshot() const
+{
+    const auto userStashes = this->userStashes->createSnapshot();
+    const auto quickStash = this->quickStash->createSnapshot();
+
+    return [userStashes, quickStash](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::VCS::stashesRepository, 0, 2);
+
+        writer.beginNode(Serialization::VCS::userStashes, 0, 1);
+        userStashes(writer);
+        writer.endNode();
+
+        writer.beginNode(Serialization::VCS::quickStash, 0, 1);
+        quickStash(writer);
+        writer.endNode();
+
+        writer.endNode();
+    };
+}
+
 void StashesRepository::deserialize(const SerializedData &data)
 {
     this->reset();
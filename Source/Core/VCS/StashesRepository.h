@@ -39,12 +39,14 @@ namespace VCS
         
         void addStash(Revision::Ptr newStash);
         void removeStash(Revision::Ptr stashToRemove);
+        int removeEmptyStashes();
 
         //===--------------------------------------------------------------===//
         // Serializable
         //===--------------------------------------------------------------===//
 
         SerializedData serialize() const override;
+        SerializedSnapshot createSnapshot() const override;
         void deserialize(const SerializedData &data) override;
         void reset() override;
 
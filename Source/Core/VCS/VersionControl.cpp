@@ -111,6 +111,7 @@ VCS::Revision::Ptr VersionControl::updateShallowRevisionData(const String &id, c
             this->sendChangeMessage();
         }
 
+        this->remoteCache.updateForPulledRevision(id);
         return revision;
     }
 
@@ -191,6 +192,31 @@ bool VersionControl::commit(SparseSet<int> selectedItems, const String &message)
 }
 
 
+VCS::HistoryCompaction::Report VersionControl::compactHistory(RelativeTime maxAge)
+{
+    const auto startTime = Time::getMillisecondCounterHiRes();
+
+    VCS::HistoryCompaction::Report report;
+    const VCS::HistoryCompaction compaction(this->remoteCache,
+        this->head.getHeadingRevision(), Time::getCurrentTime() - maxAge);
+
+    compaction.squashChains(this->rootRevision, report);
+    compaction.deduplicateDeltas(this->rootRevision, report);
+    report.numRemovedStashes = this->stashes->removeEmptyStashes();
+    report.elapsedMs = Time::getMillisecondCounterHiRes() - startTime;
+
+    DBG("History compaction: " + report.toString());
+
+    if (report.numSquashedRevisions > 0 ||
+        report.numRemovedStashes > 0 ||
+        report.numDeduplicatedDeltas > 0)
+    {
+        this->sendChangeMessage();
+    }
+
+    return report;
+}
+
 //===----------------------------------------------------------------------===//
 // Stashes
 //===----------------------------------------------------------------------===//
@@ -358,6 +384,16 @@ void VersionControl::updateRemoteSyncCache(const Array<RevisionDto> &revisions)
     this->sendChangeMessage();
 }
 
+Array<String> VersionControl::getPendingPulls() const
+{
+    return this->remoteCache.getPendingPulls();
+}
+
+void VersionControl::setPendingPulls(const Array<String> &revisionIds)
+{
+    this->remoteCache.setPendingPulls(revisionIds);
+}
+
 VCS::Revision::SyncState VersionControl::getRevisionSyncState(const VCS::Revision::Ptr revision) const
 {
     if (!revision->isShallowCopy() && this->remoteCache.hasRevisionTracked(revision))
@@ -390,6 +426,26 @@ SerializedData VersionControl::serialize() const
     return tree;
 }
 
+SerializedSnapshot VersionControl::createSnapshot() const
+{
+    const auto headRevisionId = this->head.getHeadingRevision()->getUuid();
+    const auto history = this->rootRevision->createSnapshot();
+    const auto stashes = this->stashes->createSnapshot();
+    const auto head = this->head.createSnapshot();
+    const auto remoteCache = this->remoteCache.createSnapshot();
+
+    return [headRevisionId, history, stashes, head, remoteCache](SerializedDataWriter &writer)
+    {
+        writer.beginNode(Serialization::Core::versionControl, 1, 4);
+        writer.writeProperty(Serialization::VCS::headRevisionId, headRevisionId);
+        history(writer);
+        stashes(writer);
+        head(writer);
+        remoteCache(writer);
+        writer.endNode();
+    };
+}
+
 void VersionControl::deserialize(const SerializedData &data)
 {
     this->reset();
@@ -29,6 +29,7 @@ class VersionControlEditor;
 #include "Head.h"
 #include "RemoteCache.h"
 #include "StashesRepository.h"
+#include "HistoryCompaction.h"
 
 class VersionControl final :
     public Serializable,
@@ -66,6 +67,10 @@ public:
     bool commit(SparseSet<int> selectedItems, const String &message);
     void quickAmendItem(VCS::TrackedItem *targetItem); // for first commit
 
+    // squashes the unsynced linear chains of revisions older than maxAge,
+    // shares identical delta data and drops the stashes with nothing in them
+    VCS::HistoryCompaction::Report compactHistory(RelativeTime maxAge = RelativeTime::days(30));
+
     //===------------------------------------------------------------------===//
     // Version control: stashes
     //===------------------------------------------------------------------===//
@@ -89,6 +94,9 @@ public:
 
     void updateLocalSyncCache(const VCS::Revision::Ptr revision);
     void updateRemoteSyncCache(const Array<RevisionDto> &revisions);
+
+    Array<String> getPendingPulls() const;
+    void setPendingPulls(const Array<String> &revisionIds);
     VCS::Revision::SyncState getRevisionSyncState(const VCS::Revision::Ptr revision) const;
 
     //===------------------------------------------------------------------===//
@@ -96,6 +104,7 @@ public:
     //===------------------------------------------------------------------===//
 
     SerializedData serialize() const override;
+    SerializedSnapshot createSnapshot() const override;
     void deserialize(const SerializedData &data) override;
     void reset() override;
 
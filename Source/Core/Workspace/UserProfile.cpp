@@ -23,6 +23,7 @@
 #include "ResourceSyncService.h"
 #include "Network.h"
 #include "Config.h"
+#include "UndoJournal.h"
 
 static UserSessionInfo kSessionsSort;
 static RecentProjectInfo kProjectsSort;
@@ -234,6 +235,7 @@ void UserProfile::deleteProjectLocally(const String &id)
         if (project->hasLocalCopy())
         {
             project->getLocalFile().deleteFile();
+            UndoJournal::getFileFor(project->getLocalFile()).deleteFile();
             this->onProjectLocalInfoReset(id);
         }
     }
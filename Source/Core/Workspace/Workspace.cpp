@@ -27,6 +27,7 @@
 #include "SettingsNode.h"
 #include "OrchestraPitNode.h"
 #include "ProjectNode.h"
+#include "UndoJournal.h"
 #include "Dashboard.h"
 #include "CommandPaletteProjectsList.h"
 
@@ -260,6 +261,12 @@ void Workspace::unloadProject(const String &projectId, bool deleteLocally, bool
         {
             this->userProfile.deleteProjectRemotely(projectId);
         }
+
+        // the history of a project which is gone is never restored
+        if (!localFile.existsAsFile())
+        {
+            UndoJournal::getFileFor(localFile).deleteFile();
+        }
     }
     
     if (shouldSwitchToOtherPage)
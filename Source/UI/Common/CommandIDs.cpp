@@ -163,6 +163,7 @@ CommandIDs::Id CommandIDs::getIdForName(const String &command)
         CASE_FOR(VersionControlResetSelected)
         CASE_FOR(VersionControlCommitSelected)
         CASE_FOR(VersionControlCheckout)
+        CASE_FOR(VersionControlCompactHistory)
         CASE_FOR(PatternsGroupByName)
         CASE_FOR(PatternsGroupByColour)
         CASE_FOR(PatternsGroupByInstrument)
@@ -335,6 +336,7 @@ Identifier CommandIDs::getTranslationKeyFor(CommandIDs::Id id)
         TRANS_KEY(VersionControlResetSelected, Menu::Selection::vcsReset)
         TRANS_KEY(VersionControlCommitSelected, Menu::Selection::vcsCommit)
         TRANS_KEY(VersionControlCheckout, Menu::Selection::vcsCheckout)
+        TRANS_KEY(VersionControlCompactHistory, Menu::vcsCompactHistory)
         TRANS_KEY(PatternsGroupByName, Menu::groupByName)
         TRANS_KEY(PatternsGroupByColour, Menu::groupByColour)
         TRANS_KEY(PatternsGroupByInstrument, Menu::groupByInstrument)
@@ -190,6 +190,7 @@ namespace CommandIDs
         VersionControlResetSelected     = 0x4068,
         VersionControlCommitSelected    = 0x4069,
         VersionControlCheckout          = 0x406a,
+        VersionControlCompactHistory    = 0x406b,
 
         PatternsGroupByName             = 0x4100,
         PatternsGroupByColour           = 0x4101,
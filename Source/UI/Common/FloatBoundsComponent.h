@@ -36,8 +36,17 @@ public:
         this->setBounds(bX, bY, bW, bH);
     }
 
+    // Whether the roll keeps this component positioned and visible,
+    // see HybridRollCulling; other components just ignore this flag
+    inline bool isLaidOut() const noexcept { return this->laidOut; }
+    inline void setLaidOut(bool value) noexcept { this->laidOut = value; }
+
 protected:
 
     Rectangle<float> floatLocalBounds;
 
+private:
+
+    bool laidOut = false;
+
 };
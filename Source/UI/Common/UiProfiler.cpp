@@ -0,0 +1,346 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "UiProfiler.h"
+
+bool UiProfiler::enabled = false;
+
+// intervals longer than that mean the UI was idle, not slow
+static constexpr double maxProfiledFrameIntervalMs = 250.0;
+
+// how many recent events to keep for the trace export
+static constexpr int maxProfiledTraceEvents = 1 << 16;
+
+struct UiProfilerTraceEvent final
+{
+    const char *name;
+    double startMs;
+    double durationMs;
+    bool isFrame;
+};
+
+struct UiProfilerData final
+{
+    double startTime = 0.0;
+    double lastFrameTime = 0.0;
+
+    FlatHashMap<const char *, UiProfiler::Section> sections;
+
+    int frameBuckets[UiProfiler::numFrameBuckets] = {};
+    int numFrames = 0;
+    double totalFramesMs = 0.0;
+    int64 totalFramesArea = 0;
+
+    Array<UiProfilerTraceEvent> trace;
+    int nextTraceEvent = 0;
+
+    void addTraceEvent(const char *name, double start, double duration, bool isFrame)
+    {
+        const UiProfilerTraceEvent event{ name, start - this->startTime, duration, isFrame };
+        if (this->trace.size() < maxProfiledTraceEvents)
+        {
+            this->trace.add(event);
+        }
+        else
+        {
+            this->trace.getReference(this->nextTraceEvent) = event;
+        }
+
+        this->nextTraceEvent = (this->nextTraceEvent + 1) % maxProfiledTraceEvents;
+    }
+};
+
+static UiProfilerData &getUiProfilerData()
+{
+    static UiProfilerData data;
+    return data;
+}
+
+void UiProfiler::setEnabled(bool shouldBeEnabled)
+{
+    if (UiProfiler::enabled != shouldBeEnabled)
+    {
+        UiProfiler::reset();
+        UiProfiler::enabled = shouldBeEnabled;
+    }
+}
+
+void UiProfiler::reset()
+{
+    auto &data = getUiProfilerData();
+    data.startTime = Time::getMillisecondCounterHiRes();
+    data.lastFrameTime = 0.0;
+    data.sections.clear();
+    zeromem(data.frameBuckets, sizeof(data.frameBuckets));
+    data.numFrames = 0;
+    data.totalFramesMs = 0.0;
+    data.totalFramesArea = 0;
+    data.trace.clear();
+    data.nextTraceEvent = 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Paint scopes
+//===----------------------------------------------------------------------===//
+
+UiProfiler::ScopedPaint::ScopedPaint(const char *name, const Graphics &g) noexcept
+{
+    if (UiProfiler::enabled)
+    {
+        this->name = name;
+        this->area = int64(g.getClipBounds().getWidth()) * g.getClipBounds().getHeight();
+        this->startTime = Time::getMillisecondCounterHiRes();
+    }
+}
+
+UiProfiler::ScopedPaint::~ScopedPaint() noexcept
+{
+    // the profiler could have been enabled in the middle of the scope
+    if (!UiProfiler::enabled || this->name == nullptr)
+    {
+        return;
+    }
+
+    const auto duration = Time::getMillisecondCounterHiRes() - this->startTime;
+
+    auto &data = getUiProfilerData();
+    auto &section = data.sections[this->name];
+    section.name = this->name;
+    section.numPaints++;
+    section.paintedArea += this->area;
+    section.totalMs += duration;
+    section.maxMs = jmax(section.maxMs, duration);
+
+    data.addTraceEvent(this->name, this->startTime, duration, false);
+}
+
+//===----------------------------------------------------------------------===//
+// Frames
+//===----------------------------------------------------------------------===//
+
+double UiProfiler::getFrameBucketLimitMs(int bucket) noexcept
+{
+    static const double limits[] = { 4.0, 8.0, 12.0, 16.7, 25.0, 33.3, 50.0 };
+    jassert(bucket >= 0 && bucket < UiProfiler::numFrameBuckets);
+    return bucket < UiProfiler::numFrameBuckets - 1 ?
+        limits[bucket] : std::numeric_limits<double>::max();
+}
+
+void UiProfiler::onFramePainted(const Graphics &g) noexcept
+{
+    if (!UiProfiler::enabled)
+    {
+        return;
+    }
+
+    auto &data = getUiProfilerData();
+    const auto now = Time::getMillisecondCounterHiRes();
+    const auto interval = now - data.lastFrameTime;
+    const auto lastFrameTime = data.lastFrameTime;
+    data.lastFrameTime = now;
+
+    if (lastFrameTime <= 0.0 || interval > maxProfiledFrameIntervalMs)
+    {
+        return;
+    }
+
+    int bucket = 0;
+    while (interval > UiProfiler::getFrameBucketLimitMs(bucket))
+    {
+        bucket++;
+    }
+
+    data.frameBuckets[bucket]++;
+    data.numFrames++;
+    data.totalFramesMs += interval;
+    data.totalFramesArea += int64(g.getClipBounds().getWidth()) * g.getClipBounds().getHeight();
+
+    data.addTraceEvent("Frame", lastFrameTime, interval, true);
+}
+
+int UiProfiler::getNumFramesInBucket(int bucket) noexcept
+{
+    jassert(bucket >= 0 && bucket < UiProfiler::numFrameBuckets);
+    return getUiProfilerData().frameBuckets[bucket];
+}
+
+int UiProfiler::getNumFrames() noexcept
+{
+    return getUiProfilerData().numFrames;
+}
+
+double UiProfiler::getAverageFrameMs() noexcept
+{
+    const auto &data = getUiProfilerData();
+    return data.numFrames > 0 ? data.totalFramesMs / data.numFrames : 0.0;
+}
+
+int64 UiProfiler::getAverageFrameArea() noexcept
+{
+    const auto &data = getUiProfilerData();
+    return data.numFrames > 0 ? data.totalFramesArea / data.numFrames : 0;
+}
+
+//===----------------------------------------------------------------------===//
+// Reports
+//===----------------------------------------------------------------------===//
+
+struct UiProfilerSectionsSorter final
+{
+    static int compareElements(const UiProfiler::Section &first,
+        const UiProfiler::Section &second) noexcept
+    {
+        return (first.totalMs < second.totalMs) - (first.totalMs > second.totalMs);
+    }
+};
+
+Array<UiProfiler::Section> UiProfiler::getSections()
+{
+    Array<Section> result;
+    for (const auto &it : getUiProfilerData().sections)
+    {
+        // the same literal used in different places may have different addresses:
+        bool merged = false;
+        for (auto &section : result)
+        {
+            if (strcmp(section.name, it.second.name) == 0)
+            {
+                section.numPaints += it.second.numPaints;
+                section.paintedArea += it.second.paintedArea;
+                section.totalMs += it.second.totalMs;
+                section.maxMs = jmax(section.maxMs, it.second.maxMs);
+                merged = true;
+                break;
+            }
+        }
+
+        if (!merged)
+        {
+            result.add(it.second);
+        }
+    }
+
+    UiProfilerSectionsSorter sorter;
+    result.sort(sorter);
+    return result;
+}
+
+static void writeTraceEvent(OutputStream &out, const UiProfilerTraceEvent &event)
+{
+    // the scopes are nested by time on the same thread id,
+    // and the frames are shown as a separate track:
+    out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+        << (event.isFrame ? 2 : 1)
+        << ",\"ts\":" << String(event.startMs * 1000.0, 3)
+        << ",\"dur\":" << String(event.durationMs * 1000.0, 3) << "}";
+}
+
+bool UiProfiler::exportChromeTrace(const File &file)
+{
+    TemporaryFile tempFile(file);
+
+    {
+        FileOutputStream out(tempFile.getFile());
+        if (!out.openedOk())
+        {
+            return false;
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Paint\"}},\n"
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Frames\"}}";
+
+        // the ring buffer starts with the oldest event once it's full:
+        const auto &data = getUiProfilerData();
+        const int firstEvent = data.trace.size() < maxProfiledTraceEvents ? 0 : data.nextTraceEvent;
+        for (int i = 0; i < data.trace.size(); ++i)
+        {
+            writeTraceEvent(out, data.trace.getReference((firstEvent + i) % data.trace.size()));
+        }
+
+        out << "\n]}\n";
+        out.flush();
+
+        if (out.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+//===----------------------------------------------------------------------===//
+// Tests
+//===----------------------------------------------------------------------===//
+
+#if JUCE_UNIT_TESTS
+
+class UiProfilerTests final : public UnitTest
+{
+public:
+    UiProfilerTests() : UnitTest("UI profiler tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        Image image(Image::ARGB, 64, 32, true);
+        Graphics g(image);
+
+        beginTest("Disabled profiler doesn't record anything");
+
+        UiProfiler::setEnabled(false);
+        {
+            UI_PROFILE_PAINT("Test::disabled", g);
+        }
+
+        expect(UiProfiler::getSections().isEmpty());
+
+        beginTest("Paint scopes are accounted by name");
+
+        UiProfiler::setEnabled(true);
+        for (int i = 0; i < 3; ++i)
+        {
+            UI_PROFILE_PAINT("Test::outer", g);
+            UI_PROFILE_PAINT("Test::inner", g);
+        }
+
+        const auto sections = UiProfiler::getSections();
+        expectEquals(sections.size(), 2);
+        expectEquals(sections[0].numPaints, 3);
+        expectEquals(sections[0].paintedArea, int64(64 * 32 * 3));
+        expect(sections[0].totalMs >= sections[1].totalMs);
+
+        beginTest("Chrome trace export");
+
+        const TemporaryFile tempFile;
+        expect(UiProfiler::exportChromeTrace(tempFile.getFile()));
+
+        const auto json = JSON::parse(tempFile.getFile());
+        const auto *events = json["traceEvents"].getArray();
+        expect(events != nullptr);
+        // two thread name records and six scopes:
+        expectEquals(events->size(), 8);
+        expectEquals(events->getLast()["ph"].toString(), String("X"));
+
+        UiProfiler::setEnabled(false);
+    }
+};
+
+static UiProfilerTests uiProfilerTests;
+
+#endif
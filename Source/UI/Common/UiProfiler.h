@@ -0,0 +1,87 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Collects the paint times of the instrumented components and drawing helpers,
+// the areas they repaint and the intervals between the frames, so that UI
+// slowdowns can be measured instead of guessed; disabled by default,
+// in which case each instrumented scope costs a single flag check.
+// All the data is only accessed either from the message thread, or while
+// painting, which is done under the message manager lock even with OpenGL.
+class UiProfiler final
+{
+public:
+
+    static inline bool isEnabled() noexcept { return UiProfiler::enabled; }
+    static void setEnabled(bool shouldBeEnabled);
+
+    // Measures the enclosing scope and the clip area of the graphics context;
+    // the name is expected to be a string literal, it is never copied:
+    class ScopedPaint final
+    {
+    public:
+
+        ScopedPaint(const char *name, const Graphics &g) noexcept;
+        ~ScopedPaint() noexcept;
+
+    private:
+
+        const char *name = nullptr;
+        double startTime = 0.0;
+        int64 area = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedPaint)
+    };
+
+    // Should be called once at the end of each paint pass of the main window
+    static void onFramePainted(const Graphics &g) noexcept;
+
+    struct Section final
+    {
+        const char *name = nullptr;
+        int numPaints = 0;
+        int64 paintedArea = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    // sorted by the total time, longest first
+    static Array<Section> getSections();
+
+    static constexpr int numFrameBuckets = 8;
+    // upper bound of the bucket, the last one has none
+    static double getFrameBucketLimitMs(int bucket) noexcept;
+    static int getNumFramesInBucket(int bucket) noexcept;
+    static int getNumFrames() noexcept;
+    static double getAverageFrameMs() noexcept;
+    static int64 getAverageFrameArea() noexcept;
+
+    // Writes the recent paint scopes and frames in the Chrome trace event
+    // format, which can be opened in chrome://tracing or in Perfetto:
+    static bool exportChromeTrace(const File &file);
+
+    static void reset();
+
+private:
+
+    static bool enabled;
+
+};
+
+#define UI_PROFILE_PAINT(name, g) \
+    const UiProfiler::ScopedPaint profiledPaintScope(name, g)
@@ -0,0 +1,134 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "UiProfilerOverlay.h"
+#include "UiProfiler.h"
+
+UiProfilerOverlay::UiProfilerOverlay()
+{
+    this->setOpaque(false);
+    this->setInterceptsMouseClicks(false, false);
+    this->setWantsKeyboardFocus(false);
+    this->setSize(UiProfilerOverlay::overlayWidth, UiProfilerOverlay::overlayHeight);
+
+    // refreshing the stats rarely enough not to affect them much:
+    this->startTimer(500);
+}
+
+UiProfilerOverlay::~UiProfilerOverlay()
+{
+    this->stopTimer();
+}
+
+void UiProfilerOverlay::paint(Graphics &g)
+{
+    const int w = this->getWidth();
+    const int h = this->getHeight();
+    const int textWidth = w - 16;
+
+    g.setColour(Colours::black.withAlpha(0.75f));
+    g.fillRect(0, 0, w, h);
+
+    g.setFont(12.f);
+    g.setColour(Colours::white);
+
+    int y = 4;
+    const auto averageFrameMs = UiProfiler::getAverageFrameMs();
+    g.drawText("Frames: " + String(UiProfiler::getNumFrames()) +
+        ", avg " + String(averageFrameMs, 1) + " ms" +
+        (averageFrameMs > 0.0 ? " (" + String(roundToInt(1000.0 / averageFrameMs)) + " fps)" : String()) +
+        ", avg repainted " + String(UiProfiler::getAverageFrameArea()) + " px",
+        8, y, textWidth, rowHeight, Justification::centredLeft, true);
+
+    y += rowHeight + 4;
+
+    // the frame time histogram:
+    int maxFramesInBucket = 1;
+    for (int i = 0; i < UiProfiler::numFrameBuckets; ++i)
+    {
+        maxFramesInBucket = jmax(maxFramesInBucket, UiProfiler::getNumFramesInBucket(i));
+    }
+
+    const int barsHeight = 64;
+    const int barWidth = textWidth / UiProfiler::numFrameBuckets;
+    for (int i = 0; i < UiProfiler::numFrameBuckets; ++i)
+    {
+        const int x = 8 + i * barWidth;
+        const int numFrames = UiProfiler::getNumFramesInBucket(i);
+        const int barHeight = numFrames * barsHeight / maxFramesInBucket;
+
+        // green below 60 fps, yellow below 30 fps, red above that
+        const auto limit = UiProfiler::getFrameBucketLimitMs(i);
+        g.setColour(limit <= 16.7 ? Colours::limegreen : (limit <= 33.3 ? Colours::gold : Colours::orangered));
+        g.fillRect(x + 2, y + barsHeight - barHeight, barWidth - 4, barHeight);
+
+        const auto label = (i < UiProfiler::numFrameBuckets - 1) ?
+            "<" + String(roundToInt(limit)) : ">" + String(roundToInt(UiProfiler::getFrameBucketLimitMs(i - 1)));
+
+        g.setColour(Colours::white.withAlpha(0.75f));
+        g.drawText(label, x, y + barsHeight, barWidth, rowHeight, Justification::centred, false);
+    }
+
+    y += barsHeight + rowHeight + 4;
+
+    // the slowest paint scopes:
+    g.setColour(Colours::white);
+    g.drawText("Scope", 8, y, textWidth, rowHeight, Justification::centredLeft, false);
+    g.drawText("paints / total ms / max ms / avg px", 8, y, textWidth, rowHeight, Justification::centredRight, false);
+    y += rowHeight;
+
+    g.setColour(Colours::white.withAlpha(0.85f));
+    const auto sections = UiProfiler::getSections();
+    for (int i = 0; i < jmin(sections.size(), UiProfilerOverlay::maxShownSections); ++i)
+    {
+        const auto &section = sections.getReference(i);
+        const auto averageArea = section.numPaints > 0 ? section.paintedArea / section.numPaints : 0;
+
+        g.drawText(section.name, 8, y, textWidth, rowHeight, Justification::centredLeft, true);
+        g.drawText(String(section.numPaints) + " / " +
+            String(section.totalMs, 1) + " / " +
+            String(section.maxMs, 2) + " / " +
+            String(averageArea), 8, y, textWidth, rowHeight, Justification::centredRight, false);
+
+        y += rowHeight;
+    }
+}
+
+void UiProfilerOverlay::parentHierarchyChanged()
+{
+    this->updatePosition();
+}
+
+void UiProfilerOverlay::parentSizeChanged()
+{
+    this->updatePosition();
+}
+
+void UiProfilerOverlay::timerCallback()
+{
+    this->repaint();
+}
+
+void UiProfilerOverlay::updatePosition()
+{
+    if (auto *parent = this->getParentComponent())
+    {
+        this->setTopLeftPosition(parent->getWidth() - this->getWidth() - 8,
+            Globals::UI::headlineHeight + 8);
+    }
+}
@@ -0,0 +1,49 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Shows what the UI profiler has collected so far: the frame time histogram,
+// and the instrumented paint scopes which took the most time;
+// doesn't take any mouse input, so that it can stay on top of everything
+class UiProfilerOverlay final : public Component, private Timer
+{
+public:
+
+    UiProfilerOverlay();
+    ~UiProfilerOverlay() override;
+
+    //===------------------------------------------------------------------===//
+    // Component
+    //===------------------------------------------------------------------===//
+
+    void paint(Graphics &g) override;
+    void parentHierarchyChanged() override;
+    void parentSizeChanged() override;
+
+private:
+
+    void timerCallback() override;
+    void updatePosition();
+
+    static constexpr int overlayWidth = 360;
+    static constexpr int overlayHeight = 280;
+    static constexpr int rowHeight = 16;
+    static constexpr int maxShownSections = 8;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UiProfilerOverlay)
+};
@@ -164,6 +164,14 @@ UniquePointer<ModalDialogConfirmation> ModalDialogConfirmation::Presets::resetCh
         TRANS(I18n::Dialog::cancel));
 }
 
+UniquePointer<ModalDialogConfirmation> ModalDialogConfirmation::Presets::compactHistory()
+{
+    return make<ModalDialogConfirmation>(
+        TRANS(I18n::Dialog::vcsCompactCaption),
+        TRANS(I18n::Dialog::vcsCompactProceed),
+        TRANS(I18n::Dialog::cancel));
+}
+
 UniquePointer<ModalDialogConfirmation> ModalDialogConfirmation::Presets::confirmOpenGL()
 {
     return make<ModalDialogConfirmation>(
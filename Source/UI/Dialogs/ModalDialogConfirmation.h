@@ -36,6 +36,7 @@ public:
         static UniquePointer<ModalDialogConfirmation> deleteProject();
         static UniquePointer<ModalDialogConfirmation> forceCheckout();
         static UniquePointer<ModalDialogConfirmation> resetChanges();
+        static UniquePointer<ModalDialogConfirmation> compactHistory();
         static UniquePointer<ModalDialogConfirmation> confirmOpenGL();
     };
 
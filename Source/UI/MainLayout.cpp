@@ -39,6 +39,8 @@
 #include "CommandIDs.h"
 #include "ColourSchemesManager.h"
 #include "CommandPaletteCommonActions.h"
+#include "UiProfiler.h"
+#include "UiProfilerOverlay.h"
 
 class InitScreen final : public Component, private Timer
 {
@@ -264,12 +266,36 @@ void MainLayout::showPage(Component *page, TreeNode *source)
     this->currentContent->setExplicitFocusOrder(1);
     this->currentContent->toFront(false);
 
+    if (this->profilerOverlay != nullptr)
+    {
+        this->profilerOverlay->toFront(false);
+    }
+
     // fill up console commands for visible command targets
     this->visibleCommandReceiversCache.clearQuick();
     findVisibleCommandReceivers(this->currentContent.getComponent(), this->visibleCommandReceiversCache);
     this->consoleCommonActions->setActiveCommandReceivers(this->visibleCommandReceiversCache);
 }
 
+//===----------------------------------------------------------------------===//
+// UI profiler
+//===----------------------------------------------------------------------===//
+
+void MainLayout::toggleUiProfiler()
+{
+    if (this->profilerOverlay != nullptr)
+    {
+        this->profilerOverlay = nullptr;
+        UiProfiler::setEnabled(false);
+    }
+    else
+    {
+        UiProfiler::setEnabled(true);
+        this->profilerOverlay = make<UiProfilerOverlay>();
+        this->addAndMakeVisible(this->profilerOverlay.get());
+    }
+}
+
 //===----------------------------------------------------------------------===//
 // Breadcrumbs
 //===----------------------------------------------------------------------===//
@@ -362,6 +388,12 @@ void MainLayout::resized()
     }
 }
 
+void MainLayout::paintOverChildren(Graphics &g)
+{
+    // every paint pass of the window ends up here
+    UiProfiler::onFramePainted(g);
+}
+
 void MainLayout::lookAndFeelChanged()
 {
     this->repaint();
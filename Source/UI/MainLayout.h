@@ -23,6 +23,7 @@ class HeadlineItemDataSource;
 class CommandPaletteCommonActions;
 class TooltipContainer;
 class InitScreen;
+class UiProfilerOverlay;
 
 #include "CommandPaletteModel.h"
 #include "ComponentFader.h"
@@ -70,12 +71,19 @@ public:
         TooltipType type = TooltipType::Simple,
         int timeoutMs = 15000);
 
+    //===------------------------------------------------------------------===//
+    // UI profiler overlay, a developer tool toggled from the command palette
+    //===------------------------------------------------------------------===//
+
+    void toggleUiProfiler();
+
     //===------------------------------------------------------------------===//
     // Component
     //===------------------------------------------------------------------===//
 
     void resized() override;
     void paint(Graphics &g) override {}
+    void paintOverChildren(Graphics &g) override;
     void lookAndFeelChanged() override;
     bool keyPressed(const KeyPress &key) override;
     bool keyStateChanged(bool isKeyDown) override;
@@ -96,6 +104,7 @@ private:
 
     UniquePointer<Headline> headline;
     UniquePointer<TooltipContainer> tooltipContainer;
+    UniquePointer<UiProfilerOverlay> profilerOverlay;
     
     SafePointer<Component> currentContent;
     WeakReference<TreeNode> currentProject;
@@ -49,6 +49,10 @@ VersionControlMenu::VersionControlMenu(VersionControl &vcs)
         CommandIDs::VersionControlSyncAll,
         TRANS(I18n::Menu::vcsSyncAll))->disabledIf(!loggedIn)->closesMenu());
 
+    menu.add(MenuItem::item(Icons::refactor,
+        CommandIDs::VersionControlCompactHistory,
+        TRANS(I18n::Menu::vcsCompactHistory))->closesMenu());
+
     // TODO when stashes are ready
     //menu.add(MenuItem::item(Icons::stash, CommandIDs::VersionControlPopStash,
     //    TRANS(I18n::Menu::vcsStash))->withSubmenu());
@@ -152,6 +152,9 @@ void StageComponent::handleCommandMessage (int commandId)
     case CommandIDs::VersionControlSyncAll:
         this->vcs.syncAllRevisions();
         break;
+    case CommandIDs::VersionControlCompactHistory:
+        this->compactHistory();
+        break;
     default:
         break;
     }
@@ -387,6 +390,23 @@ void StageComponent::resetSelected()
     App::showModalComponent(move(dialog));
 }
 
+void StageComponent::compactHistory()
+{
+    auto dialog = ModalDialogConfirmation::Presets::compactHistory();
+
+    dialog->onOk = [this]()
+    {
+        const auto report = this->vcs.compactHistory();
+
+        App::Layout().showTooltip(TRANS(I18n::VCS::compactDone) + " (" +
+            File::descriptionOfSizeInBytes(report.getBytesSaved()) + ", " +
+            String(roundToInt(report.elapsedMs)) + " ms)",
+            MainLayout::TooltipType::Success);
+    };
+
+    App::showModalComponent(move(dialog));
+}
+
 //[/MiscUserCode]
 
 #if 0
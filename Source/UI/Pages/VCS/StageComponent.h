@@ -97,6 +97,7 @@ private:
     void toggleQuickStash();
     void commitSelected();
     void resetSelected();
+    void compactHistory();
 
     //[/UserVariables]
 
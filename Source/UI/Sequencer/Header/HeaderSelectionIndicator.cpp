@@ -29,6 +29,11 @@ HeaderSelectionIndicator::HeaderSelectionIndicator() :
     this->setSize(128, 10);
 }
 
+HeaderSelectionIndicator::~HeaderSelectionIndicator()
+{
+    AnimationClock::removeListener(this);
+}
+
 void HeaderSelectionIndicator::paint(Graphics &g)
 {
     g.setColour(this->currentFill);
@@ -70,13 +75,13 @@ void HeaderSelectionIndicator::updateBounds()
     this->setBounds(startX, this->getY(), (endX - startX), this->getHeight());
 }
 
-void HeaderSelectionIndicator::timerCallback()
+void HeaderSelectionIndicator::onAnimationFrame(double timeMs)
 {
     const auto newFill = this->currentFill.interpolatedWith(this->targetFill, 0.4f);
 
     if (this->currentFill == newFill)
     {
-        this->stopTimer();
+        AnimationClock::removeListener(this);
 
         if (newFill.getAlpha() == 0)
         {
@@ -95,11 +100,11 @@ void HeaderSelectionIndicator::fadeIn()
 {
     this->targetFill = this->fill;
     this->setVisible(true);
-    this->startTimerHz(60);
+    AnimationClock::addListener(this);
 }
 
 void HeaderSelectionIndicator::fadeOut()
 {
     this->targetFill = Colours::transparentBlack;
-    this->startTimerHz(60);
+    AnimationClock::addListener(this);
 }
@@ -17,11 +17,14 @@
 
 #pragma once
 
-class HeaderSelectionIndicator final : public Component, private Timer
+#include "AnimationClock.h"
+
+class HeaderSelectionIndicator final : public Component, private AnimationClock::Listener
 {
 public:
 
     HeaderSelectionIndicator();
+    ~HeaderSelectionIndicator() override;
 
     void fadeIn();
     void fadeOut();
@@ -35,7 +38,7 @@ public:
 
 private:
 
-    void timerCallback() override;
+    void onAnimationFrame(double timeMs) override;
 
     double startAbsPosition = 0.0;
     double endAbsPosition = 0.0;
@@ -52,6 +52,7 @@ Playhead::Playhead(HybridRoll &parentRoll,
 
 Playhead::~Playhead()
 {
+    AnimationClock::removeListener(this);
     this->transport.removeTransportListener(this);
 }
 
@@ -63,20 +64,23 @@ void Playhead::onSeek(float beatPosition, double currentTimeMs, double totalTime
 {
     this->lastCorrectPosition = beatPosition;
 
-    this->triggerAsyncUpdate();
-
-    if (this->isTimerRunning())
+    if (this->isPlaying.get())
     {
+        // the next animation frame will pick it up
         this->timerStartTime = Time::getMillisecondCounterHiRes();
         this->timerStartPosition = this->lastCorrectPosition;
     }
+    else
+    {
+        this->triggerAsyncUpdate();
+    }
 }
 
 void Playhead::onTempoChanged(double msPerQuarter)
 {
     this->msPerQuarterNote = jmax(msPerQuarter, 0.01);
         
-    if (this->isTimerRunning())
+    if (this->isPlaying.get())
     {
         this->timerStartTime = Time::getMillisecondCounterHiRes();
         this->timerStartPosition = this->lastCorrectPosition;
@@ -87,7 +91,8 @@ void Playhead::onPlay()
 {
     this->timerStartTime = Time::getMillisecondCounterHiRes();
     this->timerStartPosition = this->lastCorrectPosition;
-    this->startTimerHz(60);
+    this->isPlaying = true;
+    AnimationClock::addListener(this);
 }
 
 void Playhead::onRecord()
@@ -101,7 +106,8 @@ void Playhead::onStop()
     this->currentColour = this->playbackColour;
     this->repaint();
 
-    this->stopTimer();
+    this->isPlaying = false;
+    AnimationClock::removeListener(this);
 
     this->timerStartTime = 0.0;
     this->timerStartPosition = 0.0;
@@ -109,12 +115,12 @@ void Playhead::onStop()
 }
 
 //===----------------------------------------------------------------------===//
-// Timer
+// AnimationClock::Listener
 //===----------------------------------------------------------------------===//
 
-void Playhead::timerCallback()
+void Playhead::onAnimationFrame(double timeMs)
 {
-    this->triggerAsyncUpdate();
+    this->tick(timeMs);
 }
 
 //===----------------------------------------------------------------------===//
@@ -123,9 +129,9 @@ void Playhead::timerCallback()
 
 void Playhead::handleAsyncUpdate()
 {
-    if (this->isTimerRunning())
+    if (this->isPlaying.get())
     {
-        this->tick();
+        this->tick(Time::getMillisecondCounterHiRes());
     }
     else
     {
@@ -162,9 +168,9 @@ void Playhead::parentChanged()
     {
         this->setSize(this->playheadWidth, this->getParentHeight());
         
-        if (this->isTimerRunning())
+        if (this->isPlaying.get())
         {
-            this->tick();
+            this->tick(Time::getMillisecondCounterHiRes());
         }
         else
         {
@@ -185,9 +191,10 @@ void Playhead::updatePosition(double position)
     }
 }
 
-void Playhead::tick()
+void Playhead::tick(double timeMs)
 {
-    const double timeOffsetMs = Time::getMillisecondCounterHiRes() - this->timerStartTime.get();
+    // the seek broadcast may arrive after the frame has started:
+    const double timeOffsetMs = jmax(0.0, timeMs - this->timerStartTime.get());
     const double positionOffset = timeOffsetMs / this->msPerQuarterNote.get();
     const double estimatedPosition = this->timerStartPosition.get() + positionOffset;
     this->updatePosition(estimatedPosition);
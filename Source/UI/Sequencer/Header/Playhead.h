@@ -21,12 +21,13 @@ class Transport;
 class HybridRoll;
 
 #include "TransportListener.h"
+#include "AnimationClock.h"
 
 class Playhead final :
     public Component,
     public TransportListener,
     private AsyncUpdater,
-    private Timer
+    private AnimationClock::Listener
 {
 public:
 
@@ -75,17 +76,20 @@ protected:
 private:
 
     //===------------------------------------------------------------------===//
-    // Timer
+    // AnimationClock::Listener
     //===------------------------------------------------------------------===//
 
-    void timerCallback() override;
-    void tick();
+    void onAnimationFrame(double timeMs) override;
+    void tick(double timeMs);
 
     void parentChanged();
 
+    // the position is extrapolated from the last seek broadcast
+    // by the player thread, which uses the same high resolution clock:
     Atomic<float> timerStartPosition = 0.f;
     Atomic<double> timerStartTime = 0.0;
     Atomic<double> msPerQuarterNote = Globals::Defaults::msPerBeat;
+    Atomic<bool> isPlaying = false;
 
 private:
 
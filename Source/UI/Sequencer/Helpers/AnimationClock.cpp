@@ -0,0 +1,59 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "AnimationClock.h"
+
+AnimationClock &AnimationClock::getInstance()
+{
+    // the timer is stopped when the last listener is removed,
+    // so the static instance is safe to be destroyed at exit
+    static AnimationClock clock;
+    return clock;
+}
+
+void AnimationClock::addListener(Listener *listener)
+{
+    jassert(MessageManager::getInstance()->currentThreadHasLockedMessageManager());
+
+    auto &clock = AnimationClock::getInstance();
+    clock.listeners.add(listener);
+
+    if (!clock.isTimerRunning())
+    {
+        clock.startTimerHz(AnimationClock::framesPerSecond);
+    }
+}
+
+void AnimationClock::removeListener(Listener *listener)
+{
+    jassert(MessageManager::getInstance()->currentThreadHasLockedMessageManager());
+
+    auto &clock = AnimationClock::getInstance();
+    clock.listeners.remove(listener);
+
+    if (clock.listeners.isEmpty())
+    {
+        clock.stopTimer();
+    }
+}
+
+void AnimationClock::timerCallback()
+{
+    const auto frameTime = Time::getMillisecondCounterHiRes();
+    this->listeners.call(&Listener::onAnimationFrame, frameTime);
+}
@@ -0,0 +1,58 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// A single timer for all animated sequencer elements, like playheads,
+// follow-scrolling and fading indicators: they all move in the same
+// message loop iteration with the same timestamp, so their repaints are
+// coalesced into a single paint pass per frame, and there are no extra
+// wakeups from several timers running out of phase with each other;
+// the clock only runs while there is anything to animate
+class AnimationClock final : private Timer
+{
+public:
+
+    class Listener
+    {
+    public:
+        Listener() = default;
+        virtual ~Listener() = default;
+
+        // the timestamp is in Time::getMillisecondCounterHiRes() units,
+        // same for all listeners within a frame
+        virtual void onAnimationFrame(double timeMs) = 0;
+    };
+
+    // both only to be called from the message thread, or under its lock
+    static void addListener(Listener *listener);
+    static void removeListener(Listener *listener);
+
+private:
+
+    AnimationClock() = default;
+
+    static AnimationClock &getInstance();
+
+    void timerCallback() override;
+
+    ListenerList<Listener> listeners;
+
+    static constexpr int framesPerSecond = 60;
+
+    JUCE_DECLARE_NON_COPYABLE(AnimationClock)
+};
@@ -0,0 +1,339 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "HybridRollCulling.h"
+
+HybridRollCulling::HybridRollCulling(Source &source) noexcept :
+    source(source) {}
+
+int HybridRollCulling::updateBounds(const Rectangle<int> &viewArea)
+{
+    return this->update(viewArea, true);
+}
+
+int HybridRollCulling::updatePosition(const Rectangle<int> &viewArea)
+{
+    if (this->area.contains(viewArea))
+    {
+        return 0;
+    }
+
+    return this->update(viewArea, false);
+}
+
+void HybridRollCulling::updateComponent(FloatBoundsComponent *component,
+    const Rectangle<float> &bounds)
+{
+    const bool shouldBeLaidOut = this->isWithinArea(bounds) ||
+        this->source.isEventComponentPinned(component);
+
+    if (shouldBeLaidOut && !component->isLaidOut())
+    {
+        component->setLaidOut(true);
+        this->laidOutComponents.add(component);
+    }
+    else if (!shouldBeLaidOut && component->isLaidOut())
+    {
+        component->setLaidOut(false);
+        this->laidOutComponents.removeFirstMatchingValue(component);
+    }
+
+    component->setVisible(shouldBeLaidOut);
+}
+
+void HybridRollCulling::reset()
+{
+    for (auto &component : this->laidOutComponents)
+    {
+        if (component != nullptr)
+        {
+            component->setLaidOut(false);
+        }
+    }
+
+    this->laidOutComponents.clearQuick();
+    this->area = {};
+}
+
+int HybridRollCulling::update(const Rectangle<int> &viewArea, bool boundsChanged)
+{
+    // the margin of a half screen in each direction
+    // makes most of the scrolling steps free:
+    this->area = viewArea.expanded(viewArea.getWidth() / 2, viewArea.getHeight() / 2);
+
+    int numTouched = 0;
+    int numKept = 0;
+
+    // first, move or hide the components which are currently laid out
+    for (int i = 0; i < this->laidOutComponents.size(); ++i)
+    {
+        auto *component = this->laidOutComponents.getUnchecked(i).getComponent();
+        if (component == nullptr)
+        {
+            continue; // has been deleted since the last update
+        }
+
+        jassert(component->isLaidOut());
+        const auto bounds = boundsChanged ?
+            this->source.getEventBounds(component) : component->getBounds().toFloat();
+
+        if (this->isWithinArea(bounds) || this->source.isEventComponentPinned(component))
+        {
+            if (boundsChanged)
+            {
+                component->setFloatBounds(bounds);
+                numTouched++;
+            }
+
+            this->laidOutComponents.set(numKept++, component);
+        }
+        else
+        {
+            component->setLaidOut(false);
+            component->setVisible(false);
+            numTouched++;
+        }
+    }
+
+    this->laidOutComponents.removeLast(this->laidOutComponents.size() - numKept);
+
+    // then, bring in the ones entering the area
+    this->lookupResult.clearQuick();
+    this->source.findEventComponentsInArea(this->area, this->lookupResult);
+
+    for (auto *component : this->lookupResult)
+    {
+        if (component->isLaidOut())
+        {
+            continue;
+        }
+
+        const auto bounds = this->source.getEventBounds(component);
+        if (this->isWithinArea(bounds))
+        {
+            component->setFloatBounds(bounds);
+            component->setLaidOut(true);
+            component->setVisible(true);
+            this->laidOutComponents.add(component);
+            numTouched++;
+        }
+    }
+
+    return numTouched;
+}
+
+bool HybridRollCulling::isWithinArea(const Rectangle<float> &bounds) const noexcept
+{
+    return bounds.getRight() >= float(this->area.getX()) &&
+        bounds.getX() <= float(this->area.getRight()) &&
+        bounds.getBottom() >= float(this->area.getY()) &&
+        bounds.getY() <= float(this->area.getBottom());
+}
+
+#if JUCE_UNIT_TESTS
+
+// A synthetic roll with lots of events sorted by beat,
+// laid out the same way the piano roll does it:
+struct CullingTestEvent final : public FloatBoundsComponent
+{
+    CullingTestEvent(float beat, float length, int key) :
+        beat(beat), length(length), key(key) {}
+
+    const float beat;
+    const float length;
+    const int key;
+    bool isPinned = false;
+};
+
+class CullingTestRoll final : public HybridRollCulling::Source
+{
+public:
+
+    explicit CullingTestRoll(int numEvents)
+    {
+        for (int i = 0; i < numEvents; ++i)
+        {
+            // a chord-ish pattern with overlapping notes of various lengths:
+            const float beat = float(i / 4) * 0.5f;
+            const float length = 0.25f + float(i % 8) * 0.25f;
+            const int key = 36 + (i * 7) % 60;
+            this->events.add(new CullingTestEvent(beat, length, key));
+            this->maxLength = jmax(this->maxLength, length);
+        }
+    }
+
+    Rectangle<float> getEventBounds(FloatBoundsComponent *component) const override
+    {
+        const auto *event = static_cast<CullingTestEvent *>(component);
+        return { event->beat * this->beatWidth,
+            float((CullingTestRoll::numKeys - event->key) * CullingTestRoll::rowHeight + 1),
+            event->length * this->beatWidth,
+            float(CullingTestRoll::rowHeight - 1) };
+    }
+
+    void findEventComponentsInArea(const Rectangle<int> &area,
+        Array<FloatBoundsComponent *> &result) const override
+    {
+        const float startBeat = float(area.getX()) / this->beatWidth - this->maxLength;
+        const float endBeat = float(area.getRight()) / this->beatWidth;
+
+        auto *it = std::lower_bound(this->events.begin(), this->events.end(), startBeat,
+            [](const CullingTestEvent *event, float beat) { return event->beat < beat; });
+
+        for (; it != this->events.end() && (*it)->beat <= endBeat; ++it)
+        {
+            result.add(*it);
+        }
+    }
+
+    bool isEventComponentPinned(FloatBoundsComponent *component) const override
+    {
+        return static_cast<CullingTestEvent *>(component)->isPinned;
+    }
+
+    float beatWidth = 16.f;
+    float maxLength = 0.f;
+
+    static constexpr auto numKeys = 128;
+    static constexpr auto rowHeight = 12;
+
+    OwnedArray<CullingTestEvent> events;
+};
+
+class HybridRollCullingTests final : public UnitTest
+{
+public:
+    HybridRollCullingTests() : UnitTest("Hybrid roll viewport culling tests", UnitTestCategories::helio) {}
+
+    void runTest() override
+    {
+        CullingTestRoll roll(100000);
+        HybridRollCulling culling(roll);
+
+        Rectangle<int> view(0, 400, 1600, 900);
+
+        beginTest("Initial layout");
+
+        culling.updateBounds(view);
+        this->expectValidLayout(roll, culling);
+        expect(culling.getNumLaidOutComponents() < roll.events.size() / 10);
+
+        beginTest("Scrolling within the margin");
+
+        expectEquals(culling.updatePosition(view.translated(100, 50)), 0);
+        view = view.translated(10000, 0);
+        expect(culling.updatePosition(view) > 0);
+        this->expectValidLayout(roll, culling);
+
+        beginTest("Pinned components");
+
+        auto *pinned = roll.events[roll.events.size() / 2];
+        pinned->isPinned = true;
+        culling.updateComponent(pinned, roll.getEventBounds(pinned));
+        expect(pinned->isVisible());
+        culling.updateBounds(view.translated(-5000, 0));
+        expect(pinned->isVisible());
+        expect(pinned->getX() == int(floorf(roll.getEventBounds(pinned).getX())));
+        pinned->isPinned = false;
+        culling.updateBounds(view);
+        expect(!pinned->isVisible());
+        this->expectValidLayout(roll, culling);
+
+        beginTest("Zoom and scroll benchmark, 100k events");
+
+        constexpr auto numZoomSteps = 50;
+        constexpr auto numScrollSteps = 500;
+
+        double zoomTime = 0.0;
+        int maxTouchedPerZoomStep = 0;
+        for (int i = 0; i < numZoomSteps; ++i)
+        {
+            roll.beatWidth = 8.f + float(i % 16) * 4.f;
+            const auto start = Time::getMillisecondCounterHiRes();
+            maxTouchedPerZoomStep = jmax(maxTouchedPerZoomStep, culling.updateBounds(view));
+            zoomTime += Time::getMillisecondCounterHiRes() - start;
+        }
+
+        this->expectValidLayout(roll, culling);
+
+        double scrollTime = 0.0;
+        for (int i = 0; i < numScrollSteps; ++i)
+        {
+            view = view.translated(40, (i % 20 < 10) ? 12 : -12);
+            const auto start = Time::getMillisecondCounterHiRes();
+            culling.updatePosition(view);
+            scrollTime += Time::getMillisecondCounterHiRes() - start;
+        }
+
+        this->expectValidLayout(roll, culling);
+
+        // the way it was done before, for comparison:
+        double fullRelayoutTime = 0.0;
+        for (int i = 0; i < numZoomSteps; ++i)
+        {
+            roll.beatWidth = 8.f + float(i % 16) * 4.f;
+            const auto start = Time::getMillisecondCounterHiRes();
+            for (auto *event : roll.events)
+            {
+                event->setFloatBounds(roll.getEventBounds(event));
+            }
+            fullRelayoutTime += Time::getMillisecondCounterHiRes() - start;
+        }
+
+        expect(maxTouchedPerZoomStep < roll.events.size() / 10);
+
+        logMessage("Zoom step: " + String(zoomTime / numZoomSteps, 3) +
+            " ms culled, " + String(fullRelayoutTime / numZoomSteps, 3) +
+            " ms full relayout; scroll step: " + String(scrollTime / numScrollSteps, 3) +
+            " ms; max components touched per zoom step: " + String(maxTouchedPerZoomStep));
+    }
+
+private:
+
+    void expectValidLayout(const CullingTestRoll &roll, const HybridRollCulling &culling)
+    {
+        const auto area = culling.getArea().toFloat();
+
+        int numErrors = 0;
+        for (auto *event : roll.events)
+        {
+            const auto bounds = roll.getEventBounds(event);
+            const bool isWithinArea = bounds.getRight() >= area.getX() &&
+                bounds.getX() <= area.getRight() &&
+                bounds.getBottom() >= area.getY() &&
+                bounds.getY() <= area.getBottom();
+
+            if (isWithinArea)
+            {
+                numErrors += !event->isVisible() ||
+                    event->getX() != int(floorf(bounds.getX())) ||
+                    event->getY() != int(floorf(bounds.getY()));
+            }
+            else
+            {
+                numErrors += event->isVisible() != event->isPinned;
+            }
+        }
+
+        expectEquals(numErrors, 0);
+    }
+};
+
+static HybridRollCullingTests hybridRollCullingTests;
+
+#endif
@@ -0,0 +1,81 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "FloatBoundsComponent.h"
+
+// Viewport culling for the rolls' event components:
+// only the components within the visible area, extended by a margin,
+// are kept positioned and visible, the rest are hidden and not re-laid out,
+// so that zooming and scrolling only touch the components around the viewport,
+// and the cost doesn't depend on the total number of events in the project.
+class HybridRollCulling final
+{
+public:
+
+    class Source
+    {
+    public:
+
+        virtual ~Source() = default;
+
+        virtual Rectangle<float> getEventBounds(FloatBoundsComponent *component) const = 0;
+
+        // Should find the components which might intersect the given area
+        // (the result may contain some extra ones) without iterating them all:
+        virtual void findEventComponentsInArea(const Rectangle<int> &area,
+            Array<FloatBoundsComponent *> &result) const = 0;
+
+        // Pinned components are always kept laid out, e.g. the selected ones,
+        // as the selection bounds and dragging helpers depend on them:
+        virtual bool isEventComponentPinned(FloatBoundsComponent *component) const = 0;
+    };
+
+    explicit HybridRollCulling(Source &source) noexcept;
+
+    // Re-positions all laid out components, e.g. when the zoom level changes;
+    // returns the number of components that have been moved, shown or hidden:
+    int updateBounds(const Rectangle<int> &viewArea);
+
+    // Shows and hides the components entering and leaving the culling area,
+    // does nothing while the view area stays within that area:
+    int updatePosition(const Rectangle<int> &viewArea);
+
+    // For the components added or changed after the last update:
+    void updateComponent(FloatBoundsComponent *component, const Rectangle<float> &bounds);
+
+    // Forgets all laid out components, e.g. when they are all re-created:
+    void reset();
+
+    inline const Rectangle<int> &getArea() const noexcept { return this->area; }
+    inline int getNumLaidOutComponents() const noexcept { return this->laidOutComponents.size(); }
+
+private:
+
+    int update(const Rectangle<int> &viewArea, bool boundsChanged);
+    bool isWithinArea(const Rectangle<float> &bounds) const noexcept;
+
+    Source &source;
+
+    Rectangle<int> area;
+
+    Array<Component::SafePointer<FloatBoundsComponent>> laidOutComponents;
+    Array<FloatBoundsComponent *> lookupResult;
+
+    JUCE_DECLARE_NON_COPYABLE(HybridRollCulling)
+};
@@ -0,0 +1,104 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "ProjectMapImageCache.h"
+
+ProjectMapImageCache::ProjectMapImageCache(Source &source) noexcept :
+    source(source) {}
+
+void ProjectMapImageCache::invalidateAll() noexcept
+{
+    this->isFullyInvalid = true;
+}
+
+void ProjectMapImageCache::invalidateBeatRange(float startBeat, float endBeat) noexcept
+{
+    const Range<float> range(jmin(startBeat, endBeat), jmax(startBeat, endBeat));
+    this->dirtyRange = this->hasDirtyRange ? this->dirtyRange.getUnionWith(range) : range;
+    this->hasDirtyRange = true;
+}
+
+void ProjectMapImageCache::paint(Graphics &g, const Rectangle<int> &bounds,
+    float firstBeat, float lastBeat)
+{
+    const float numBeats = lastBeat - firstBeat;
+    if (bounds.isEmpty() || numBeats <= 0.f)
+    {
+        return;
+    }
+
+    // the level of detail is the nearest power of two
+    // not less than the actual beat width, limited by the max image width:
+    float beatWidth = powf(2.f, ceilf(log2f(float(bounds.getWidth()) / numBeats)));
+    while (beatWidth > 1.f / 1024.f && numBeats * beatWidth > float(ProjectMapImageCache::maxImageWidth))
+    {
+        beatWidth /= 2.f;
+    }
+
+    const int imageWidth = jmax(1, int(ceilf(numBeats * beatWidth)));
+
+    if (this->isFullyInvalid ||
+        this->image.getWidth() != imageWidth ||
+        this->image.getHeight() != bounds.getHeight() ||
+        this->imageFirstBeat != firstBeat ||
+        this->imageLastBeat != lastBeat ||
+        this->imageBeatWidth != beatWidth)
+    {
+        this->image = Image(Image::ARGB, imageWidth, bounds.getHeight(), true);
+        this->imageFirstBeat = firstBeat;
+        this->imageLastBeat = lastBeat;
+        this->imageBeatWidth = beatWidth;
+        this->isFullyInvalid = false;
+        this->hasDirtyRange = false;
+        this->render(firstBeat, lastBeat);
+    }
+    else if (this->hasDirtyRange)
+    {
+        this->hasDirtyRange = false;
+        this->render(this->dirtyRange.getStart(), this->dirtyRange.getEnd());
+    }
+
+    g.drawImage(this->image,
+        bounds.getX(), bounds.getY(), bounds.getWidth(), bounds.getHeight(),
+        0, 0, this->image.getWidth(), this->image.getHeight());
+}
+
+void ProjectMapImageCache::render(float startBeat, float endBeat)
+{
+    // whole pixels, plus one to the right for antialiased edges:
+    const int startX = jmax(0,
+        int(floorf((startBeat - this->imageFirstBeat) * this->imageBeatWidth)));
+    const int endX = jmin(this->image.getWidth(),
+        int(ceilf((endBeat - this->imageFirstBeat) * this->imageBeatWidth)) + 1);
+
+    if (startX >= endX)
+    {
+        return;
+    }
+
+    const Rectangle<int> area(startX, 0, endX - startX, this->image.getHeight());
+    this->image.clear(area);
+
+    Graphics g(this->image);
+    g.reduceClipRegion(area);
+
+    this->source.paintProjectMapRange(g,
+        this->imageFirstBeat + float(startX) / this->imageBeatWidth,
+        this->imageFirstBeat + float(endX) / this->imageBeatWidth,
+        this->imageFirstBeat, this->imageBeatWidth, this->image.getHeight());
+}
@@ -0,0 +1,70 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// A pre-rendered image of the project map's events, blitted scaled on paint:
+// the image is rendered at a level of detail which only changes when
+// the map width changes by a factor of two, so that resizing and scrolling
+// don't re-render anything, and the model changes only invalidate
+// the beat ranges they affect, which are then re-rendered on the next paint.
+class ProjectMapImageCache final
+{
+public:
+
+    class Source
+    {
+    public:
+
+        virtual ~Source() = default;
+
+        // Should paint all events intersecting the given beat range,
+        // where x = (beat - firstBeat) * beatWidth, and the image height is given:
+        virtual void paintProjectMapRange(Graphics &g, float startBeat, float endBeat,
+            float firstBeat, float beatWidth, int height) const = 0;
+    };
+
+    explicit ProjectMapImageCache(Source &source) noexcept;
+
+    void invalidateAll() noexcept;
+    void invalidateBeatRange(float startBeat, float endBeat) noexcept;
+
+    // Re-renders the invalidated parts, if any, and draws the image
+    // scaled to fit the given bounds, which display the given beat range:
+    void paint(Graphics &g, const Rectangle<int> &bounds, float firstBeat, float lastBeat);
+
+    inline const Image &getImage() const noexcept { return this->image; }
+
+private:
+
+    void render(float startBeat, float endBeat);
+
+    Source &source;
+
+    Image image;
+    float imageFirstBeat = 0.f;
+    float imageLastBeat = 0.f;
+    float imageBeatWidth = 0.f;
+
+    Range<float> dirtyRange;
+    bool hasDirtyRange = false;
+    bool isFullyInvalid = true;
+
+    static constexpr int maxImageWidth = 8192;
+
+    JUCE_DECLARE_NON_COPYABLE(ProjectMapImageCache)
+};
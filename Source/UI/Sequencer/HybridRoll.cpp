@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "HybridRoll.h"
+#include "UiProfiler.h"
 #include "HybridRollHeader.h"
 
 #include "HybridRollExpandMark.h"
@@ -84,6 +85,8 @@ HybridRoll::HybridRoll(ProjectNode &parentProject, Viewport &viewportRef,
     beatLineColour(findDefaultColour(ColourIDs::Roll::beatLine)),
     snapLineColour(findDefaultColour(ColourIDs::Roll::snapLine))
 {
+    this->culling = make<HybridRollCulling>(*this);
+
     this->setOpaque(true);
     this->setPaintingIsUnclipped(true);
 
@@ -168,6 +171,7 @@ HybridRoll::HybridRoll(ProjectNode &parentProject, Viewport &viewportRef,
 
 HybridRoll::~HybridRoll()
 {
+    AnimationClock::removeListener(this);
     App::Config().getUiFlags()->removeListener(this);
 
     if (this->clippingDetector != nullptr)
@@ -654,18 +658,27 @@ float HybridRoll::getMinVisibleBeatForCurrentZoomLevel() const
 
 void HybridRoll::computeVisibleBeatLines()
 {
-    this->visibleBars.clearQuick();
-    this->visibleBeats.clearQuick();
-    this->visibleSnaps.clearQuick();
-    this->allSnaps.clearQuick();
+    const int viewPosX = this->viewport.getViewPositionX();
+    this->computeBeatLines(float(viewPosX), float(viewPosX + this->viewport.getViewWidth()),
+        this->visibleBars, this->visibleBeats, this->visibleSnaps, this->allSnaps);
+}
+
+void HybridRoll::computeBeatLines(float startX, float endX,
+    Array<float> &outBars, Array<float> &outBeats,
+    Array<float> &outSnaps, Array<float> &outAllSnaps) const
+{
+    outBars.clearQuick();
+    outBeats.clearQuick();
+    outSnaps.clearQuick();
+    outAllSnaps.clearQuick();
 
     const auto *tsSequence =
         this->project.getTimeline()->getTimeSignatures()->getSequence();
     
     const float zeroCanvasOffset = this->firstBeat * this->beatWidth; // usually a negative value
-    const float viewPosX = float(this->viewport.getViewPositionX());
+    const float viewPosX = startX;
     const float paintStartX = viewPosX + zeroCanvasOffset;
-    const float paintEndX = float(viewPosX + this->viewport.getViewWidth()) + zeroCanvasOffset;
+    const float paintEndX = endX + zeroCanvasOffset;
     
     const float barWidth = float(this->beatWidth * Globals::beatsPerBar);
     const float firstBar = this->firstBeat / float(Globals::beatsPerBar);
@@ -741,8 +754,8 @@ void HybridRoll::computeVisibleBeatLines()
         {
             if (canDrawBarLine)
             {
-                this->visibleBars.add(barStartX);
-                this->allSnaps.add(barStartX);
+                outBars.add(barStartX);
+                outAllSnaps.add(barStartX);
             }
 
             // Check if we have more time signatures to come
@@ -779,8 +792,8 @@ void HybridRoll::computeVisibleBeatLines()
                 {
                     if (k >= viewPosX)
                     {
-                        this->visibleSnaps.add(k);
-                        this->allSnaps.add(k);
+                        outSnaps.add(k);
+                        outAllSnaps.add(k);
                     }
                 }
 
@@ -788,8 +801,8 @@ void HybridRoll::computeVisibleBeatLines()
                     j >= beatStep && // don't draw the first one as it is a bar line
                     (nextBeatStartX - beatStartX) > MIN_BEAT_WIDTH)
                 {
-                    this->visibleBeats.add(beatStartX);
-                    this->allSnaps.add(beatStartX);
+                    outBeats.add(beatStartX);
+                    outAllSnaps.add(beatStartX);
                 }
             }
         }
@@ -904,6 +917,7 @@ void HybridRoll::onChangeMidiEvent(const MidiEvent &event, const MidiEvent &newE
     // Time signatures have changed, need to repaint
     if (event.isTypeOf(MidiEvent::Type::TimeSignature))
     {
+        this->invalidateBackgroundTiles();
         this->updateChildrenBounds();
         this->repaint();
     }
@@ -913,6 +927,7 @@ void HybridRoll::onAddMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::TimeSignature))
     {
+        this->invalidateBackgroundTiles();
         this->updateChildrenBounds();
         this->repaint();
     }
@@ -922,6 +937,7 @@ void HybridRoll::onRemoveMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::TimeSignature))
     {
+        this->invalidateBackgroundTiles();
         this->updateChildrenBounds();
         this->repaint();
     }
@@ -974,6 +990,7 @@ void HybridRoll::onReloadProjectContent(const Array<MidiTrack *> &tracks,
     const ProjectMetadata *meta)
 {
     this->temperament = meta->getTemperament();
+    this->invalidateBackgroundTiles();
 }
 
 void HybridRoll::onBeforeReloadProjectContent()
@@ -1291,38 +1308,152 @@ void HybridRoll::resized()
     this->updateChildrenBounds();
 }
 
+void HybridRoll::moved()
+{
+    // the viewport has been scrolled
+    this->culling->updatePosition(this->viewport.getViewArea());
+}
+
 void HybridRoll::paint(Graphics &g)
 {
-    this->computeVisibleBeatLines();
+    UI_PROFILE_PAINT("HybridRoll::paint", g);
+
+    const int periodHeight = this->getBackgroundPeriodHeight();
+    if (this->backgroundTilesBeatWidth != this->beatWidth ||
+        this->backgroundTilesFirstBeat != this->firstBeat ||
+        this->backgroundTilesPeriodHeight != periodHeight)
+    {
+        this->invalidateBackgroundTiles();
+        this->backgroundTilesBeatWidth = this->beatWidth;
+        this->backgroundTilesFirstBeat = this->firstBeat;
+        this->backgroundTilesPeriodHeight = periodHeight;
+    }
 
-    const float y = float(this->viewport.getViewPositionY());
-    const float h = float(this->viewport.getViewHeight());
+    // the header and the snapping rely on the visible lines,
+    // which only need to be updated on horizontal scroll or zoom:
+    const Range<int> viewRangeX(this->viewport.getViewPositionX(),
+        this->viewport.getViewPositionX() + this->viewport.getViewWidth());
 
-    g.setColour(this->barLineColour);
-    for (const auto &f : this->visibleBars)
+    if (this->visibleBeatLinesDirty || this->visibleBeatLinesRange != viewRangeX)
     {
-        g.fillRect(floorf(f), y, 1.f, h);
+        this->computeVisibleBeatLines();
+        this->visibleBeatLinesRange = viewRangeX;
+        this->visibleBeatLinesDirty = false;
     }
 
-    g.setColour(this->barLineBevelColour);
-    for (const auto &f : this->visibleBars)
+    if (periodHeight <= 0)
     {
-        g.fillRect(floorf(f + 1.f), y, 1.f, h);
+        return;
     }
 
-    g.setColour(this->beatLineColour);
-    for (const auto &f : this->visibleBeats)
+    /*
+        Instead of filling the rows and drawing all the lines at each repaint,
+        only blit the cached tiles: each one is a pre-rendered fragment of the background,
+        one period high, which can be repeated vertically, so that the scrolling
+        mostly only needs to render a tile, when it gets into the view for the first time.
+
+        Also, like before, not relying on the tiled fills here, because with OpenGL
+        there is always some weird offset, messing up the sequencer rows.
+    */
+
+    const auto paintArea = g.getClipBounds().getIntersection(this->viewport.getViewArea());
+    const int paintOffsetY = Globals::UI::rollHeaderHeight;
+    const int paintStartY = paintOffsetY +
+        int(floorf(float(paintArea.getY() - paintOffsetY) / float(periodHeight))) * periodHeight;
+
+    const int firstTile = jmax(0, paintArea.getX() / HybridRoll::backgroundTileWidth);
+    const int lastTile = paintArea.getRight() / HybridRoll::backgroundTileWidth;
+
+    for (int tileIndex = firstTile; tileIndex <= lastTile; ++tileIndex)
     {
-        g.fillRect(floorf(f), y, 1.f, h);
+        const auto tile = this->getBackgroundTile(tileIndex);
+        const int tileX = tileIndex * HybridRoll::backgroundTileWidth;
+        for (int i = paintStartY; i < paintArea.getBottom(); i += periodHeight)
+        {
+            g.drawImageAt(tile, tileX, i);
+        }
     }
-    
-    g.setColour(this->snapLineColour);
-    for (const auto &f : this->visibleSnaps)
+
+    // forget the tiles which are far away from the view:
+    if (int(this->backgroundTiles.size()) > HybridRoll::maxCachedBackgroundTiles)
     {
-        g.fillRect(floorf(f), y, 1.f, h);
+        const int numVisibleTiles = this->viewport.getViewWidth() / HybridRoll::backgroundTileWidth + 1;
+        const int viewTile = this->viewport.getViewPositionX() / HybridRoll::backgroundTileWidth;
+        for (auto it = this->backgroundTiles.begin(); it != this->backgroundTiles.end();)
+        {
+            if (it->first < viewTile - numVisibleTiles ||
+                it->first > viewTile + numVisibleTiles * 2)
+            {
+                it = this->backgroundTiles.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
 }
 
+void HybridRoll::invalidateBackgroundTiles()
+{
+    this->backgroundTiles.clear();
+    this->visibleBeatLinesDirty = true;
+}
+
+Image HybridRoll::getBackgroundTile(int tileIndex)
+{
+    const auto found = this->backgroundTiles.find(tileIndex);
+    if (found != this->backgroundTiles.end())
+    {
+        return found->second;
+    }
+
+    const int periodHeight = this->getBackgroundPeriodHeight();
+    const int startX = tileIndex * HybridRoll::backgroundTileWidth;
+    const int endX = startX + HybridRoll::backgroundTileWidth;
+
+    Image tile(Image::RGB, HybridRoll::backgroundTileWidth, periodHeight, true);
+
+    {
+        Graphics g(tile);
+        g.setOrigin(-startX, 0);
+
+        this->paintBackgroundRows(g, startX, endX);
+
+        Array<float> bars, beats, snaps, allLines;
+        this->computeBeatLines(float(startX), float(endX), bars, beats, snaps, allLines);
+
+        const float h = float(periodHeight);
+
+        g.setColour(this->barLineColour);
+        for (const auto &f : bars)
+        {
+            g.fillRect(floorf(f), 0.f, 1.f, h);
+        }
+
+        g.setColour(this->barLineBevelColour);
+        for (const auto &f : bars)
+        {
+            g.fillRect(floorf(f + 1.f), 0.f, 1.f, h);
+        }
+
+        g.setColour(this->beatLineColour);
+        for (const auto &f : beats)
+        {
+            g.fillRect(floorf(f), 0.f, 1.f, h);
+        }
+
+        g.setColour(this->snapLineColour);
+        for (const auto &f : snaps)
+        {
+            g.fillRect(floorf(f), 0.f, 1.f, h);
+        }
+    }
+
+    this->backgroundTiles[tileIndex] = tile;
+    return tile;
+}
+
 //===----------------------------------------------------------------------===//
 // Playhead::Listener
 //===----------------------------------------------------------------------===//
@@ -1461,7 +1592,7 @@ void HybridRoll::stopFollowingPlayhead()
     }
 
 #if ROLL_VIEW_FOLLOWS_PLAYHEAD
-    this->stopTimer();
+    AnimationClock::removeListener(this);
     this->shouldFollowPlayhead = false;
 #endif
 }
@@ -1470,7 +1601,7 @@ void HybridRoll::scrollToSeekPosition()
 {
 #if ROLL_VIEW_FOLLOWS_PLAYHEAD
     this->startFollowingPlayhead();
-    this->startTimer(7);
+    AnimationClock::addListener(this);
 #else
     const int playheadX = this->getXPositionByBeat(this->lastTransportBeat.get());
     this->viewport.setViewPosition(playheadX -
@@ -1496,8 +1627,7 @@ void HybridRoll::handleAsyncUpdate()
             // There are still many cases when a scheduled component is deleted at this time:
             if (FloatBoundsComponent *component = this->batchRepaintList.getUnchecked(i))
             {
-                const Rectangle<float> nb(this->getEventBounds(component));
-                component->setFloatBounds(nb);
+                this->updateEventComponentLayout(component);
                 component->repaint();
             }
         }
@@ -1506,19 +1636,6 @@ void HybridRoll::handleAsyncUpdate()
 
         this->batchRepaintList.clearQuick();
     }
-
-#if ROLL_VIEW_FOLLOWS_PLAYHEAD
-    if (this->isTimerRunning())
-    {
-        const int playheadX = this->getPlayheadPositionByBeat(this->lastTransportBeat.get(), double(this->getWidth()));
-        const int newX = playheadX - int(this->playheadOffset.get() * 0.75) -
-            (this->viewport.getViewWidth() / 2);
-
-        this->viewport.setViewPosition(newX, this->viewport.getViewPositionY());
-        this->playheadOffset = this->findPlayheadOffsetFromViewCentre();
-        this->updateChildrenPositions();
-    }
-#endif
 }
 
 double HybridRoll::findPlayheadOffsetFromViewCentre() const
@@ -1534,18 +1651,44 @@ void HybridRoll::triggerBatchRepaintFor(FloatBoundsComponent *target)
     this->triggerAsyncUpdate();
 }
 
+void HybridRoll::updateEventComponentLayout(FloatBoundsComponent *target)
+{
+    const Rectangle<float> nb(this->getEventBounds(target));
+    target->setFloatBounds(nb);
+    this->culling->updateComponent(target, nb);
+}
+
+//===----------------------------------------------------------------------===//
+// HybridRollCulling::Source
+//===----------------------------------------------------------------------===//
+
+bool HybridRoll::isEventComponentPinned(FloatBoundsComponent *component) const
+{
+    const auto *selectable = dynamic_cast<SelectableComponent *>(component);
+    return selectable != nullptr && selectable->isSelected();
+}
+
 //===----------------------------------------------------------------------===//
-// Timer
+// AnimationClock::Listener
 //===----------------------------------------------------------------------===//
 
-void HybridRoll::hiResTimerCallback()
+void HybridRoll::onAnimationFrame(double timeMs)
 {
+#if ROLL_VIEW_FOLLOWS_PLAYHEAD
+    const int playheadX = this->getPlayheadPositionByBeat(this->lastTransportBeat.get(), double(this->getWidth()));
+    const int newX = playheadX - int(this->playheadOffset.get() * 0.75) -
+        (this->viewport.getViewWidth() / 2);
+
+    this->viewport.setViewPosition(newX, this->viewport.getViewPositionY());
+    this->playheadOffset = this->findPlayheadOffsetFromViewCentre();
+    this->updateChildrenPositions();
+
+    // approaching the seek position exponentially, until it's reached:
     if (fabs(this->playheadOffset.get()) < 0.1)
     {
-        this->stopTimer();
+        AnimationClock::removeListener(this);
     }
-
-    this->triggerAsyncUpdate();
+#endif
 }
 
 //===----------------------------------------------------------------------===//
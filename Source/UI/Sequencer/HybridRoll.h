@@ -47,6 +47,8 @@ class TimelineWarningMarker;
 #include "ProjectListener.h"
 #include "Lasso.h"
 #include "HybridRollEditMode.h"
+#include "HybridRollCulling.h"
+#include "AnimationClock.h"
 #include "UserInterfaceFlags.h"
 #include "AudioMonitor.h"
 #include "HeadlineContextMenuController.h"
@@ -76,8 +78,9 @@ class HybridRoll :
     protected ChangeListener, // listens to HybridRollEditMode,
     protected TransportListener, // for positioning the playhead component and auto-scrolling
     protected AsyncUpdater, // coalesce multiple transport events ^^ into a single async view change
-    protected HighResolutionTimer, // for smooth scrolling to seek position
-    protected AudioMonitor::ClippingListener // for displaying clipping indicator components
+    protected AnimationClock::Listener, // for smooth scrolling to seek position
+    protected AudioMonitor::ClippingListener, // for displaying clipping indicator components
+    protected HybridRollCulling::Source // for keeping only the visible event components laid out
 {
 public:
     
@@ -95,7 +98,7 @@ public:
     HybridRollEditMode &getEditMode() noexcept;
 
     virtual void selectAll() = 0;
-    virtual Rectangle<float> getEventBounds(FloatBoundsComponent *nc) const = 0;
+    Rectangle<float> getEventBounds(FloatBoundsComponent *nc) const override = 0;
     
     void scrollToSeekPosition();
     float getPositionForNewTimelineEvent() const;
@@ -213,6 +216,10 @@ public:
     
     void triggerBatchRepaintFor(FloatBoundsComponent *target);
 
+    // positions the component right away, and shows or hides it,
+    // e.g. when it's selected, and the culling helper is going to pin it
+    void updateEventComponentLayout(FloatBoundsComponent *target);
+
     void startFollowingPlayhead();
     void stopFollowingPlayhead();
     
@@ -255,6 +262,7 @@ public:
 
     void handleCommandMessage(int commandId) override;
     void resized() override;
+    void moved() override;
     void paint(Graphics &g) override;
 
 protected:
@@ -312,10 +320,10 @@ protected:
     friend class HybridRollHeader;
     
     //===------------------------------------------------------------------===//
-    // Timer
+    // AnimationClock::Listener
     //===------------------------------------------------------------------===//
 
-    void hiResTimerCallback() override;
+    void onAnimationFrame(double timeMs) override;
     
 protected:
     
@@ -410,6 +418,40 @@ protected:
     const Colour snapLineColour;
 
     void computeVisibleBeatLines();
+    void computeBeatLines(float startX, float endX,
+        Array<float> &outBars, Array<float> &outBeats,
+        Array<float> &outSnaps, Array<float> &outAllSnaps) const;
+
+    Range<int> visibleBeatLinesRange;
+    bool visibleBeatLinesDirty = true;
+
+protected:
+
+    //===------------------------------------------------------------------===//
+    // Background tiles
+    //===------------------------------------------------------------------===//
+
+    // The rows and the grid lines are rendered into the cached tiles,
+    // one background period high, and then just blitted at each repaint;
+    // subclasses only fill the rows for the given range within one period:
+    virtual int getBackgroundPeriodHeight() const noexcept = 0;
+    virtual void paintBackgroundRows(Graphics &g, int startX, int endX) const = 0;
+
+    // to be called whenever anything affecting the background changes,
+    // except for zoom level, beat range and period height, which are checked on paint:
+    void invalidateBackgroundTiles();
+
+    static constexpr int backgroundTileWidth = 256;
+    static constexpr int maxCachedBackgroundTiles = 32;
+
+private:
+
+    Image getBackgroundTile(int tileIndex);
+    FlatHashMap<int, Image> backgroundTiles;
+
+    float backgroundTilesBeatWidth = 0.f;
+    float backgroundTilesFirstBeat = 0.f;
+    int backgroundTilesPeriodHeight = 0;
 
 protected:
 
@@ -421,6 +463,18 @@ protected:
 
     Array<SafePointer<FloatBoundsComponent>> batchRepaintList;
 
+protected:
+
+    //===------------------------------------------------------------------===//
+    // HybridRollCulling::Source
+    //===------------------------------------------------------------------===//
+
+    // subclasses are supposed to lay out their event components through
+    // the culling helper, and to implement findEventComponentsInArea:
+    bool isEventComponentPinned(FloatBoundsComponent *component) const override;
+
+    UniquePointer<HybridRollCulling> culling;
+
 protected:
     
     void changeListenerCallback(ChangeBroadcaster *source) override;
@@ -101,6 +101,14 @@ void MidiEventComponent::setSelected(bool selected)
         this->flags.isSelected = selected;
         this->flags.isRecordingTarget &= selected;
         this->updateColours();
+
+        // the selected components are always laid out, since the selection
+        // bounds and the dragging depend on them, even if they are culled now:
+        if (selected && !this->isLaidOut())
+        {
+            this->roll.updateEventComponentLayout(this);
+        }
+
         this->roll.triggerBatchRepaintFor(this);
     }
 }
@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "VelocityProjectMap.h"
+#include "UiProfiler.h"
 #include "PlayerThread.h"
 #include "ProjectNode.h"
 #include "MidiTrack.h"
@@ -307,6 +308,7 @@ private:
 //===----------------------------------------------------------------------===//
 
 VelocityProjectMap::VelocityProjectMap(ProjectNode &parentProject, HybridRoll &parentRoll) :
+    imageCache(*this),
     project(parentProject),
     roll(parentRoll)
 {
@@ -356,6 +358,14 @@ void VelocityProjectMap::resized()
     VELOCITY_MAP_BULK_REPAINT_END
 }
 
+void VelocityProjectMap::paint(Graphics &g)
+{
+    UI_PROFILE_PAINT("VelocityProjectMap::paint", g);
+
+    // the inactive clips are only re-rendered when changed, and otherwise just blitted:
+    this->imageCache.paint(g, this->getLocalBounds(), this->rollFirstBeat, this->rollLastBeat);
+}
+
 void VelocityProjectMap::mouseDown(const MouseEvent &e)
 {
     if (e.mods.isLeftButtonDown())
@@ -443,6 +453,10 @@ void VelocityProjectMap::onChangeMidiEvent(const MidiEvent &e1, const MidiEvent
                 this->triggerBatchRepaintFor(component);
             }
         }
+
+        this->invalidateNote(note);
+        this->invalidateNote(newNote);
+        this->repaint();
     }
 }
 
@@ -469,6 +483,9 @@ void VelocityProjectMap::onAddMidiEvent(const MidiEvent &event)
         }
 
         VELOCITY_MAP_BULK_REPAINT_END
+
+        this->invalidateNote(note);
+        this->repaint();
     }
 }
 
@@ -491,44 +508,20 @@ void VelocityProjectMap::onRemoveMidiEvent(const MidiEvent &event)
         }
 
         VELOCITY_MAP_BULK_REPAINT_END
+
+        this->invalidateNote(note);
+        this->repaint();
     }
 }
 
 void VelocityProjectMap::onAddClip(const Clip &clip)
 {
-    const SequenceMap *referenceMap = nullptr;
     const auto *track = clip.getPattern()->getTrack();
     if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
 
-    forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-    {
-        // Found a sequence map for the same track
-        referenceMap = c.second.get();
-        break;
-    }
-
-    if (referenceMap == nullptr)
-    {
-        jassertfalse;
-        return;
-    }
-
-    auto *sequenceMap = new SequenceMap();
-    this->patternMap[clip] = UniquePointer<SequenceMap>(sequenceMap);
-
-    VELOCITY_MAP_BULK_REPAINT_START
-
-    for (const auto &e : *referenceMap)
-    {
-        // reference the same note as neighbor components:
-        const auto &note = e.second.get()->note;
-        auto *noteComponent = new VelocityMapNoteComponent(note, clip);
-        (*sequenceMap)[note] = UniquePointer<VelocityMapNoteComponent>(noteComponent);
-        this->addAndMakeVisible(noteComponent);
-        this->applyNoteBounds(noteComponent);
-    }
-
-    VELOCITY_MAP_BULK_REPAINT_END
+    // new clips are never active, so they are only pre-rendered:
+    this->invalidateClip(clip);
+    this->repaint();
 }
 
 void VelocityProjectMap::onChangeClip(const Clip &clip, const Clip &newClip)
@@ -548,6 +541,14 @@ void VelocityProjectMap::onChangeClip(const Clip &clip, const Clip &newClip)
 
         this->triggerAsyncUpdate();
     }
+
+    const auto *track = clip.getPattern()->getTrack();
+    if (dynamic_cast<const PianoSequence *>(track->getSequence()))
+    {
+        this->invalidateClip(clip);
+        this->invalidateClip(newClip);
+        this->repaint();
+    }
 }
 
 void VelocityProjectMap::onRemoveClip(const Clip &clip)
@@ -560,6 +561,13 @@ void VelocityProjectMap::onRemoveClip(const Clip &clip)
     }
 
     VELOCITY_MAP_BULK_REPAINT_END
+
+    const auto *track = clip.getPattern()->getTrack();
+    if (dynamic_cast<const PianoSequence *>(track->getSequence()))
+    {
+        this->invalidateClip(clip);
+        this->repaint();
+    }
 }
 
 void VelocityProjectMap::onChangeTrackProperties(MidiTrack *const track)
@@ -579,6 +587,7 @@ void VelocityProjectMap::onChangeTrackProperties(MidiTrack *const track)
 
     VELOCITY_MAP_BULK_REPAINT_END
 
+    this->imageCache.invalidateAll(); // the colour might have changed
     this->repaint();
 }
 
@@ -586,6 +595,8 @@ void VelocityProjectMap::onReloadProjectContent(const Array<MidiTrack *> &tracks
     const ProjectMetadata *meta)
 {
     this->reloadTrackMap();
+    this->imageCache.invalidateAll();
+    this->repaint();
 }
 
 void VelocityProjectMap::onAddTrack(MidiTrack *const track)
@@ -595,6 +606,9 @@ void VelocityProjectMap::onAddTrack(MidiTrack *const track)
     VELOCITY_MAP_BULK_REPAINT_START
     this->loadTrack(track);
     VELOCITY_MAP_BULK_REPAINT_END
+
+    this->imageCache.invalidateAll();
+    this->repaint();
 }
 
 void VelocityProjectMap::onRemoveTrack(MidiTrack *const track)
@@ -609,6 +623,9 @@ void VelocityProjectMap::onRemoveTrack(MidiTrack *const track)
             this->patternMap.erase(clip);
         }
     }
+
+    this->imageCache.invalidateAll();
+    this->repaint();
 }
 
 void VelocityProjectMap::onChangeProjectBeatRange(float firstBeat, float lastBeat)
@@ -639,21 +656,18 @@ void VelocityProjectMap::onChangeViewEditableScope(MidiTrack *const, const Clip
         return;
     }
 
-    this->activeClip = clip;
-
-    VELOCITY_MAP_BULK_REPAINT_START
-
-    for (const auto &c : this->patternMap)
+    // the previous active clip is now pre-rendered, and the new one is not:
+    if (this->activeClip.isValid())
     {
-        const bool editable = this->activeClip == c.first;
-        const auto &componentsMap = *c.second.get();
-        for (const auto &e : componentsMap)
-        {
-            e.second->setEditable(editable);
-        }
+        this->invalidateClip(this->activeClip);
     }
 
-    VELOCITY_MAP_BULK_REPAINT_END
+    this->activeClip = clip;
+    this->invalidateClip(this->activeClip);
+
+    // only the active clip has the editable components:
+    this->reloadTrackMap();
+    this->repaint();
 }
 
 void VelocityProjectMap::changeListenerCallback(ChangeBroadcaster *source)
@@ -859,7 +873,10 @@ void VelocityProjectMap::loadTrack(const MidiTrack *const track)
     for (int i = 0; i < track->getPattern()->size(); ++i)
     {
         const Clip *clip = track->getPattern()->getUnchecked(i);
-        const bool editable = this->activeClip == *clip;
+        if (!(this->activeClip == *clip))
+        {
+            continue;
+        }
 
         auto *sequenceMap = new SequenceMap();
         this->patternMap[*clip] = UniquePointer<SequenceMap>(sequenceMap);
@@ -874,12 +891,86 @@ void VelocityProjectMap::loadTrack(const MidiTrack *const track)
                 (*sequenceMap)[*note] = UniquePointer<VelocityMapNoteComponent>(noteComponent);
                 this->addAndMakeVisible(noteComponent);
                 this->applyNoteBounds(noteComponent);
-                noteComponent->setEditable(editable);
             }
         }
     }
 }
 
+void VelocityProjectMap::paintProjectMapRange(Graphics &g, float startBeat, float endBeat,
+    float firstBeat, float beatWidth, int height) const
+{
+    UI_PROFILE_PAINT("VelocityProjectMap::paintProjectMapRange", g);
+
+    const Colour baseColour(findDefaultColour(ColourIDs::Roll::noteFill));
+
+    for (const auto *track : this->project.getTracks())
+    {
+        const auto *sequence = dynamic_cast<const PianoSequence *>(track->getSequence());
+        if (sequence == nullptr || sequence->size() == 0 || track->getPattern() == nullptr)
+        {
+            continue;
+        }
+
+        // same as the non-editable level components:
+        g.setColour(track->getTrackColour().interpolatedWith(baseColour, .55f).withAlpha(.1f));
+
+        for (const auto *clip : track->getPattern()->getClips())
+        {
+            if (this->activeClip == *clip ||
+                clip->getBeat() + sequence->getFirstBeat() > endBeat ||
+                clip->getBeat() + sequence->getLastBeat() < startBeat)
+            {
+                continue;
+            }
+
+            for (const auto *event : *sequence)
+            {
+                const auto *note = static_cast<const Note *>(event);
+                const float beat = note->getBeat() + clip->getBeat();
+                if (beat > endBeat)
+                {
+                    break; // the sequence is sorted by beat
+                }
+
+                if (beat + note->getLength() < startBeat)
+                {
+                    continue;
+                }
+
+                const float x = (beat - firstBeat) * beatWidth;
+                const float w = jmax(1.f, note->getLength() * beatWidth);
+
+                // at least 4 pixels are visible for 0 volume events:
+                const int h = jmax(4, int(height * note->getVelocity() * clip->getVelocity()));
+                g.fillRect(x, float(height - h), w, float(h));
+                g.fillRect(x, float(height - h), w, 2.f);
+            }
+        }
+    }
+}
+
+void VelocityProjectMap::invalidateNote(const Note &note)
+{
+    const auto *pattern = note.getSequence()->getTrack()->getPattern();
+    if (pattern == nullptr)
+    {
+        return;
+    }
+
+    for (const auto *clip : pattern->getClips())
+    {
+        const float beat = note.getBeat() + clip->getBeat();
+        this->imageCache.invalidateBeatRange(beat, beat + note.getLength());
+    }
+}
+
+void VelocityProjectMap::invalidateClip(const Clip &clip)
+{
+    const auto *sequence = clip.getPattern()->getTrack()->getSequence();
+    this->imageCache.invalidateBeatRange(clip.getBeat() + sequence->getFirstBeat(),
+        clip.getBeat() + sequence->getLastBeat());
+}
+
 void VelocityProjectMap::applyNoteBounds(VelocityMapNoteComponent *nc)
 {
     const float rollLengthInBeats = (this->rollLastBeat - this->rollFirstBeat);
@@ -21,6 +21,7 @@
 #include "Note.h"
 #include "ProjectListener.h"
 #include "ComponentFader.h"
+#include "ProjectMapImageCache.h"
 
 #define VELOCITY_MAP_HEIGHT (128.f)
 
@@ -34,7 +35,8 @@ class VelocityProjectMap final :
     public Component,
     public ProjectListener,
     public AsyncUpdater, // triggers batch repaints for children
-    public ChangeListener // subscribes on parent roll's lasso changes
+    public ChangeListener, // subscribes on parent roll's lasso changes
+    private ProjectMapImageCache::Source // paints the inactive clips' levels
 {
 public:
 
@@ -46,6 +48,7 @@ public:
     //===------------------------------------------------------------------===//
 
     void resized() override;
+    void paint(Graphics &g) override;
     void mouseDown(const MouseEvent &e) override;
     void mouseDrag(const MouseEvent &e) override;
     void mouseUp(const MouseEvent &e) override;
@@ -81,6 +84,16 @@ private:
     void reloadTrackMap();
     void loadTrack(const MidiTrack *const track);
 
+    // only the active clip's levels are editable components,
+    // all other clips are pre-rendered into the image:
+    void paintProjectMapRange(Graphics &g, float startBeat, float endBeat,
+        float firstBeat, float beatWidth, int height) const override;
+
+    void invalidateNote(const Note &note);
+    void invalidateClip(const Clip &clip);
+
+    ProjectMapImageCache imageCache;
+
     float projectFirstBeat = 0.f;
     float projectLastBeat = Globals::Defaults::projectLength;
 
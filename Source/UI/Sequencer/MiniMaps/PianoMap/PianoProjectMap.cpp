@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "PianoProjectMap.h"
+#include "UiProfiler.h"
 #include "ProjectNode.h"
 #include "MidiTrack.h"
 #include "Pattern.h"
@@ -28,14 +29,15 @@
 #include "ColourIDs.h"
 
 PianoProjectMap::PianoProjectMap(ProjectNode &parentProject, HybridRoll &parentRoll) :
-    project(parentProject),
-    roll(parentRoll)
+    imageCache(*this),
+    roll(parentRoll),
+    project(parentProject)
 {
     this->baseColour = findDefaultColour(ColourIDs::Roll::noteFill);
+    this->keyboardSize = this->project.getProjectInfo()->getKeyboardSize();
 
     this->setInterceptsMouseClicks(false, false);
     this->setPaintingIsUnclipped(true);
-    this->reloadTrackMap();
 
     this->project.addListener(this);
 }
@@ -49,71 +51,24 @@ PianoProjectMap::~PianoProjectMap()
 // Component
 //===----------------------------------------------------------------------===//
 
-void PianoProjectMap::resized()
-{
-    this->componentHeight =
-        static_cast<float>(this->getHeight()) /
-        static_cast<float>(this->keyboardSize);
-}
-
 void PianoProjectMap::paint(Graphics &g)
 {
-    const float rollLengthInBeats = this->rollLastBeat - this->rollFirstBeat;
-    const float projectLengthInBeats = this->projectLastBeat - this->projectFirstBeat;
-    const float mapWidth = float(this->getWidth()) * (projectLengthInBeats / rollLengthInBeats);
-
-    for (const auto &c : this->patternMap)
-    {
-        const auto sequenceMap = c.second.get();
-        const bool isActiveClip = this->activeClip == c.first;
-
-        g.setColour(c.first.getTrackColour().
-            interpolatedWith(this->baseColour, .4f).
-            withAlpha(isActiveClip ? .9f : .6f));
+    UI_PROFILE_PAINT("PianoProjectMap::paint", g);
 
-        for (const auto &n : *sequenceMap)
-        {
-            const auto key = jlimit(0, this->keyboardSize, n.getKey() + c.first.getKey());
-            const auto beat = n.getBeat() + c.first.getBeat() - this->rollFirstBeat;
-            const auto length = n.getLength();
-
-            const float x = (mapWidth * (beat / projectLengthInBeats));
-            const float w = (mapWidth * (length / projectLengthInBeats));
-
-            // with rounding, it just looks better:
-            const int y = this->getHeight() - static_cast<int>(key * this->componentHeight);
-
-            g.fillRect(x, static_cast<float>(y), jmax(0.25f, w), 1.0f);
-        }
-    }
+    // the notes are only re-rendered when changed, and otherwise just blitted:
+    this->imageCache.paint(g, this->getLocalBounds(), this->rollFirstBeat, this->rollLastBeat);
 }
 
 //===----------------------------------------------------------------------===//
 // ProjectListener
 //===----------------------------------------------------------------------===//
 
-#define forEachSequenceMapOfGivenTrack(map, child, track) \
-    for (const auto &child : map) \
-        if (child.first.getPattern()->getTrack() == track)
-
 void PianoProjectMap::onChangeMidiEvent(const MidiEvent &e1, const MidiEvent &e2)
 {
     if (e1.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(e1);
-        const Note &newNote = static_cast<const Note &>(e2);
-        const auto *track = newNote.getSequence()->getTrack();
-
-        forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-        {
-            auto &sequenceMap = *c.second.get();
-            if (sequenceMap.contains(note))
-            {
-                sequenceMap.erase(note);
-                sequenceMap.insert(newNote);
-            }
-        }
-
+        this->invalidateNote(static_cast<const Note &>(e1));
+        this->invalidateNote(static_cast<const Note &>(e2));
         this->triggerAsyncUpdate();
     }
 }
@@ -122,15 +77,7 @@ void PianoProjectMap::onAddMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(event);
-        const auto *track = note.getSequence()->getTrack();
-
-        forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-        {
-            auto &sequenceMap = *c.second.get();
-            sequenceMap.insert(note);
-        }
-
+        this->invalidateNote(static_cast<const Note &>(event));
         this->triggerAsyncUpdate();
     }
 }
@@ -139,71 +86,42 @@ void PianoProjectMap::onRemoveMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(event);
-        const auto *track = note.getSequence()->getTrack();
-
-        forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-        {
-            auto &sequenceMap = *c.second.get();
-            if (sequenceMap.contains(note))
-            {
-                sequenceMap.erase(note);
-            }
-        }
-
+        this->invalidateNote(static_cast<const Note &>(event));
         this->triggerAsyncUpdate();
     }
 }
 
 void PianoProjectMap::onAddClip(const Clip &clip)
 {
-    const SequenceSet *referenceMap = nullptr;
     const auto *track = clip.getPattern()->getTrack();
     if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
 
-    forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-    {
-        // Found a sequence map for the same track
-        referenceMap = c.second.get();
-        break;
-    }
-
-    if (referenceMap == nullptr)
-    {
-        jassertfalse;
-        return;
-    }
-
-    auto *sequenceMap = new SequenceSet();
-    this->patternMap[clip] = UniquePointer<SequenceSet>(sequenceMap);
-        
-    for (const auto &note : *referenceMap)
-    {
-        sequenceMap->insert(note);
-    }
-
+    this->invalidateClip(clip);
     this->triggerAsyncUpdate();
 }
 
 void PianoProjectMap::onChangeClip(const Clip &clip, const Clip &newClip)
 {
-    if (this->patternMap.contains(clip))
+    const auto *track = clip.getPattern()->getTrack();
+    if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
+
+    if (this->activeClip == clip)
     {
-        // Set new key for existing sequence map
-        auto *sequenceMap = this->patternMap[clip].release();
-        this->patternMap.erase(clip);
-        this->patternMap[newClip] = UniquePointer<SequenceSet>(sequenceMap);
-        this->triggerAsyncUpdate();
+        this->activeClip = newClip;
     }
+
+    this->invalidateClip(clip);
+    this->invalidateClip(newClip);
+    this->triggerAsyncUpdate();
 }
 
 void PianoProjectMap::onRemoveClip(const Clip &clip)
 {
-    if (this->patternMap.contains(clip))
-    {
-        this->patternMap.erase(clip);
-        this->triggerAsyncUpdate();
-    }
+    const auto *track = clip.getPattern()->getTrack();
+    if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
+
+    this->invalidateClip(clip);
+    this->triggerAsyncUpdate();
 }
 
 void PianoProjectMap::onChangeProjectInfo(const ProjectMetadata *info)
@@ -211,7 +129,7 @@ void PianoProjectMap::onChangeProjectInfo(const ProjectMetadata *info)
     if (this->keyboardSize != info->getKeyboardSize())
     {
         this->keyboardSize = info->getKeyboardSize();
-        this->resized(); // updates componenetHeight
+        this->imageCache.invalidateAll();
         this->triggerAsyncUpdate(); // repaints
     }
 }
@@ -219,6 +137,7 @@ void PianoProjectMap::onChangeProjectInfo(const ProjectMetadata *info)
 void PianoProjectMap::onChangeTrackProperties(MidiTrack *const track)
 {
     if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
+    this->imageCache.invalidateAll(); // the colour might have changed
     this->triggerAsyncUpdate();
 }
 
@@ -226,29 +145,21 @@ void PianoProjectMap::onReloadProjectContent(const Array<MidiTrack *> &tracks,
     const ProjectMetadata *meta)
 {
     this->keyboardSize = meta->getKeyboardSize();
-    this->reloadTrackMap();
+    this->imageCache.invalidateAll();
+    this->triggerAsyncUpdate();
 }
 
 void PianoProjectMap::onAddTrack(MidiTrack *const track)
 {
     if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
-    this->loadTrack(track);
+    this->imageCache.invalidateAll();
     this->triggerAsyncUpdate();
 }
 
 void PianoProjectMap::onRemoveTrack(MidiTrack *const track)
 {
     if (!dynamic_cast<const PianoSequence *>(track->getSequence())) { return; }
-
-    for (int i = 0; i < track->getPattern()->size(); ++i)
-    {
-        const auto &clip = *track->getPattern()->getUnchecked(i);
-        if (this->patternMap.contains(clip))
-        {
-            this->patternMap.erase(clip);
-        }
-    }
-
+    this->imageCache.invalidateAll();
     this->triggerAsyncUpdate();
 }
 
@@ -261,7 +172,7 @@ void PianoProjectMap::onChangeProjectBeatRange(float firstBeat, float lastBeat)
     {
         this->rollFirstBeat = jmin(firstBeat, this->rollFirstBeat);
         this->rollLastBeat = jmax(lastBeat, this->rollLastBeat);
-        this->resized();
+        this->triggerAsyncUpdate();
     }
 }
 
@@ -271,7 +182,7 @@ void PianoProjectMap::onChangeViewBeatRange(float firstBeat, float lastBeat)
     {
         this->rollFirstBeat = firstBeat;
         this->rollLastBeat = lastBeat;
-        this->resized();
+        this->triggerAsyncUpdate();
     }
 }
 
@@ -282,56 +193,103 @@ void PianoProjectMap::onChangeViewEditableScope(MidiTrack *const, const Clip &cl
         return;
     }
 
+    // the active clip is highlighted:
+    if (this->activeClip.isValid())
+    {
+        this->invalidateClip(this->activeClip);
+    }
+
     this->activeClip = clip;
+    this->invalidateClip(this->activeClip);
     this->triggerAsyncUpdate();
 }
 
 //===----------------------------------------------------------------------===//
-// Private
+// ProjectMapImageCache::Source
 //===----------------------------------------------------------------------===//
 
-void PianoProjectMap::reloadTrackMap()
+void PianoProjectMap::paintProjectMapRange(Graphics &g, float startBeat, float endBeat,
+    float firstBeat, float beatWidth, int height) const
 {
-    this->patternMap.clear();
+    UI_PROFILE_PAINT("PianoProjectMap::paintProjectMapRange", g);
+
+    const float rowHeight = float(height) / float(this->keyboardSize);
 
-    const auto &tracks = this->project.getTracks();
-    for (const auto *track : tracks)
+    for (const auto *track : this->project.getTracks())
     {
-        if (dynamic_cast<const PianoSequence *>(track->getSequence()))
+        const auto *sequence = dynamic_cast<const PianoSequence *>(track->getSequence());
+        if (sequence == nullptr || sequence->size() == 0 || track->getPattern() == nullptr)
         {
-            this->loadTrack(track);
+            continue;
         }
-    }
 
-    this->triggerAsyncUpdate();
+        for (const auto *clip : track->getPattern()->getClips())
+        {
+            if (clip->getBeat() + sequence->getFirstBeat() > endBeat ||
+                clip->getBeat() + sequence->getLastBeat() < startBeat)
+            {
+                continue;
+            }
+
+            const bool isActiveClip = this->activeClip == *clip;
+
+            g.setColour(clip->getTrackColour().
+                interpolatedWith(this->baseColour, .4f).
+                withAlpha(isActiveClip ? .9f : .6f));
+
+            for (const auto *event : *sequence)
+            {
+                const auto *note = static_cast<const Note *>(event);
+                const float beat = note->getBeat() + clip->getBeat();
+                if (beat > endBeat)
+                {
+                    break; // the sequence is sorted by beat
+                }
+
+                if (beat + note->getLength() < startBeat)
+                {
+                    continue;
+                }
+
+                const auto key = jlimit(0, this->keyboardSize, note->getKey() + clip->getKey());
+                const float x = (beat - firstBeat) * beatWidth;
+                const float w = note->getLength() * beatWidth;
+
+                // with rounding, it just looks better:
+                const int y = height - static_cast<int>(key * rowHeight);
+
+                g.fillRect(x, static_cast<float>(y), jmax(0.25f, w), 1.0f);
+            }
+        }
+    }
 }
 
-void PianoProjectMap::loadTrack(const MidiTrack *const track)
+void PianoProjectMap::invalidateNote(const Note &note)
 {
-    if (track->getPattern() == nullptr)
+    const auto *pattern = note.getSequence()->getTrack()->getPattern();
+    if (pattern == nullptr)
     {
         return;
     }
 
-    for (int i = 0; i < track->getPattern()->size(); ++i)
+    for (const auto *clip : pattern->getClips())
     {
-        const Clip *clip = track->getPattern()->getUnchecked(i);
-
-        auto *sequenceMap = new SequenceSet();
-        this->patternMap[*clip] = UniquePointer<SequenceSet>(sequenceMap);
-
-        for (int j = 0; j < track->getSequence()->size(); ++j)
-        {
-            const MidiEvent *event = track->getSequence()->getUnchecked(j);
-            if (event->isTypeOf(MidiEvent::Type::Note))
-            {
-                const Note *note = static_cast<const Note *>(event);
-                sequenceMap->insert(*note);
-            }
-        }
+        const float beat = note.getBeat() + clip->getBeat();
+        this->imageCache.invalidateBeatRange(beat, beat + note.getLength());
     }
 }
 
+void PianoProjectMap::invalidateClip(const Clip &clip)
+{
+    const auto *sequence = clip.getPattern()->getTrack()->getSequence();
+    this->imageCache.invalidateBeatRange(clip.getBeat() + sequence->getFirstBeat(),
+        clip.getBeat() + sequence->getLastBeat());
+}
+
+//===----------------------------------------------------------------------===//
+// AsyncUpdater
+//===----------------------------------------------------------------------===//
+
 void PianoProjectMap::handleAsyncUpdate()
 {
     this->repaint();
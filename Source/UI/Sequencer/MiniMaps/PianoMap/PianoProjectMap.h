@@ -20,6 +20,7 @@
 #include "Clip.h"
 #include "Note.h"
 #include "ProjectListener.h"
+#include "ProjectMapImageCache.h"
 
 class HybridRoll;
 class ProjectNode;
@@ -28,7 +29,8 @@ class ProjectMapNoteComponent;
 class PianoProjectMap final :
     public Component,
     public ProjectListener,
-    public AsyncUpdater
+    public AsyncUpdater,
+    private ProjectMapImageCache::Source
 {
 public:
 
@@ -39,7 +41,6 @@ public:
     // Component
     //===------------------------------------------------------------------===//
 
-    void resized() override;
     void paint(Graphics &g) override;
 
     //===------------------------------------------------------------------===//
@@ -68,8 +69,17 @@ public:
 
 private:
 
-    void reloadTrackMap();
-    void loadTrack(const MidiTrack *const track);
+    //===------------------------------------------------------------------===//
+    // ProjectMapImageCache::Source
+    //===------------------------------------------------------------------===//
+
+    void paintProjectMapRange(Graphics &g, float startBeat, float endBeat,
+        float firstBeat, float beatWidth, int height) const override;
+
+    void invalidateNote(const Note &note);
+    void invalidateClip(const Clip &clip);
+
+    ProjectMapImageCache imageCache;
 
     float projectFirstBeat = 0.f;
     float projectLastBeat = Globals::Defaults::projectLength;
@@ -77,8 +87,6 @@ private:
     float rollFirstBeat = 0.f;
     float rollLastBeat = Globals::Defaults::projectLength;
 
-    float componentHeight = 1.f;
-
     int keyboardSize = Globals::twelveToneKeyboardSize;
 
     HybridRoll &roll;
@@ -87,10 +95,6 @@ private:
     Clip activeClip;
     Colour baseColour;
 
-    using SequenceSet = FlatHashSet<Note, MidiEventHash>;
-    using PatternMap = FlatHashMap<Clip, UniquePointer<SequenceSet>, ClipHash>;
-    PatternMap patternMap;
-
     void handleAsyncUpdate() override;
 
     JUCE_LEAK_DETECTOR(PianoProjectMap)
@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "ProjectMapScroller.h"
+#include "UiProfiler.h"
 #include "ProjectMapScrollerScreen.h"
 #include "Playhead.h"
 #include "Transport.h"
@@ -180,6 +181,8 @@ void ProjectMapScroller::resized()
 
 void ProjectMapScroller::paint(Graphics &g)
 {
+    UI_PROFILE_PAINT("ProjectMapScroller::paint", g);
+
     const auto &theme = HelioTheme::getCurrentTheme();
     g.setFillType({ theme.getBgCacheC(), {} });
     g.fillRect(this->getLocalBounds());
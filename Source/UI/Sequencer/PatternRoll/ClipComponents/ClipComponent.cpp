@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "ClipComponent.h"
+#include "UiProfiler.h"
 #include "MidiEvent.h"
 #include "PatternRoll.h"
 #include "Pattern.h"
@@ -261,6 +262,8 @@ void ClipComponent::mouseUp(const MouseEvent &e)
 
 void ClipComponent::paint(Graphics &g)
 {
+    UI_PROFILE_PAINT("ClipComponent::paint", g);
+
     const float w = float(this->getWidth());
     const float h = float(this->getHeight());
     const float v = this->clip.getVelocity();
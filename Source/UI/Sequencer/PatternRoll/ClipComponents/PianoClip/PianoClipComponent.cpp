@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "PianoClipComponent.h"
+#include "UiProfiler.h"
 #include "ProjectNode.h"
 #include "ProjectMetadata.h"
 #include "MidiSequence.h"
@@ -28,13 +29,15 @@
 #include "PatternRoll.h"
 
 PianoClipComponent::PianoClipComponent(ProjectNode &project, MidiSequence *sequence,
-    HybridRoll &roll, const Clip &clip) :
+    HybridRoll &roll, const Clip &clip, PianoSequenceThumbnail::Ptr thumbnail) :
     ClipComponent(roll, clip),
     project(project),
-    sequence(sequence)
+    sequence(sequence),
+    thumbnail(thumbnail)
 {
+    jassert(this->thumbnail != nullptr);
+    this->keyboardSize = this->project.getProjectInfo()->getKeyboardSize();
     this->setPaintingIsUnclipped(true);
-    this->reloadTrackMap();
     this->project.addListener(this);
 }
 
@@ -49,20 +52,20 @@ PianoClipComponent::~PianoClipComponent()
 
 void PianoClipComponent::paint(Graphics &g)
 {
+    UI_PROFILE_PAINT("PianoClipComponent::paint", g);
+
     // Draw the frame, set the colour, etc:
     ClipComponent::paint(g);
 
-    for (const auto &note : this->displayedNotes)
+    const float w = static_cast<float>(this->getWidth());
+    const float h = static_cast<float>(this->getHeight());
+    const float rowHeight = h / static_cast<float>(this->keyboardSize);
+
+    for (const auto &line : this->thumbnail->getNoteLines())
     {
-        const auto *ns = note.getSequence();
-        const float sequenceLength = ns->getLengthInBeats();
-        const float beat = note.getBeat() - ns->getFirstBeat();
-        const auto key = jlimit(0, this->keyboardSize, note.getKey() + this->clip.getKey());
-        const float x = static_cast<float>(this->getWidth()) * (beat / sequenceLength);
-        const float w = static_cast<float>(this->getWidth()) * (note.getLength() / sequenceLength);
-        const float h = static_cast<float>(this->getHeight());
-        const int y = static_cast<int>(h - key * h / static_cast<float>(this->keyboardSize));
-        g.fillRect(x, static_cast<float>(y), jmax(0.25f, w), 1.f);
+        const auto key = jlimit(0, this->keyboardSize, line.key + this->clip.getKey());
+        const int y = static_cast<int>(h - key * rowHeight);
+        g.fillRect(w * line.start, static_cast<float>(y), jmax(0.25f, w * line.length), 1.f);
     }
 }
 
@@ -74,17 +77,8 @@ void PianoClipComponent::onChangeMidiEvent(const MidiEvent &oldEvent, const Midi
 {
     if (oldEvent.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(oldEvent);
-        const Note &newNote = static_cast<const Note &>(newEvent);
-        if (newNote.getSequence() != this->sequence) { return; }
-
-        if (this->displayedNotes.contains(note))
-        {
-            this->displayedNotes.erase(note);
-            this->displayedNotes.insert(newNote);
-        }
-
-        this->roll.triggerBatchRepaintFor(this);
+        if (newEvent.getSequence() != this->sequence) { return; }
+        this->updateThumbnail();
     }
 }
 
@@ -92,11 +86,8 @@ void PianoClipComponent::onAddMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(event);
-        if (note.getSequence() != this->sequence) { return; }
-
-        this->displayedNotes.insert(note);
-        this->roll.triggerBatchRepaintFor(this);
+        if (event.getSequence() != this->sequence) { return; }
+        this->updateThumbnail();
     }
 }
 
@@ -104,15 +95,8 @@ void PianoClipComponent::onRemoveMidiEvent(const MidiEvent &event)
 {
     if (event.isTypeOf(MidiEvent::Type::Note))
     {
-        const Note &note = static_cast<const Note &>(event);
-        if (note.getSequence() != this->sequence) { return; }
-
-        if (this->displayedNotes.contains(note))
-        {
-            this->displayedNotes.erase(note);
-        }
-
-        this->roll.triggerBatchRepaintFor(this);
+        if (event.getSequence() != this->sequence) { return; }
+        this->updateThumbnail();
     }
 }
 
@@ -134,9 +118,11 @@ void PianoClipComponent::onChangeTrackProperties(MidiTrack *const track)
 void PianoClipComponent::onReloadProjectContent(const Array<MidiTrack *> &tracks,
     const ProjectMetadata *meta)
 {
+    this->keyboardSize = meta->getKeyboardSize();
+
     if (this->sequence != nullptr)
     {
-        this->reloadTrackMap();
+        this->updateThumbnail();
     }
 }
 
@@ -154,49 +140,26 @@ void PianoClipComponent::onAddTrack(MidiTrack *const track)
     if (track->getSequence() == this->sequence &&
         track->getSequence()->size() > 0)
     {
-        this->reloadTrackMap();
-        this->roll.triggerBatchRepaintFor(this);
+        this->updateThumbnail();
     }
 }
 
 void PianoClipComponent::onRemoveTrack(MidiTrack *const track)
 {
     if (track->getSequence() != this->sequence) { return; }
-
-    for (int i = 0; i < track->getSequence()->size(); ++i)
-    {
-        const Note &note = static_cast<const Note &>(*track->getSequence()->getUnchecked(i));
-        if (this->displayedNotes.contains(note))
-        {
-            this->displayedNotes.erase(note);
-        }
-    }
+    this->thumbnail->invalidate();
 }
 
 //===----------------------------------------------------------------------===//
 // Private
 //===----------------------------------------------------------------------===//
 
-void PianoClipComponent::reloadTrackMap()
+void PianoClipComponent::updateThumbnail()
 {
-    this->keyboardSize = this->project.getProjectInfo()->getKeyboardSize();
-
-    this->displayedNotes.clear();
-
-    for (auto *track : this->project.getTracks())
-    {
-        if (track->getSequence() != this->sequence) { continue; }
-
-        for (int j = 0; j < track->getSequence()->size(); ++j)
-        {
-            auto *event = track->getSequence()->getUnchecked(j);
-            if (event != nullptr && event->isTypeOf(MidiEvent::Type::Note))
-            {
-                auto *note = static_cast<Note *>(event);
-                this->displayedNotes.insert(*note);
-            }
-        }
-    }
+    // all clips of the sequence receive the same callbacks,
+    // but the thumbnail will only be rebuilt once, on the next paint:
+    this->thumbnail->invalidate();
+    this->roll.triggerBatchRepaintFor(this);
 }
 
 void PianoClipComponent::setShowRecordingMode(bool isRecording)
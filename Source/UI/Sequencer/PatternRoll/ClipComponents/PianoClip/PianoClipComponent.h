@@ -17,9 +17,9 @@
 
 #pragma once
 
-#include "Note.h"
 #include "ClipComponent.h"
 #include "ProjectListener.h"
+#include "PianoSequenceThumbnail.h"
 
 class HybridRoll;
 class MidiSequence;
@@ -30,7 +30,7 @@ class PianoClipComponent final : public ClipComponent, public ProjectListener
 public:
 
     PianoClipComponent(ProjectNode &project, MidiSequence *sequence,
-        HybridRoll &roll, const Clip &clip);
+        HybridRoll &roll, const Clip &clip, PianoSequenceThumbnail::Ptr thumbnail);
 
     ~PianoClipComponent() override;
 
@@ -66,11 +66,13 @@ public:
 
 private:
 
-    void reloadTrackMap();
+    void updateThumbnail();
 
     ProjectNode &project;
     WeakReference<MidiSequence> sequence;
-    FlatHashSet<Note, MidiEventHash> displayedNotes;
+
+    // shared between all clips of the sequence:
+    PianoSequenceThumbnail::Ptr thumbnail;
 
     int keyboardSize = Globals::twelveToneKeyboardSize;
 
@@ -0,0 +1,66 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "PianoSequenceThumbnail.h"
+#include "MidiSequence.h"
+#include "Note.h"
+
+PianoSequenceThumbnail::PianoSequenceThumbnail(WeakReference<MidiSequence> sequence) :
+    sequence(sequence) {}
+
+const Array<PianoSequenceThumbnail::NoteLine> &PianoSequenceThumbnail::getNoteLines()
+{
+    if (this->isValid)
+    {
+        return this->noteLines;
+    }
+
+    this->noteLines.clearQuick();
+    this->isValid = true;
+
+    if (this->sequence == nullptr || this->sequence->size() == 0)
+    {
+        return this->noteLines;
+    }
+
+    const float firstBeat = this->sequence->getFirstBeat();
+    const float sequenceLength = this->sequence->getLengthInBeats();
+    if (sequenceLength <= 0.f)
+    {
+        return this->noteLines;
+    }
+
+    this->noteLines.ensureStorageAllocated(this->sequence->size());
+
+    for (const auto *event : *this->sequence)
+    {
+        if (event->isTypeOf(MidiEvent::Type::Note))
+        {
+            const auto *note = static_cast<const Note *>(event);
+            this->noteLines.add({ (note->getBeat() - firstBeat) / sequenceLength,
+                note->getLength() / sequenceLength, note->getKey() });
+        }
+    }
+
+    return this->noteLines;
+}
+
+void PianoSequenceThumbnail::invalidate() noexcept
+{
+    this->isValid = false;
+}
@@ -0,0 +1,56 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+class MidiSequence;
+
+// Keeps the notes of a sequence packed for painting the clip thumbnails,
+// shared between all clips of a pattern, so that a track with many clip
+// instances doesn't keep a copy of its notes in each clip component;
+// the positions are relative to the sequence range, so that the same data
+// can be painted at any zoom level, and rebuilt lazily after any change
+
+class PianoSequenceThumbnail final : public ReferenceCountedObject
+{
+public:
+
+    explicit PianoSequenceThumbnail(WeakReference<MidiSequence> sequence);
+
+    struct NoteLine final
+    {
+        float start;
+        float length;
+        int key;
+    };
+
+    // relative to the sequence range, i.e. from 0 to 1
+    const Array<NoteLine> &getNoteLines();
+
+    void invalidate() noexcept;
+
+    using Ptr = ReferenceCountedObjectPtr<PianoSequenceThumbnail>;
+
+private:
+
+    WeakReference<MidiSequence> sequence;
+
+    Array<NoteLine> noteLines;
+    bool isValid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PianoSequenceThumbnail)
+};
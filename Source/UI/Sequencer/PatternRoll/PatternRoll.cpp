@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "PatternRoll.h"
+#include "UiProfiler.h"
 #include "MainLayout.h"
 #include "Workspace.h"
 #include "AudioCore.h"
@@ -128,25 +129,30 @@ void PatternRoll::selectAll()
     }
 }
 
-static ClipComponent *createClipComponentFor(MidiTrack *track,
-    const Clip &clip, ProjectNode &project, HybridRoll &roll)
+ClipComponent *PatternRoll::createClipComponentFor(MidiTrack *track, const Clip &clip)
 {
     auto *sequence = track->getSequence();
     jassert(sequence != nullptr);
 
     if (auto *pianoLayer = dynamic_cast<PianoSequence *>(sequence))
     {
-        return new PianoClipComponent(project, sequence, roll, clip);
+        auto &thumbnail = this->pianoThumbnails[sequence];
+        if (thumbnail == nullptr)
+        {
+            thumbnail = new PianoSequenceThumbnail(sequence);
+        }
+
+        return new PianoClipComponent(this->project, sequence, *this, clip, thumbnail);
     }
     else if (auto *autoLayer = dynamic_cast<AutomationSequence *>(sequence))
     {
         if (track->isOnOffAutomationTrack())
         {
-            return new AutomationStepsClipComponent(project, sequence, roll, clip);
+            return new AutomationStepsClipComponent(this->project, sequence, *this, clip);
         }
         else
         {
-            return new AutomationCurveClipComponent(project, sequence, roll, clip);
+            return new AutomationCurveClipComponent(this->project, sequence, *this, clip);
         }
     }
 
@@ -156,7 +162,9 @@ static ClipComponent *createClipComponentFor(MidiTrack *track,
 void PatternRoll::reloadRollContent()
 {
     this->selection.deselectAll();
+    this->culling->reset();
     this->clipComponents.clear();
+    this->pianoThumbnails.clear();
     this->tracks.clearQuick();
     this->rows.clearQuick();
 
@@ -173,15 +181,17 @@ void PatternRoll::reloadRollContent()
             for (int j = 0; j < pattern->size(); ++j)
             {
                 const Clip &clip = *pattern->getUnchecked(j);
-                if (auto *clipComponent = createClipComponentFor(track, clip, this->project, *this))
+                if (auto *clipComponent = this->createClipComponentFor(track, clip))
                 {
                     this->clipComponents[clip] = UniquePointer<ClipComponent>(clipComponent);
-                    this->addAndMakeVisible(clipComponent);
+                    // will be shown by the culling helper, if visible:
+                    this->addChildComponent(clipComponent);
                 }
             }
         }
     }
 
+    this->culling->updateBounds(this->viewport.getViewArea());
     this->repaint(this->viewport.getViewArea());
 
     HYBRID_ROLL_BULK_REPAINT_END
@@ -350,6 +360,65 @@ float PatternRoll::getBeatByMousePosition(const Pattern *pattern, int x) const
     return this->getFloorBeatSnapByXPosition(x) - sequenceOffset;
 }
 
+void PatternRoll::findEventComponentsInArea(const Rectangle<int> &area,
+    Array<FloatBoundsComponent *> &result) const
+{
+    const float areaStartBeat = float(area.getX()) / this->beatWidth + this->firstBeat;
+    const float areaEndBeat = float(area.getRight()) / this->beatWidth + this->firstBeat;
+
+    for (const auto *track : this->tracks)
+    {
+        const auto trackGroupKey = getTrackGroupKey(this->groupMode, track);
+        const int trackIndex = this->rows.indexOfSorted(kStringSort, trackGroupKey);
+        const int y = Globals::UI::rollHeaderHeight + trackIndex * rowHeight();
+        if (y + rowHeight() < area.getY() || y > area.getBottom())
+        {
+            continue;
+        }
+
+        // all clips of a track have the same length and offset, as they share the sequence,
+        // and the pattern is sorted by beat, so the clips in range are easy to find:
+        const auto *pattern = track->getPattern();
+        const auto *sequence = track->getSequence();
+        const float sequenceOffset = sequence->size() > 0 ? sequence->getFirstBeat() : 0.f;
+        const float sequenceLength = (sequence->size() == 0) ? Globals::Defaults::emptyClipLength :
+            jmax(sequence->getLengthInBeats(), Globals::minClipLength);
+
+        const float startBeat = areaStartBeat - sequenceOffset - sequenceLength;
+        const float endBeat = areaEndBeat - sequenceOffset;
+
+        int first = 0;
+        int last = pattern->size();
+        while (first < last)
+        {
+            const int middle = (first + last) / 2;
+            if (pattern->getUnchecked(middle)->getBeat() < startBeat)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+
+        for (int i = first; i < pattern->size(); ++i)
+        {
+            const auto *clip = pattern->getUnchecked(i);
+            if (clip->getBeat() > endBeat)
+            {
+                break;
+            }
+
+            const auto found = this->clipComponents.find(*clip);
+            if (found != this->clipComponents.end())
+            {
+                result.add(found->second.get());
+            }
+        }
+    }
+}
+
 //===----------------------------------------------------------------------===//
 // ProjectListener
 //===----------------------------------------------------------------------===//
@@ -364,10 +433,10 @@ void PatternRoll::onAddTrack(MidiTrack *const track)
         for (int j = 0; j < pattern->size(); ++j)
         {
             const Clip &clip = *pattern->getUnchecked(j);
-            if (auto *clipComponent = createClipComponentFor(track, clip, this->project, *this))
+            if (auto *clipComponent = this->createClipComponentFor(track, clip))
             {
                 this->clipComponents[clip] = UniquePointer<ClipComponent>(clipComponent);
-                this->addAndMakeVisible(clipComponent);
+                this->addChildComponent(clipComponent);
 
                 if (this->isEnabled())
                 {
@@ -436,6 +505,8 @@ void PatternRoll::onRemoveTrack(MidiTrack *const track)
         }
     }
 
+    this->pianoThumbnails.erase(track->getSequence());
+
     this->updateRollSize();
     this->resized();
 }
@@ -443,7 +514,7 @@ void PatternRoll::onRemoveTrack(MidiTrack *const track)
 void PatternRoll::onAddClip(const Clip &clip)
 {
     auto *track = clip.getPattern()->getTrack();
-    if (auto *clipComponent = createClipComponentFor(track, clip, this->project, *this))
+    if (auto *clipComponent = this->createClipComponentFor(track, clip))
     {
         this->clipComponents[clip] = UniquePointer<ClipComponent>(clipComponent);
         this->addAndMakeVisible(clipComponent);
@@ -521,16 +592,19 @@ void PatternRoll::selectEventsInRange(float startBeat, float endBeat, bool shoul
 
 void PatternRoll::findLassoItemsInArea(Array<SelectableComponent *> &itemsFound, const Rectangle<int> &rectangle)
 {
-    for (const auto &e : this->clipComponents)
-    {
-        const auto component = e.second.get();
-        component->setSelected(this->selection.isSelected(component));
-    }
+    // no need to reset the selection flags here, the lasso selection
+    // will only (de)select the components whose state actually changes:
+    Array<FloatBoundsComponent *> candidates;
+    this->findEventComponentsInArea(rectangle, candidates);
 
-    for (const auto &e : this->clipComponents)
+    for (auto *candidate : candidates)
     {
-        const auto component = e.second.get();
-        if (rectangle.intersects(component->getBounds()) && component->isActive())
+        auto *component = static_cast<ClipComponent *>(candidate);
+        // hidden components have no valid bounds:
+        const auto bounds = component->isLaidOut() ? component->getBounds() :
+            this->getEventBounds(component).getSmallestIntegerContainer();
+
+        if (rectangle.intersects(bounds) && component->isActive())
         {
             jassert(!itemsFound.contains(component));
             itemsFound.add(component);
@@ -809,11 +883,7 @@ void PatternRoll::resized()
 
     HYBRID_ROLL_BULK_REPAINT_START
 
-    for (const auto &e : this->clipComponents)
-    {
-        const auto c = e.second.get();
-        c->setFloatBounds(this->getEventBounds(c));
-    }
+    this->culling->updateBounds(this->viewport.getViewArea());
 
     if (this->knifeToolHelper != nullptr)
     {
@@ -825,11 +895,17 @@ void PatternRoll::resized()
     HYBRID_ROLL_BULK_REPAINT_END
 }
 
-void PatternRoll::paint(Graphics &g)
+int PatternRoll::getBackgroundPeriodHeight() const noexcept
 {
-    g.setTiledImageFill(this->rowPattern, 0, Globals::UI::rollHeaderHeight, 1.f);
-    g.fillRect(this->viewport.getViewArea());
-    HybridRoll::paint(g);
+    return this->rowPattern.getHeight();
+}
+
+void PatternRoll::paintBackgroundRows(Graphics &g, int startX, int endX) const
+{
+    UI_PROFILE_PAINT("PatternRoll::paintBackgroundRows", g);
+
+    g.setTiledImageFill(this->rowPattern, 0, 0, 1.f);
+    g.fillRect(startX, 0, endX - startX, this->rowPattern.getHeight());
 }
 
 void PatternRoll::parentSizeChanged()
@@ -933,12 +1009,16 @@ void PatternRoll::insertNewClipAt(const MouseEvent &e)
 
 void PatternRoll::startCuttingClips(const MouseEvent &e)
 {
+    Array<FloatBoundsComponent *> candidates;
+    this->findEventComponentsInArea({ e.x, e.y, 1, 1 }, candidates);
+
     ClipComponent *targetClip = nullptr;
-    for (const auto &cc : this->clipComponents)
+    for (auto *candidate : candidates)
     {
-        if (cc.second.get()->getBounds().contains(e.position.toInt()))
+        if (candidate->isLaidOut() &&
+            candidate->getBounds().contains(e.position.toInt()))
         {
-            targetClip = cc.second.get();
+            targetClip = static_cast<ClipComponent *>(candidate);
             break;
         }
     }
@@ -1104,4 +1184,5 @@ void PatternRoll::repaintBackgroundsCache()
 {
     const auto &theme = HelioTheme::getCurrentTheme();
     this->rowPattern = PatternRoll::renderRowsPattern(theme, rowHeight() * 8);
+    this->invalidateBackgroundTiles();
 }
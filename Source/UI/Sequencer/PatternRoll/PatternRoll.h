@@ -28,6 +28,7 @@ class ClipComponent;
 #include "MidiTrack.h"
 #include "Pattern.h"
 #include "Clip.h"
+#include "PianoSequenceThumbnail.h"
 
 class PatternRoll final : public HybridRoll
 {
@@ -58,6 +59,9 @@ public:
     float getBeatForClipByXPosition(const Clip &clip, float x) const;
     float getBeatByMousePosition(const Pattern *pattern, int x) const;
 
+    void findEventComponentsInArea(const Rectangle<int> &area,
+        Array<FloatBoundsComponent *> &result) const override;
+
     //===------------------------------------------------------------------===//
     // ProjectListener
     //===------------------------------------------------------------------===//
@@ -104,7 +108,6 @@ public:
     void mouseDrag(const MouseEvent &e) override;
     void handleCommandMessage(int commandId) override;
     void resized() override;
-    void paint(Graphics &g) override;
     void parentSizeChanged() override;
     
     //===------------------------------------------------------------------===//
@@ -142,6 +145,9 @@ protected:
     float findNextAnchorBeat(float beat) const override;
     float findPreviousAnchorBeat(float beat) const override;
 
+    int getBackgroundPeriodHeight() const noexcept override;
+    void paintBackgroundRows(Graphics &g, int startX, int endX) const override;
+
 public:
 
     Image rowPattern;
@@ -178,5 +184,10 @@ private:
     using ClipComponentsMap = FlatHashMap<Clip, UniquePointer<ClipComponent>, ClipHash>;
     ClipComponentsMap clipComponents;
 
+    ClipComponent *createClipComponentFor(MidiTrack *track, const Clip &clip);
+
+    // all clips of a piano sequence paint the same notes thumbnail:
+    FlatHashMap<const MidiSequence *, PianoSequenceThumbnail::Ptr> pianoThumbnails;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PatternRoll)
 };
@@ -0,0 +1,288 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Common.h"
+#include "InactiveNotesLayer.h"
+#include "UiProfiler.h"
+#include "PianoRoll.h"
+#include "PianoSequence.h"
+#include "MidiTrack.h"
+#include "Pattern.h"
+#include "Note.h"
+#include "HelioTheme.h"
+#include "ColourIDs.h"
+
+InactiveNotesLayer::InactiveNotesLayer(PianoRoll &roll) : roll(roll)
+{
+    this->setOpaque(false);
+    this->setWantsKeyboardFocus(false);
+    // all mouse events go to the roll, which asks this layer for hit testing:
+    this->setInterceptsMouseClicks(false, false);
+}
+
+void InactiveNotesLayer::addTrack(MidiTrack *track)
+{
+    const auto *sequence = track->getSequence();
+    if (dynamic_cast<const PianoSequence *>(sequence) == nullptr ||
+        track->getPattern() == nullptr || this->tracks.contains(track))
+    {
+        return;
+    }
+
+    float maxNoteLength = 0.f;
+    for (const auto *event : *sequence)
+    {
+        maxNoteLength = jmax(maxNoteLength, static_cast<const Note *>(event)->getLength());
+    }
+
+    this->tracks.add(track);
+    this->maxNoteLengths.add(maxNoteLength);
+    this->repaint();
+}
+
+void InactiveNotesLayer::removeTrack(const MidiTrack *track)
+{
+    const auto index = this->tracks.indexOf(const_cast<MidiTrack *>(track));
+    if (index >= 0)
+    {
+        this->tracks.remove(index);
+        this->maxNoteLengths.remove(index);
+        this->repaint();
+    }
+}
+
+void InactiveNotesLayer::removeAllTracks()
+{
+    this->tracks.clearQuick();
+    this->maxNoteLengths.clearQuick();
+    this->repaint();
+}
+
+void InactiveNotesLayer::repaintNote(const MidiTrack *track, int key, float beat, float length)
+{
+    const auto index = this->tracks.indexOf(const_cast<MidiTrack *>(track));
+    if (index < 0)
+    {
+        return;
+    }
+
+    // this is called for all added and changed notes
+    auto &maxNoteLength = this->maxNoteLengths.getReference(index);
+    maxNoteLength = jmax(maxNoteLength, length);
+
+    const auto *pattern = track->getPattern();
+    for (int i = 0; i < pattern->size(); ++i)
+    {
+        const auto *clip = pattern->getUnchecked(i);
+        if (!this->isActiveClip(track, *clip))
+        {
+            const auto bounds = this->roll.getEventBounds(key + clip->getKey(),
+                beat + clip->getBeat(), length);
+
+            this->repaint(bounds.getSmallestIntegerContainer());
+        }
+    }
+}
+
+bool InactiveNotesLayer::findClipAt(const Point<float> &position,
+    MidiTrack *&outTrack, const Clip *&outClip) const
+{
+    const float beatWidth = this->roll.getBeatWidth();
+    const float targetBeat = position.getX() / beatWidth + this->roll.getFirstBeat();
+
+    bool found = false;
+    for (int t = 0; t < this->tracks.size(); ++t)
+    {
+        auto *track = this->tracks.getUnchecked(t);
+        const auto *sequence = track->getSequence();
+        const auto *pattern = track->getPattern();
+        for (int i = 0; i < pattern->size(); ++i)
+        {
+            const auto *clip = pattern->getUnchecked(i);
+            if (this->isActiveClip(track, *clip))
+            {
+                continue;
+            }
+
+            const int firstIndex = this->findFirstNoteIndex(t, targetBeat - clip->getBeat());
+            for (int j = firstIndex; j < sequence->size(); ++j)
+            {
+                const auto *event = sequence->getUnchecked(j);
+                const float beat = event->getBeat() + clip->getBeat();
+                if (beat > targetBeat)
+                {
+                    break; // the sequence is sorted by beat
+                }
+
+                const auto *note = static_cast<const Note *>(event);
+                const auto bounds = this->roll.getEventBounds(note->getKey() + clip->getKey(),
+                    beat, note->getLength());
+
+                if (bounds.contains(position))
+                {
+                    // keep searching, so that the topmost note wins
+                    outTrack = track;
+                    outClip = clip;
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+//===----------------------------------------------------------------------===//
+// Component
+//===----------------------------------------------------------------------===//
+
+// Mimics the way inactive NoteComponents are painted,
+// except for the volume bars, which are transparent for them anyway:
+void InactiveNotesLayer::paint(Graphics &g)
+{
+    UI_PROFILE_PAINT("InactiveNotesLayer::paint", g);
+
+    const auto area = g.getClipBounds().toFloat();
+    const float beatWidth = this->roll.getBeatWidth();
+    const float areaStartBeat = area.getX() / beatWidth + this->roll.getFirstBeat();
+    const float areaEndBeat = area.getRight() / beatWidth + this->roll.getFirstBeat();
+
+    const auto base = findDefaultColour(ColourIDs::Roll::noteFill);
+    const bool isDarkTheme = HelioTheme::getCurrentTheme().isDark();
+
+    for (int t = 0; t < this->tracks.size(); ++t)
+    {
+        const auto *track = this->tracks.getUnchecked(t);
+        const auto *sequence = track->getSequence();
+        const auto *pattern = track->getPattern();
+        if (sequence->size() == 0)
+        {
+            continue;
+        }
+
+        auto colour = track->getTrackColour()
+            .interpolatedWith(base, 0.15f)
+            .withMultipliedSaturationHSL(1.5f)
+            .withAlpha(0.25f);
+
+        colour = isDarkTheme ? colour.brighter(0.55f) : colour.darker(0.45f);
+        const auto colourLighter = colour.brighter(0.125f).withMultipliedAlpha(1.45f);
+        const auto colourDarker = colour.darker(0.175f).withMultipliedAlpha(1.45f);
+
+        for (int i = 0; i < pattern->size(); ++i)
+        {
+            const auto *clip = pattern->getUnchecked(i);
+            if (this->isActiveClip(track, *clip) ||
+                sequence->getFirstBeat() + clip->getBeat() > areaEndBeat)
+            {
+                continue;
+            }
+
+            const int firstIndex = this->findFirstNoteIndex(t, areaStartBeat - clip->getBeat());
+            for (int j = firstIndex; j < sequence->size(); ++j)
+            {
+                const auto *event = sequence->getUnchecked(j);
+                const float beat = event->getBeat() + clip->getBeat();
+                if (beat > areaEndBeat)
+                {
+                    break;
+                }
+
+                const auto *note = static_cast<const Note *>(event);
+                if (beat + note->getLength() < areaStartBeat)
+                {
+                    continue;
+                }
+
+                const auto bounds = this->roll.getEventBounds(note->getKey() + clip->getKey(),
+                    beat, note->getLength());
+
+                if (!bounds.intersects(area))
+                {
+                    continue;
+                }
+
+                const float w = bounds.getWidth() - .5f;
+                const float h = bounds.getHeight();
+                const float x = bounds.getX();
+                const float y = bounds.getY();
+
+                g.setColour(colour);
+                g.fillRect(x + 0.5f, y + h / 6.f, 0.5f, h / 1.5f);
+
+                if (w >= 1.25f)
+                {
+                    g.fillRect(x + w - 0.75f, y + h / 6.f, 0.5f, h / 1.5f);
+                    g.fillRect(x + 0.75f, y + 1.f, w - 1.25f, h - 2.f);
+                }
+
+                if (w >= 2.25f)
+                {
+                    g.setColour(colourLighter);
+                    g.fillRect(x + 1.25f, roundf(y), w - 2.25f, 1.f);
+
+                    g.setColour(colourDarker);
+                    g.fillRect(x + 1.25f, roundf(y + h - 1), w - 2.25f, 1.f);
+                }
+
+                const auto tuplet = note->getTuplet();
+                if (tuplet > 1 && w > 25.f)
+                {
+                    g.setColour(colourLighter);
+                    for (int k = 1; k < tuplet; ++k)
+                    {
+                        g.fillRect(x + k * (w / tuplet) - 1.f, y, 1.f, h);
+                    }
+                }
+            }
+        }
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// Helpers
+//===----------------------------------------------------------------------===//
+
+int InactiveNotesLayer::findFirstNoteIndex(int trackIndex, float beat) const
+{
+    const auto *sequence = this->tracks.getUnchecked(trackIndex)->getSequence();
+    const float startBeat = beat - this->maxNoteLengths.getUnchecked(trackIndex);
+
+    // the sequence is sorted by beat, and no note before this one can reach the beat:
+    int first = 0;
+    int last = sequence->size();
+    while (first < last)
+    {
+        const int middle = (first + last) / 2;
+        if (sequence->getUnchecked(middle)->getBeat() < startBeat)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return first;
+}
+
+bool InactiveNotesLayer::isActiveClip(const MidiTrack *track, const Clip &clip) const noexcept
+{
+    return this->roll.getActiveTrack().get() == track && this->roll.getActiveClip() == clip;
+}
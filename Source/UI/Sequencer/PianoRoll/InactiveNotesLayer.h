@@ -0,0 +1,69 @@
+/*
+    This file is part of Helio Workstation.
+
+    Helio is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Helio is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Helio. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+class PianoRoll;
+class MidiTrack;
+
+#include "Clip.h"
+
+// Paints all notes that are not in the active clip in a single pass,
+// straight from the sequence data, instead of keeping a component per note;
+// only the area being repainted is walked through, so scrolling and zooming
+// dense projects doesn't depend on the total number of notes:
+class InactiveNotesLayer final : public Component
+{
+public:
+
+    explicit InactiveNotesLayer(PianoRoll &roll);
+
+    void addTrack(MidiTrack *track);
+    void removeTrack(const MidiTrack *track);
+    void removeAllTracks();
+
+    // repaints the note in all clips, except the active one
+    void repaintNote(const MidiTrack *track, int key, float beat, float length);
+
+    // finds the inactive clip under the given point, if any
+    bool findClipAt(const Point<float> &position,
+        MidiTrack *&outTrack, const Clip *&outClip) const;
+
+    //===------------------------------------------------------------------===//
+    // Component
+    //===------------------------------------------------------------------===//
+
+    void paint(Graphics &g) override;
+
+private:
+
+    PianoRoll &roll;
+
+    Array<MidiTrack *> tracks;
+
+    // the longest note of each track, in the same order as the tracks, which
+    // tells how far back from the visible area the notes might still overlap it;
+    // like PianoRoll's maxActiveNoteLength, it only grows until the roll is reloaded
+    Array<float> maxNoteLengths;
+
+    // returns the index of the first note which might be visible after the given beat
+    int findFirstNoteIndex(int trackIndex, float beat) const;
+
+    bool isActiveClip(const MidiTrack *track, const Clip &clip) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InactiveNotesLayer)
+};
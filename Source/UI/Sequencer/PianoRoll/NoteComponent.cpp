@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "NoteComponent.h"
+#include "UiProfiler.h"
 #include "PianoSequence.h"
 #include "PianoRoll.h"
 #include "ProjectNode.h"
@@ -613,6 +614,8 @@ void NoteComponent::mouseDoubleClick(const MouseEvent &e) {}
 // or fillRect - these are the ones with minimal overhead:
 void NoteComponent::paint(Graphics &g) noexcept
 {
+    UI_PROFILE_PAINT("NoteComponent::paint", g);
+
     const float w = this->floatLocalBounds.getWidth() - .5f; // a small gap between notes
     const float h = this->floatLocalBounds.getHeight();
     const float x = this->floatLocalBounds.getX();
@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "PianoRoll.h"
+#include "UiProfiler.h"
 #include "AudioCore.h"
 #include "PluginWindow.h"
 #include "Pattern.h"
@@ -29,6 +30,7 @@
 #include "ProjectMetadata.h"
 #include "Note.h"
 #include "NoteComponent.h"
+#include "InactiveNotesLayer.h"
 #include "NoteNameGuidesBar.h"
 #include "HelperRectangle.h"
 #include "HybridRollHeader.h"
@@ -77,6 +79,10 @@ PianoRoll::PianoRoll(ProjectNode &project, Viewport &viewport, WeakReference<Aud
 {
     this->setComponentID(ComponentIDs::pianoRollId);
 
+    this->inactiveNotesLayer = make<InactiveNotesLayer>(*this);
+    this->addAndMakeVisible(this->inactiveNotesLayer.get());
+    this->inactiveNotesLayer->toBack();
+
     this->selectedNotesMenuManager = make<PianoRollSelectionMenuManager>(&this->selection, this->project);
 
     this->draggingHelper = make<HelperRectangleHorizontal>();
@@ -99,48 +105,66 @@ void PianoRoll::reloadRollContent()
 {
     this->selection.deselectAll();
     this->patternMap.clear();
+    this->inactiveNotesLayer->removeAllTracks();
 
     HYBRID_ROLL_BULK_REPAINT_START
 
-    for (const auto *track : this->project.getTracks())
+    for (auto *track : this->project.getTracks())
     {
-        this->loadTrack(track);
+        this->inactiveNotesLayer->addTrack(track);
     }
 
+    this->loadActiveClip();
+
     this->updateBackgroundCachesAndRepaint();
 
     HYBRID_ROLL_BULK_REPAINT_END
 }
 
-void PianoRoll::loadTrack(const MidiTrack *const track)
+void PianoRoll::loadActiveClip()
 {
-    if (track->getPattern() == nullptr)
+    this->culling->reset();
+    this->patternMap.clear();
+    this->maxActiveNoteLength = 0.f;
+
+    const auto *track = this->activeTrack.get();
+    if (track == nullptr || track->getPattern() == nullptr ||
+        track->getPattern()->size() == 0 ||
+        dynamic_cast<const PianoSequence *>(track->getSequence()) == nullptr)
     {
         return;
     }
 
-    for (int i = 0; i < track->getPattern()->size(); ++i)
+    const int clipIndex = track->getPattern()->indexOfSorted(&this->activeClip);
+    if (clipIndex < 0)
     {
-        const Clip *clip = track->getPattern()->getUnchecked(i);
+        return;
+    }
 
-        auto *sequenceMap = new SequenceMap();
-        this->patternMap[*clip] = UniquePointer<SequenceMap>(sequenceMap);
+    const Clip *clip = track->getPattern()->getUnchecked(clipIndex);
 
-        for (int j = 0; j < track->getSequence()->size(); ++j)
-        {
-            const MidiEvent *event = track->getSequence()->getUnchecked(j);
-            if (event->isTypeOf(MidiEvent::Type::Note))
-            {
-                const Note *note = static_cast<const Note *>(event);
-                auto *nc = new NoteComponent(*this, *note, *clip);
-                (*sequenceMap)[*note] = UniquePointer<NoteComponent>(nc);
-                const bool isActive = nc->belongsTo(this->activeTrack, this->activeClip);
-                nc->setActive(isActive, true);
-                this->addAndMakeVisible(nc);
-                nc->setFloatBounds(this->getEventBounds(nc));
-            }
-        }
+    auto *sequenceMap = new SequenceMap();
+    this->patternMap[*clip] = UniquePointer<SequenceMap>(sequenceMap);
+    sequenceMap->reserve(track->getSequence()->size());
+
+    const auto &editMode = this->project.getEditMode();
+    const bool interactsWithChildren = editMode.shouldInteractWithChildren();
+    const auto cursor = interactsWithChildren ? MouseCursor::NormalCursor : editMode.getCursor();
+
+    for (const auto *event : *track->getSequence())
+    {
+        const Note *note = static_cast<const Note *>(event);
+        auto *nc = new NoteComponent(*this, *note, *clip);
+        (*sequenceMap)[*note] = UniquePointer<NoteComponent>(nc);
+        nc->setActive(true, true);
+        nc->setInterceptsMouseClicks(interactsWithChildren, interactsWithChildren);
+        nc->setMouseCursor(cursor);
+        // will be shown by the culling helper, if visible:
+        this->addChildComponent(nc);
+        this->maxActiveNoteLength = jmax(this->maxActiveNoteLength, note->getLength());
     }
+
+    this->culling->updateBounds(this->viewport.getViewArea());
 }
 
 void PianoRoll::updateActiveRangeIndicator() const
@@ -255,6 +279,15 @@ void PianoRoll::longTapEvent(const Point<float> &position,
             this->project.setEditableScope(track, nc->getClip(), false);
             return;
         }
+
+        MidiTrack *inactiveTrack = nullptr;
+        const Clip *inactiveClip = nullptr;
+        if (target == this &&
+            this->inactiveNotesLayer->findClipAt(position, inactiveTrack, inactiveClip))
+        {
+            this->project.setEditableScope(inactiveTrack, *inactiveClip, false);
+            return;
+        }
     }
 
     // else - start dragging lasso, if needed:
@@ -354,6 +387,59 @@ bool PianoRoll::isNoteVisible(int key, float beat, float length) const
             (beat + length > firstViewportBeat && beat + length < lastViewportBeat));
 }
 
+void PianoRoll::findEventComponentsInArea(const Rectangle<int> &area,
+    Array<FloatBoundsComponent *> &result) const
+{
+    for (const auto &c : this->patternMap)
+    {
+        const auto &clip = c.first;
+        const auto &sequenceMap = *c.second.get();
+        const auto *sequence = clip.getPattern()->getTrack()->getSequence();
+
+        const float startBeat = float(area.getX()) / this->beatWidth +
+            this->firstBeat - clip.getBeat() - this->maxActiveNoteLength;
+        const float endBeat = float(area.getRight()) / this->beatWidth +
+            this->firstBeat - clip.getBeat();
+
+        // the sequence is sorted by beat, find the first note to check:
+        int first = 0;
+        int last = sequence->size();
+        while (first < last)
+        {
+            const int middle = (first + last) / 2;
+            if (sequence->getUnchecked(middle)->getBeat() < startBeat)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+
+        for (int i = first; i < sequence->size(); ++i)
+        {
+            const auto *note = static_cast<const Note *>(sequence->getUnchecked(i));
+            if (note->getBeat() > endBeat)
+            {
+                break;
+            }
+
+            const int y = this->getYPositionByKey(note->getKey() + clip.getKey());
+            if (y + this->rowHeight < area.getY() || y > area.getBottom())
+            {
+                continue;
+            }
+
+            const auto found = sequenceMap.find(*note);
+            if (found != sequenceMap.end())
+            {
+                result.add(found->second.get());
+            }
+        }
+    }
+}
+
 void PianoRoll::getRowsColsByComponentPosition(float x, float y, int &noteNumber, float &beatNumber) const
 {
     beatNumber = this->getRoundBeatSnapByXPosition(int(x)) - this->activeClip.getBeat(); /* - 0.5f ? */
@@ -434,11 +520,16 @@ void PianoRoll::onChangeMidiEvent(const MidiEvent &oldEvent, const MidiEvent &ne
                 jassert(!sequenceMap.contains(newNote));
                 // Always erase before updating, as it may happen both events have the same hash code:
                 sequenceMap[newNote] = UniquePointer<NoteComponent>(component);
+                this->maxActiveNoteLength = jmax(this->maxActiveNoteLength, newNote.getLength());
                 // Schedule to be repainted later:
                 this->triggerBatchRepaintFor(component);
             }
         }
 
+        // Same note in all other clips of this track:
+        this->inactiveNotesLayer->repaintNote(track, note.getKey(), note.getBeat(), note.getLength());
+        this->inactiveNotesLayer->repaintNote(track, newNote.getKey(), newNote.getBeat(), newNote.getLength());
+
         // FIXME someday please: this is a kind of a really nasty hack,
         // and instead the guides bar should subscribe on project changes on its own,
         // and keep track of selected notes and change visible note guides positions,
@@ -456,6 +547,7 @@ void PianoRoll::onChangeMidiEvent(const MidiEvent &oldEvent, const MidiEvent &ne
             this->removeBackgroundCacheFor(oldKey);
             this->updateBackgroundCacheFor(newKey);
         }
+        this->invalidateBackgroundTiles();
         this->repaint();
     }
 
@@ -479,6 +571,7 @@ void PianoRoll::onAddMidiEvent(const MidiEvent &event)
             const Clip *realClip = track->getPattern()->getUnchecked(i);
             auto *component = new NoteComponent(*this, note, *realClip);
             sequenceMap[note] = UniquePointer<NoteComponent>(component);
+            this->maxActiveNoteLength = jmax(this->maxActiveNoteLength, note.getLength());
             this->addAndMakeVisible(component);
 
             this->fader.fadeIn(component, Globals::UI::fadeInLong);
@@ -505,12 +598,15 @@ void PianoRoll::onAddMidiEvent(const MidiEvent &event)
                 this->selectEvent(this->newNoteDragging, true); // clear prev selection
             }
         }
+
+        this->inactiveNotesLayer->repaintNote(track, note.getKey(), note.getBeat(), note.getLength());
     }
     else if (event.isTypeOf(MidiEvent::Type::KeySignature))
     {
         // Repainting background caches on the fly may be costly
         const KeySignatureEvent &key = static_cast<const KeySignatureEvent &>(event);
         this->updateBackgroundCacheFor(key);
+        this->invalidateBackgroundTiles();
         this->repaint();
     }
 
@@ -538,11 +634,14 @@ void PianoRoll::onRemoveMidiEvent(const MidiEvent &event)
                 sequenceMap.erase(note);
             }
         }
+
+        this->inactiveNotesLayer->repaintNote(track, note.getKey(), note.getBeat(), note.getLength());
     }
     else if (event.isTypeOf(MidiEvent::Type::KeySignature))
     {
         const KeySignatureEvent &key = static_cast<const KeySignatureEvent &>(event);
         this->removeBackgroundCacheFor(key);
+        this->invalidateBackgroundTiles();
         this->repaint();
     }
 
@@ -551,40 +650,8 @@ void PianoRoll::onRemoveMidiEvent(const MidiEvent &event)
 
 void PianoRoll::onAddClip(const Clip &clip)
 {
-    const SequenceMap *referenceMap = nullptr;
-    const auto *track = clip.getPattern()->getTrack();
-
-    forEachSequenceMapOfGivenTrack(this->patternMap, c, track)
-    {
-        // Found a sequence map for the same track
-        referenceMap = c.second.get();
-        break;
-    }
-
-    if (referenceMap == nullptr)
-    {
-        jassertfalse;
-        return;
-    }
-
-    auto *sequenceMap = new SequenceMap();
-    this->patternMap[clip] = UniquePointer<SequenceMap>(sequenceMap);
-
-    for (const auto &e : *referenceMap)
-    {
-        // reference the same note as neighbor components:
-        const auto &note = e.second.get()->getNote();
-        auto *component = new NoteComponent(*this, note, clip);
-        (*sequenceMap)[note] = UniquePointer<NoteComponent>(component);
-        this->addAndMakeVisible(component);
-
-        const bool isActive = component->belongsTo(this->activeTrack, this->activeClip);
-        component->setActive(isActive);
-
-        this->batchRepaintList.add(component);
-    }
-
-    this->triggerAsyncUpdate();
+    // new clips are never active, so they are only painted by the layer
+    this->inactiveNotesLayer->repaint();
 }
 
 void PianoRoll::onChangeClip(const Clip &clip, const Clip &newClip)
@@ -618,6 +685,10 @@ void PianoRoll::onChangeClip(const Clip &clip, const Clip &newClip)
         // Schedule batch repaint
         this->triggerAsyncUpdate();
     }
+    else
+    {
+        this->inactiveNotesLayer->repaint();
+    }
 }
 
 void PianoRoll::onRemoveClip(const Clip &clip)
@@ -629,6 +700,8 @@ void PianoRoll::onRemoveClip(const Clip &clip)
         this->patternMap.erase(clip);
     }
 
+    this->inactiveNotesLayer->repaint();
+
     HYBRID_ROLL_BULK_REPAINT_END
 }
 
@@ -643,7 +716,7 @@ void PianoRoll::onChangeTrackProperties(MidiTrack *const track)
         }
 
         this->updateActiveRangeIndicator(); // colour might have changed
-        this->repaint();
+        this->repaint(); // will also repaint the inactive notes layer
     }
 }
 
@@ -651,7 +724,7 @@ void PianoRoll::onAddTrack(MidiTrack *const track)
 {
     HYBRID_ROLL_BULK_REPAINT_START
 
-    this->loadTrack(track);
+    this->inactiveNotesLayer->addTrack(track);
 
     for (int j = 0; j < track->getSequence()->size(); ++j)
     {
@@ -664,6 +737,7 @@ void PianoRoll::onAddTrack(MidiTrack *const track)
     }
 
     // In case key signatures added:
+    this->invalidateBackgroundTiles();
     this->repaint(this->viewport.getViewArea());
 
     HYBRID_ROLL_BULK_REPAINT_END
@@ -695,6 +769,9 @@ void PianoRoll::onRemoveTrack(MidiTrack *const track)
         }
     }
 
+    this->inactiveNotesLayer->removeTrack(track);
+
+    this->invalidateBackgroundTiles();
     this->repaint();
 }
 
@@ -753,9 +830,18 @@ void PianoRoll::onChangeViewEditableScope(MidiTrack *const newActiveTrack,
 
     this->selection.deselectAll();
 
+    const bool scopeChanged = this->activeTrack != newActiveTrack ||
+        this->activeClip != newActiveClip;
+
     this->activeTrack = newActiveTrack;
     this->activeClip = newActiveClip;
 
+    if (scopeChanged)
+    {
+        this->loadActiveClip();
+        this->inactiveNotesLayer->repaint();
+    }
+
     int focusMinKey = INT_MAX;
     int focusMaxKey = 0;
     float focusMinBeat = FLT_MAX;
@@ -765,11 +851,9 @@ void PianoRoll::onChangeViewEditableScope(MidiTrack *const newActiveTrack,
     forEachEventComponent(this->patternMap, e)
     {
         auto *nc = e.second.get();
-        const bool isActive = nc->belongsTo(this->activeTrack, this->activeClip);
         const auto key = nc->getKey() + this->activeClip.getKey();
-        nc->setActive(isActive, true);
 
-        if (shouldFocus && isActive)
+        if (shouldFocus)
         {
             hasComponentsToFocusOn = true;
             focusMinKey = jmin(focusMinKey, key);
@@ -829,23 +913,21 @@ void PianoRoll::selectEventsInRange(float startBeat, float endBeat, bool shouldC
 
 void PianoRoll::findLassoItemsInArea(Array<SelectableComponent *> &itemsFound, const Rectangle<int> &rectangle)
 {
-    forEachEventComponent(this->patternMap, e)
-    {
-        auto *component = e.second.get();
-        component->setSelected(false);
-    }
+    // no need to reset the selection flags here, the lasso selection
+    // will only (de)select the components whose state actually changes;
+    // the beat-sorted sequence is used as an index to find the candidates:
+    Array<FloatBoundsComponent *> candidates;
+    this->findEventComponentsInArea(rectangle, candidates);
 
-    for (auto *component : this->selection)
-    {
-        component->setSelected(true);
-    }
-    
-    forEachEventComponent(this->patternMap, e)
+    for (auto *candidate : candidates)
     {
-        auto *component = e.second.get();
-        if (rectangle.intersects(component->getBounds()) && component->isActive())
+        auto *component = static_cast<NoteComponent *>(candidate);
+        // hidden components have no valid bounds:
+        const auto bounds = component->isLaidOut() ? component->getBounds() :
+            this->getEventBounds(component).getSmallestIntegerContainer();
+
+        if (rectangle.intersects(bounds) && component->isActive())
         {
-            component->setSelected(true);
             jassert(!itemsFound.contains(component));
             itemsFound.add(component);
         }
@@ -888,6 +970,23 @@ void PianoRoll::mouseDown(const MouseEvent &e)
     }
 
     HybridRoll::mouseDown(e);
+
+    // inactive notes have no components, so the quick layer switching
+    // (alt+click or right click on a note of another clip) is handled here:
+    MidiTrack *inactiveTrack = nullptr;
+    const Clip *inactiveClip = nullptr;
+    if (e.originalComponent == this &&
+        (e.mods.isAltDown() || e.mods.isRightButtonDown()) &&
+        this->project.getEditMode().shouldInteractWithChildren() &&
+        this->inactiveNotesLayer->findClipAt(e.position, inactiveTrack, inactiveClip))
+    {
+        const bool zoomToScope = e.mods.isAnyModifierKeyDown();
+        this->project.setEditableScope(inactiveTrack, *inactiveClip, zoomToScope);
+        if (zoomToScope)
+        {
+            this->zoomOutImpulse(0.5f);
+        }
+    }
 }
 
 void PianoRoll::mouseDoubleClick(const MouseEvent &e)
@@ -1235,6 +1334,8 @@ void PianoRoll::handleCommandMessage(int commandId)
 
 void PianoRoll::resized()
 {
+    this->inactiveNotesLayer->setBounds(this->getLocalBounds());
+
     if (!this->isShowing())
     {
         return;
@@ -1242,11 +1343,8 @@ void PianoRoll::resized()
 
     HYBRID_ROLL_BULK_REPAINT_START
 
-    forEachEventComponent(this->patternMap, e)
-    {
-        const auto component = e.second.get();
-        component->setFloatBounds(this->getEventBounds(component));
-    }
+    this->inactiveNotesLayer->repaint();
+    this->culling->updateBounds(this->viewport.getViewArea());
 
     for (const auto component : this->ghostNotes)
     {
@@ -1264,85 +1362,6 @@ void PianoRoll::resized()
     HYBRID_ROLL_BULK_REPAINT_END
 }
 
-void PianoRoll::paint(Graphics &g)
-{
-    jassert(this->defaultHighlighting != nullptr); // trying to paint before the content is ready
-
-    const auto *keysSequence = this->project.getTimeline()->getKeySignatures()->getSequence();
-    const int paintStartX = this->viewport.getViewPositionX();
-    const int paintEndX = paintStartX + this->viewport.getViewWidth();
-
-    static constexpr auto paintOffsetY = Globals::UI::rollHeaderHeight;
-
-    int prevBeatX = paintStartX;
-    const HighlightingScheme *prevScheme = nullptr;
-    const int y = this->viewport.getViewPositionY();
-    const int h = this->viewport.getViewHeight();
-
-    const auto periodHeight = this->rowHeight * this->getPeriodSize();
-    const auto numPeriodsToSkip = (y - paintOffsetY) / periodHeight;
-    const auto paintStartY = paintOffsetY + numPeriodsToSkip * periodHeight;
-
-    //g.setImageResamplingQuality(Graphics::lowResamplingQuality);
-
-    for (int nextKeyIdx = 0; this->scalesHighlightingEnabled && nextKeyIdx < keysSequence->size(); ++nextKeyIdx)
-    {
-        const auto *key = static_cast<KeySignatureEvent *>(keysSequence->getUnchecked(nextKeyIdx));
-        const int beatX = int((key->getBeat() - this->firstBeat)  * this->beatWidth);
-        const int index = this->binarySearchForHighlightingScheme(key);
-        jassert(index >= 0);
-
-        const auto *s = (prevScheme == nullptr) ? this->backgroundsCache.getUnchecked(index) : prevScheme;
-        const auto fillImage = s->getUnchecked(this->rowHeight);
-
-        if (beatX >= paintStartX)
-        {
-            /*
-                You might be thinking: why the do we need this ugly loop here?
-                Given a tiled texture, we can just fill it all at once with a single fillRect()?
-
-                Well yes, but actually no.
-                OpenGmotherfuckingL does suck real hard, and it can't seem to do
-                texture tiling correctly unless the stars are well aligned (they are not),
-                so there is always some weird offset, and it's getting weirder at each next tile.
-
-                For horizontal tiling, we don't care, but for vertical tiling, this means that
-                sequencer rows are messed up, so we have to say explicitly where to fill each period.
-            */
-
-            for (int i = paintStartY; i < y + h; i += periodHeight)
-            {
-                g.setFillType({ fillImage, AffineTransform::translation(0.f, float(i)) });
-                g.fillRect(prevBeatX, i, beatX - prevBeatX, periodHeight);
-            }
-        }
-
-        if (beatX >= paintEndX)
-        {
-            HybridRoll::paint(g);
-            return;
-        }
-
-        prevBeatX = beatX;
-        prevScheme = this->backgroundsCache.getUnchecked(index);
-    }
-
-    if (prevBeatX < paintEndX)
-    {
-        const auto *s = (prevScheme == nullptr) ? this->defaultHighlighting.get() : prevScheme;
-        const auto fillImage = s->getUnchecked(this->rowHeight);
-
-        // just because we cannot rely on OpenGL tiling:
-        for (int i = paintStartY; i < y + h; i += periodHeight)
-        {
-            g.setFillType({ fillImage, AffineTransform::translation(0.f, float(i)) });
-            g.fillRect(prevBeatX, i, paintEndX - prevBeatX, periodHeight);
-        }
-
-        HybridRoll::paint(g);
-    }
-}
-
 void PianoRoll::insertNewNoteAt(const MouseEvent &e)
 {
     int draggingRow = 0;
@@ -1383,36 +1402,50 @@ void PianoRoll::continueCuttingEvents(const MouseEvent &event)
         this->knifeToolHelper->setEndPosition(event.position);
         this->knifeToolHelper->updateBounds();
 
-        bool addsPoint;
+        // the notes that had cut points before, but no longer intersect the line:
+        Array<Note> staleNotes;
+        Array<float> staleBeats;
+        this->knifeToolHelper->getCutPoints(staleNotes, staleBeats);
+
+        const auto line = this->knifeToolHelper->getLine();
+        const auto lineArea = Rectangle<float>(line.getStart(), line.getEnd())
+            .getSmallestIntegerContainer().expanded(1);
+
+        Array<FloatBoundsComponent *> candidates;
+        this->findEventComponentsInArea(lineArea, candidates);
+
         Point<float> intersection;
-        forEachEventComponent(this->patternMap, e)
+        for (auto *candidate : candidates)
         {
-            addsPoint = false;
-            auto *nc = e.second.get();
-            if (nc->isActive())
+            auto *nc = static_cast<NoteComponent *>(candidate);
+            if (!nc->isActive())
             {
-                const int h2 = nc->getHeight() / 2;
-                const Line<float> noteLine(nc->getPosition().translated(0, h2).toFloat(),
-                    nc->getPosition().translated(nc->getWidth(), h2).toFloat());
+                continue;
+            }
 
-                if (this->knifeToolHelper->getLine().intersects(noteLine, intersection))
-                {
-                    const float relativeCutBeat = this->getRoundBeatSnapByXPosition(int(intersection.getX()))
-                        - this->activeClip.getBeat() - nc->getBeat();
- 
-                    if (relativeCutBeat > 0.f && relativeCutBeat < nc->getLength())
-                    {
-                        addsPoint = true;
-                        this->knifeToolHelper->addOrUpdateCutPoint(nc, relativeCutBeat);
-                    }
-                }
+            // hidden components have no valid bounds:
+            const auto bounds = nc->isLaidOut() ? nc->getBounds().toFloat() : this->getEventBounds(nc);
+            const float h2 = float(int(bounds.getHeight()) / 2);
+            const Line<float> noteLine(bounds.getX(), bounds.getY() + h2,
+                bounds.getRight(), bounds.getY() + h2);
 
-                if (!addsPoint)
+            if (line.intersects(noteLine, intersection))
+            {
+                const float relativeCutBeat = this->getRoundBeatSnapByXPosition(int(intersection.getX()))
+                    - this->activeClip.getBeat() - nc->getBeat();
+
+                if (relativeCutBeat > 0.f && relativeCutBeat < nc->getLength())
                 {
-                    this->knifeToolHelper->removeCutPointIfExists(nc->getNote());
+                    staleNotes.removeFirstMatchingValue(nc->getNote());
+                    this->knifeToolHelper->addOrUpdateCutPoint(nc, relativeCutBeat);
                 }
             }
         }
+
+        for (const auto &note : staleNotes)
+        {
+            this->knifeToolHelper->removeCutPointIfExists(note);
+        }
     }
 }
 
@@ -1638,11 +1671,57 @@ void PianoRoll::updateBackgroundCachesAndRepaint()
         }
     }
 
+    this->invalidateBackgroundTiles();
     this->repaint(this->viewport.getViewArea());
 
     HYBRID_ROLL_BULK_REPAINT_END
 }
 
+int PianoRoll::getBackgroundPeriodHeight() const noexcept
+{
+    return this->rowHeight * this->getPeriodSize();
+}
+
+void PianoRoll::paintBackgroundRows(Graphics &g, int startX, int endX) const
+{
+    UI_PROFILE_PAINT("PianoRoll::paintBackgroundRows", g);
+
+    jassert(this->defaultHighlighting != nullptr); // trying to paint before the content is ready
+
+    const auto *keysSequence = this->project.getTimeline()->getKeySignatures()->getSequence();
+    const int periodHeight = this->getBackgroundPeriodHeight();
+
+    int prevBeatX = startX;
+    const HighlightingScheme *prevScheme = nullptr;
+
+    for (int nextKeyIdx = 0; this->scalesHighlightingEnabled && nextKeyIdx < keysSequence->size(); ++nextKeyIdx)
+    {
+        const auto *key = static_cast<KeySignatureEvent *>(keysSequence->getUnchecked(nextKeyIdx));
+        const int beatX = int((key->getBeat() - this->firstBeat) * this->beatWidth);
+        const int index = this->binarySearchForHighlightingScheme(key);
+        jassert(index >= 0);
+
+        if (beatX >= startX)
+        {
+            const auto *s = (prevScheme == nullptr) ? this->backgroundsCache.getUnchecked(index) : prevScheme;
+            g.setTiledImageFill(s->getUnchecked(this->rowHeight), 0, 0, 1.f);
+            g.fillRect(prevBeatX, 0, beatX - prevBeatX, periodHeight);
+        }
+
+        if (beatX >= endX)
+        {
+            return;
+        }
+
+        prevBeatX = beatX;
+        prevScheme = this->backgroundsCache.getUnchecked(index);
+    }
+
+    const auto *s = (prevScheme == nullptr) ? this->defaultHighlighting.get() : prevScheme;
+    g.setTiledImageFill(s->getUnchecked(this->rowHeight), 0, 0, 1.f);
+    g.fillRect(prevBeatX, 0, endX - prevBeatX, periodHeight);
+}
+
 void PianoRoll::updateBackgroundCacheFor(const KeySignatureEvent &key)
 {
     int duplicateSchemeIndex = this->binarySearchForHighlightingScheme(&key);
@@ -1737,6 +1816,7 @@ void PianoRoll::showChordTool(ToolType type, Point<int> position)
 void PianoRoll::onScalesHighlightingFlagChanged(bool enabled)
 {
     this->scalesHighlightingEnabled = enabled;
+    this->invalidateBackgroundTiles();
     this->repaint();
 }
 
@@ -19,6 +19,7 @@
 
 class MidiSequence;
 class NoteComponent;
+class InactiveNotesLayer;
 class PianoRollSelectionMenuManager;
 class CommandPaletteChordConstructor;
 class HelperRectangle;
@@ -88,6 +89,9 @@ public:
     Rectangle<float> getEventBounds(int key, float beat, float length) const;
     bool isNoteVisible(int key, float beat, float length) const;
 
+    void findEventComponentsInArea(const Rectangle<int> &area,
+        Array<FloatBoundsComponent *> &result) const override;
+
     // Note that beat is returned relative to active clip's beat offset:
     void getRowsColsByComponentPosition(float x, float y, int &noteNumber, float &beatNumber) const;
     void getRowsColsByMousePosition(int x, int y, int &noteNumber, float &beatNumber) const;
@@ -154,7 +158,6 @@ public:
     void mouseDrag(const MouseEvent &e) override;
     void handleCommandMessage(int commandId) override;
     void resized() override;
-    void paint(Graphics &g) override;
     
     //===------------------------------------------------------------------===//
     // HybridRoll's legacy
@@ -187,7 +190,7 @@ private:
 private:
 
     void reloadRollContent();
-    void loadTrack(const MidiTrack *const track);
+    void loadActiveClip();
 
     void updateSize();
     void updateChildrenBounds() override;
@@ -233,6 +236,9 @@ private:
     OwnedArray<HighlightingScheme> backgroundsCache;
     UniquePointer<HighlightingScheme> defaultHighlighting;
     int binarySearchForHighlightingScheme(const KeySignatureEvent *const e) const noexcept;
+
+    int getBackgroundPeriodHeight() const noexcept override;
+    void paintBackgroundRows(Graphics &g, int startX, int endX) const override;
     friend class ThemeSettingsItem; // to be able to call renderRowsPattern
     
     bool scalesHighlightingEnabled = true;
@@ -254,10 +260,18 @@ private:
     
     UniquePointer<CommandPaletteChordConstructor> consoleChordConstructor;
 
+    // note components only exist for the active clip,
+    // all other clips are painted by the inactive notes layer:
     using SequenceMap = FlatHashMap<Note, UniquePointer<NoteComponent>, MidiEventHash>;
     using PatternMap = FlatHashMap<Clip, UniquePointer<SequenceMap>, ClipHash>;
     PatternMap patternMap;
 
+    // the upper bound for the active clip's note lengths,
+    // used to find the notes that start before the culling area:
+    float maxActiveNoteLength = 0.f;
+
+    UniquePointer<InactiveNotesLayer> inactiveNotesLayer;
+
 private:
 
 #if PLATFORM_DESKTOP
@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "HelioTheme.h"
+#include "UiProfiler.h"
 #include "SequencerSidebarLeft.h"
 #include "Config.h"
 #include "SerializationKeys.h"
@@ -46,18 +47,24 @@ static constexpr auto noiseAlpha = 0.0135f;
 
 void HelioTheme::drawNoise(Component *target, Graphics &g, float alphaMultiply /*= 1.f*/)
 {
+    UI_PROFILE_PAINT("HelioTheme::drawNoise", g);
+
     g.setTiledImageFill(getCurrentTheme().backgroundNoise, 0, 0, noiseAlpha * alphaMultiply);
     g.fillRect(0, 0, target->getWidth(), target->getHeight());
 }
 
 void HelioTheme::drawNoise(const HelioTheme &theme, Graphics &g, float alphaMultiply /*= 1.f*/)
 {
+    UI_PROFILE_PAINT("HelioTheme::drawNoise", g);
+
     g.setTiledImageFill(theme.backgroundNoise, 0, 0, noiseAlpha * alphaMultiply);
     g.fillRect(0, 0, g.getClipBounds().getWidth(), g.getClipBounds().getHeight());
 }
 
 void HelioTheme::drawNoiseWithin(Rectangle<int> bounds, Graphics &g, float alphaMultiply /*= 1.f*/)
 {
+    UI_PROFILE_PAINT("HelioTheme::drawNoiseWithin", g);
+
     g.setTiledImageFill(getCurrentTheme().backgroundNoise, 0, 0, noiseAlpha * alphaMultiply);
     g.fillRect(bounds);
 }
@@ -65,6 +72,8 @@ void HelioTheme::drawNoiseWithin(Rectangle<int> bounds, Graphics &g, float alpha
 void HelioTheme::drawDashedRectangle(Graphics &g, const Rectangle<float> &r, const Colour &colour,
     float dashLength, float spaceLength, float dashThickness, float cornerRadius)
 {
+    UI_PROFILE_PAINT("HelioTheme::drawDashedRectangle", g);
+
     g.setColour(colour);
     
     Path path;
@@ -85,6 +94,8 @@ void HelioTheme::drawDashedRectangle(Graphics &g, const Rectangle<float> &r, con
 void HelioTheme::drawFrame(Graphics &g, int width, int height,
     float lightAlphaMultiplier, float darkAlphaMultiplier)
 {
+    UI_PROFILE_PAINT("HelioTheme::drawFrame", g);
+
     g.setColour(findDefaultColour(ColourIDs::Common::borderLineDark).
         withMultipliedAlpha(darkAlphaMultiplier));
 